@@ -4,11 +4,159 @@
 #include <core/utils.h>
 #include <gbemu.h>
 
+// ---------------------------------------------
+// Slow paths (bus.c)
+// ---------------------------------------------
+
+// Full address decoding, fills the page table for plain-memory pages
+u8   mmu_read_slow(GameBoy *gb, u16 addr);
+void mmu_write_slow(GameBoy *gb, u16 addr, u8 value);
+
+// Re-resolve the instruction fetch window around cpu->pc, then fetch
+u8   mmu_fetch8_slow(CPU *cpu);
+
+// Point the fetch window at the plain-memory region containing `addr`
+void mmu_fetch_region(GameBoy *gb, u16 addr, CPU *cpu);
+
+// First time after `time` at which the value at `addr` can change other than
+// through CPU writes and scheduled events (EVENT_NEVER if it can't). A loop
+// polling it can skip ahead until then (see cpu_block.h)
+u64  mmu_poll_deadline(GameBoy *gb, u16 addr, u64 time);
+
+// EVENT_SAVE handler: flush the battery save, the next write marks it dirty again
+void mmu_save_flush(GameBoy *gb, u64 when);
+
 // ---------------------------------------------
 // Memory read/write
+// Inline fast path through the page table (gb->read_map / gb->write_map),
+// one load and one branch for plain memory
+// ---------------------------------------------
+static inline u8 mmu_read(GameBoy *gb, u16 addr) {
+    const u8 *page = gb->read_map[addr >> 8];
+    if (page != NULL)
+        return page[addr & 0xFF];
+    return mmu_read_slow(gb, addr);
+}
+
+static inline void mmu_write(GameBoy *gb, u16 addr, u8 value) {
+    u8 *page = gb->write_map[addr >> 8];
+    if (page != NULL) {
+        page[addr & 0xFF] = value;
+        return;
+    }
+    mmu_write_slow(gb, addr, value);
+}
+
+// ---------------------------------------------
+// Instruction fetch
+// Read the byte at PC and advance PC. PCs inside the cached window
+// (the ROM bank / RAM region PC was last in) read straight from the
+// host buffer; leaving the window or a bank switch re-resolves it.
+// ---------------------------------------------
+static inline u8 mmu_fetch8(CPU *cpu) {
+    u16 offset = cpu->pc - cpu->fetch_lo;
+    if (offset < cpu->fetch_len) {
+        cpu->pc++;
+        return cpu->fetch_ptr[offset];
+    }
+    return mmu_fetch8_slow(cpu);
+}
+
+// ---------------------------------------------
+// 16-bit access (little endian)
+// One direct-pointer access when both bytes sit in the same plain-memory
+// page or in HRAM (where stacks usually live). Falls back to two byte
+// accesses across page boundaries and for IO.
+// ---------------------------------------------
+
+// Host pointer to `addr` if [addr, addr + 1] is plain memory, else NULL
+static inline const u8 *mmu_read_ptr16(GameBoy *gb, u16 addr) {
+    if ((addr & 0xFF) != 0xFF) {
+        const u8 *page = gb->read_map[addr >> 8];
+        if (page != NULL)
+            return page + (addr & 0xFF);
+    }
+    if (addr >= 0xFF80 && addr < 0xFFFE)
+        return gb->hram + (addr - 0xFF80);
+    return NULL;
+}
+
+static inline u8 *mmu_write_ptr16(GameBoy *gb, u16 addr) {
+    if ((addr & 0xFF) != 0xFF) {
+        u8 *page = gb->write_map[addr >> 8];
+        if (page != NULL)
+            return page + (addr & 0xFF);
+    }
+    if (addr >= 0xFF80 && addr < 0xFFFE && !gb->blocks.code_page[0xFF])
+        return gb->hram + (addr - 0xFF80);
+    return NULL;
+}
+
+static inline u16 mmu_read16(GameBoy *gb, u16 addr) {
+    const u8 *ptr = mmu_read_ptr16(gb, addr);
+    if (ptr != NULL)
+        return MAKE_U16(ptr[1], ptr[0]);
+
+    u8 lo = mmu_read(gb, addr);
+    u8 hi = mmu_read(gb, addr + 1);
+    return MAKE_U16(hi, lo);
+}
+
+static inline void mmu_write16(GameBoy *gb, u16 addr, u16 value) {
+    u8 *ptr = mmu_write_ptr16(gb, addr);
+    if (ptr != NULL) {
+        ptr[0] = GET_LOW_BYTE(value);
+        ptr[1] = GET_HIGH_BYTE(value);
+        return;
+    }
+
+    mmu_write(gb, addr, GET_LOW_BYTE(value));
+    mmu_write(gb, addr + 1, GET_HIGH_BYTE(value));
+}
+
+// PUSH: SP -= 2, then [SP] <- value
+// The slow path keeps the hardware order (high byte first)
+static inline void mmu_push16(CPU *cpu, u16 value) {
+    cpu->sp -= 2;
+
+    u8 *ptr = mmu_write_ptr16(cpu->gb, cpu->sp);
+    if (ptr != NULL) {
+        ptr[0] = GET_LOW_BYTE(value);
+        ptr[1] = GET_HIGH_BYTE(value);
+        return;
+    }
+
+    mmu_write(cpu->gb, cpu->sp + 1, GET_HIGH_BYTE(value));
+    mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(value));
+}
+
+// POP: value <- [SP], then SP += 2
+static inline u16 mmu_pop16(CPU *cpu) {
+    u16 value = mmu_read16(cpu->gb, cpu->sp);
+    cpu->sp += 2;
+    return value;
+}
+
+// Immediate word at PC (a16 / n16), advances PC by 2
+static inline u16 mmu_fetch16(CPU *cpu) {
+    u16 offset = cpu->pc - cpu->fetch_lo;
+    if (offset + 1 < cpu->fetch_len) {
+        cpu->pc += 2;
+        return MAKE_U16(cpu->fetch_ptr[offset + 1], cpu->fetch_ptr[offset]);
+    }
+
+    u8 lo = mmu_fetch8(cpu);
+    u8 hi = mmu_fetch8(cpu);
+    return MAKE_U16(hi, lo);
+}
+
+// ---------------------------------------------
+// Page table
+// Invalidate pages whose backing memory changed (bank switch, boot ROM
+// unmapping, new cartridge, gb->cart.rom/ram swapped by hand).
+// They are re-resolved on their next access.
 // ---------------------------------------------
-u8   mmu_read(GameBoy *gb, u16 addr);
-void mmu_write(GameBoy *gb, u16 addr, u8 value);
+void mmu_map_invalidate(GameBoy *gb, u8 first_page, u8 last_page);
 
 // ---------------------------------------------
 // Debug Helpers
@@ -2,6 +2,7 @@
 #ifndef CARTRIDGE_H
 #define CARTRIDGE_H
 
+#include <core/mbc.h>
 #include <core/utils.h>
 #include <stddef.h>
 
@@ -43,16 +44,27 @@ typedef struct {
 
 // ---------------------------------------------
 // Cartridge
+// cart_load() maps the ROM file read-only, shared by every Cartridge that
+// loads the same file (see cartridge.c). rom_size is then padded to a
+// power-of-two number of banks, the padding reads 0xFF. Battery-backed RAM
+// is a shared mapping of the .sav file next to the ROM.
 // ---------------------------------------------
-typedef struct {
-    u8          *rom;        // ROM data
+typedef struct RomMapping RomMapping;
+
+typedef struct Cartridge {
+    u8          *rom;        // ROM data (read-only when mapped)
     size_t       rom_size;   // ROM size in bytes
+    RomMapping  *rom_map;    // Shared mapping `rom` points into, NULL = set by hand (free()d)
     u8          *ram;        // External RAM (for save data)
     size_t       ram_size;   // RAM size in bytes
+    u8          *save;       // mmap()ed .sav (battery carts): RAM, then the RTC footer, NULL = none
+    size_t       save_size;  // ram_size (+ MBC_RTC_SAVE_SIZE with a clock)
+    bool         save_dirty; // Written since the last cart_flush_save()
+    u64          save_syncs; // Statistics: flushes that had something to write back
+    bool         rtc_host;   // Set before cart_load(): the MBC3 clock follows host time, not cycles
     RawRomHeader raw_header; // Raw header as read from ROM
     CartHeader   header;     // Parsed header with usable values
-    // MBC-specific state (later)
-    // Battery flag (later)
+    Mbc          mbc;        // Bank controller (see mbc.h)
 } Cartridge;
 
 // ---------------------------------------------
@@ -62,9 +74,25 @@ typedef struct {
 // Load ROM from disk & parse header
 int         cart_load(Cartridge *cart, const char *path);
 
-// Unlod the cart: Free the allocated memory for RAM & ROM
+// Unload the cart: Drop the ROM mapping & free the RAM
 void        cart_unload(Cartridge *cart);
 
+// Files currently mapped by the ROM registry
+size_t      cart_rom_mappings(void);
+
+// Header types with battery-backed RAM / RTC (saved to the .sav file)
+bool        cart_has_battery(u8 cart_type);
+
+// Start writing back a dirty save (msync(MS_ASYNC)), returns whether it was dirty
+// The RTC footer is refreshed first, `now` being gb->cycles
+bool        cart_flush_save(Cartridge *cart, u64 now);
+
+// Read & parse only the header of a ROM file (pread() of 0x0150 bytes)
+// Returns 0, 1 (failed to open / read), 2 (too small) or -1 (header checksum
+// failed, `raw` / `out` are filled anyway)
+int         cart_probe(const char *path, RawRomHeader *raw, CartHeader *out);
+int         cart_probe_fd(int fd, RawRomHeader *raw, CartHeader *out);
+
 // Parse raw header into usable format
 void        parse_header(const RawRomHeader *raw, CartHeader *out);
 
@@ -77,6 +105,9 @@ size_t      get_ram_size(u8 ram_size_code);
 // Decode ROM size code to actual bytes
 size_t      get_rom_size(u8 rom_size_code);
 
+// rom_size cart_load() gives a `file_size` byte ROM (the rest reads 0xFF)
+size_t      cart_padded_rom_size(size_t file_size);
+
 // Get human-readable cartridge type name
 const char *get_cart_type_name(u8 type);
 
@@ -85,5 +116,6 @@ const char *get_publisher_name(u16 lic_code, bool is_old_code);
 
 // Get header checksum
 bool        cart_verify_header_checksum(const Cartridge *cart);
+bool        header_checksum_valid(const RawRomHeader *raw);
 
 #endif // CARTRIDGE_H
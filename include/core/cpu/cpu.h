@@ -12,6 +12,16 @@
 
 struct GameBoy;
 
+// ---------------------------------------------
+// Dispatch Engines
+// ---------------------------------------------
+typedef enum {
+    CPU_DISPATCH_TABLE,    // Portable: one indirect call through instr_table per opcode
+    CPU_DISPATCH_THREADED, // Threaded code: musttail / computed goto (falls back to TABLE)
+    CPU_DISPATCH_BLOCK,    // Pre-decoded basic blocks (see cpu_block.h)
+    CPU_DISPATCH_JIT,      // Blocks, hot ROM blocks translated to x86-64 (see cpu_jit.h)
+} CpuDispatch;
+
 typedef struct {
     // 8 bit registers
     struct {
@@ -32,7 +42,32 @@ typedef struct {
     // Interrupt state
     bool            ime;           // Interrupt Master Enable
     bool            ime_scheduled; // EI schedules IME to be set after next instruction
-    bool            halted;        // CPU is haled?
+    u8              irq_pending;   // IE & IF & 0x1F, kept up to date by cpu_irq_update()
+    u8              irq_check;     // Work for the dispatch prologue: IME ? irq_pending : 0,
+                                   // plus CPU_IRQ_EI while the EI delay runs
+    bool            halted;        // HALT: asleep until an enabled interrupt is requested
+    bool            stopped;       // STOP: asleep until a joypad interrupt is requested
+    bool            run_exit;      // Leave cpu_run() after the current instruction
+    u32             run_cycles;    // Cycles into the running cpu_run(), see gb_now()
+
+    // Engine used by cpu_dispatch()
+    CpuDispatch     dispatch;
+
+    // Instruction fetch window (see mmu_fetch8() in bus.h)
+    // PCs in [fetch_lo, fetch_lo + fetch_len) read fetch_ptr[pc - fetch_lo]
+    const u8       *fetch_ptr;
+    u16             fetch_lo;
+    u16             fetch_len; // 0 = no window, the next fetch re-resolves it
+
+    // Lazy flags: the last flag-setting ALU op, evaluated on demand (see cpu_alu.h)
+    bool            lazy_flags; // Defer Z/N/H/C until something reads them
+    struct {
+        u8 op;     // FlagOp, FLAGOP_NONE when regs.f is up to date
+        u8 a;      // First operand
+        u8 b;      // Second operand
+        u8 carry;  // Carry-in (ADC/SBC) or preserved C flag (INC/DEC)
+        u8 result; // Result of the operation
+    } lazy;
 
     // Pointer to the emulator context (for memory access)
     struct GameBoy *gb;
@@ -46,6 +81,13 @@ typedef struct {
 #define FLAG_HF_CARRY 0x20 // bit 5 (h)
 #define FLAG_CARRY 0x10    // bit 4 (c)
 
+// ---------------------------------------------
+// Interrupts
+// https://gbdev.io/pandocs/Interrupts.html
+// ---------------------------------------------
+#define CPU_IRQ_EI     0x80 // irq_check: IME turns on before the next instruction
+#define CPU_IRQ_CYCLES 20   // Dispatch: 2 wait states, push PC, jump to the vector
+
 // ---------------------------------------------
 // CPU Functions
 // ---------------------------------------------
@@ -53,6 +95,23 @@ void cpu_init(CPU *cpu, struct GameBoy *gb);
 void cpu_reset(CPU *cpu);
 u8   cpu_step(CPU *cpu); // Execute 1 instruction, return cycles
 
+// Run instructions until `budget` cycles are used up or an event needs the
+// caller's attention (HALT, interrupts, IO side effects). Adds the executed
+// cycles to gb->cycles once, on return, and returns them.
+// A halted / stopped CPU idles up to the next scheduled event instead.
+u32  cpu_run(CPU *cpu, u32 budget);
+
+// Ask cpu_run() to return after the current instruction
+void cpu_request_exit(CPU *cpu);
+
+// Recompute irq_pending / irq_check after IE, IF, IME or the EI delay changed
+// Asks cpu_run() to return when an interrupt became serviceable
+void cpu_irq_update(CPU *cpu);
+
+// Dispatch prologue work for a non-zero irq_check: ends the EI delay, or
+// services the highest-priority pending interrupt. Returns the cycles used
+u8   cpu_interrupt(CPU *cpu);
+
 // ---------------------------------------------
 // Register pair accessors
 // ---------------------------------------------
@@ -73,10 +132,31 @@ bool cpu_get_flag(CPU *cpu, u8 flag);
 void cpu_set_flag(CPU *cpu, u8 flag);
 void cpu_clear_flag(CPU *cpu, u8 flag);
 
+// Switch between eager and lazy flag evaluation (results are identical)
+// regs.f may be stale in lazy mode: read flags through cpu_read_af()/cpu_get_flag()
+void cpu_set_lazy_flags(CPU *cpu, bool enabled);
+
 // ---------------------------------------------
 // Internal CPU Functions (used by tables/exec)
 // Declared here so cpu_exec.c and cpu_tables.c can use them
 // ---------------------------------------------
 u8   cpu_execute(CPU *cpu, u8 opcode);
 
+// Opcode decoding (cpu_decode.c)
+u8   cpu_instr_length(u8 opcode);     // Bytes, including immediates
+bool cpu_instr_ends_block(u8 opcode); // Branch, HALT/STOP or EI/DI
+
+// ---------------------------------------------
+// Dispatch Engines
+// Execute instructions until at least `budget` cycles have elapsed or an
+// exit is requested. Return the number of cycles executed.
+// Does not touch gb->cycles: use cpu_run() for that.
+// ---------------------------------------------
+u32         cpu_dispatch(CPU *cpu, u32 budget); // Uses cpu->dispatch
+u32         cpu_dispatch_table(CPU *cpu, u32 budget);
+u32         cpu_dispatch_threaded(CPU *cpu, u32 budget);
+u32         cpu_dispatch_block(CPU *cpu, u32 budget);
+u32         cpu_dispatch_jit(CPU *cpu, u32 budget);
+const char *cpu_dispatch_name(CpuDispatch dispatch);
+
 #endif // !CPU_H
@@ -0,0 +1,254 @@
+// include/core/cpu/cpu_alu.h
+#ifndef CPU_ALU_H
+#define CPU_ALU_H
+
+#include <core/cpu/cpu.h>
+#include <core/utils.h>
+
+// ---------------------------------------------
+// Flag-setting operation kinds
+// ADC/SBC/CP reuse ADD/SUB (carry-in is 0 for plain ADD/SUB/CP)
+// ---------------------------------------------
+typedef enum {
+    FLAGOP_NONE, // regs.f is up to date
+    FLAGOP_ADD,  // ADD / ADC
+    FLAGOP_SUB,  // SUB / SBC / CP
+    FLAGOP_AND,  // AND
+    FLAGOP_OR,   // OR / XOR
+    FLAGOP_INC,  // INC r8 (carry holds the preserved C flag)
+    FLAGOP_DEC,  // DEC r8 (carry holds the preserved C flag)
+} FlagOp;
+
+// ---------------------------------------------
+// Precomputed ALU tables (CPU_ALU_TABLES build option)
+// Each entry holds the result in the high byte and the flags in the low byte
+// Filled once by cpu_alu_init()
+// ---------------------------------------------
+#ifdef CPU_ALU_TABLES
+extern u16 alu_add_table[2][256][256]; // [carry][a][b]: ADD / ADC
+extern u16 alu_sub_table[2][256][256]; // [carry][a][b]: SUB / SBC / CP
+extern u16 alu_inc_table[256];         // [value]: INC r8 (C not included)
+extern u16 alu_dec_table[256];         // [value]: DEC r8 (C not included)
+extern u16 alu_daa_table[8][256];      // [N:H:C][a]: DAA
+#endif
+
+void cpu_alu_init(void); // Build the ALU tables (no-op without CPU_ALU_TABLES)
+
+// ---------------------------------------------
+// Flag evaluation
+// ---------------------------------------------
+#ifdef CPU_ALU_TABLES
+
+static inline u8 alu_add_flags(u8 a, u8 b, u8 carry) {
+    return (u8)alu_add_table[carry][a][b];
+}
+
+static inline u8 alu_sub_flags(u8 a, u8 b, u8 carry) {
+    return (u8)alu_sub_table[carry][a][b];
+}
+
+static inline u8 alu_inc_flags(u8 value) {
+    return (u8)alu_inc_table[value];
+}
+
+static inline u8 alu_dec_flags(u8 value) {
+    return (u8)alu_dec_table[value];
+}
+
+#else
+
+static inline u8 alu_add_flags(u8 a, u8 b, u8 carry) {
+    u8 f = ((u8)(a + b + carry) == 0) ? FLAG_ZERO : 0;
+    if (check_half_carry_adc(a, b, carry))
+        f |= FLAG_HF_CARRY;
+    if (check_carry_adc(a, b, carry))
+        f |= FLAG_CARRY;
+    return f;
+}
+
+static inline u8 alu_sub_flags(u8 a, u8 b, u8 carry) {
+    u8 f = ((u8)(a - b - carry) == 0) ? FLAG_ZERO | FLAG_SUBT : FLAG_SUBT;
+    if (check_half_carry_sbc(a, b, carry))
+        f |= FLAG_HF_CARRY;
+    if (check_carry_sbc(a, b, carry))
+        f |= FLAG_CARRY;
+    return f;
+}
+
+static inline u8 alu_inc_flags(u8 value) {
+    u8 f = ((u8)(value + 1) == 0) ? FLAG_ZERO : 0;
+    if ((value & 0x0F) == 0x0F)
+        f |= FLAG_HF_CARRY;
+    return f;
+}
+
+static inline u8 alu_dec_flags(u8 value) {
+    u8 f = ((u8)(value - 1) == 0) ? FLAG_ZERO | FLAG_SUBT : FLAG_SUBT;
+    if ((value & 0x0F) == 0)
+        f |= FLAG_HF_CARRY;
+    return f;
+}
+
+#endif // CPU_ALU_TABLES
+
+// Compute Z/N/H/C for an operation
+static inline u8 alu_flags(u8 op, u8 a, u8 b, u8 carry, u8 result) {
+    switch (op) {
+        case FLAGOP_ADD:
+            return alu_add_flags(a, b, carry);
+        case FLAGOP_SUB:
+            return alu_sub_flags(a, b, carry);
+        case FLAGOP_AND:
+            return (result == 0) ? FLAG_ZERO | FLAG_HF_CARRY : FLAG_HF_CARRY;
+        case FLAGOP_INC:
+            return alu_inc_flags(a) | (carry ? FLAG_CARRY : 0);
+        case FLAGOP_DEC:
+            return alu_dec_flags(a) | (carry ? FLAG_CARRY : 0);
+        default: // FLAGOP_OR: only Z
+            return (result == 0) ? FLAG_ZERO : 0;
+    }
+}
+
+// Current F register, evaluating a pending lazy op without storing it
+static inline u8 cpu_flags_value(const CPU *cpu) {
+    if (cpu->lazy.op == FLAGOP_NONE)
+        return cpu->regs.f;
+    return alu_flags(cpu->lazy.op, cpu->lazy.a, cpu->lazy.b, cpu->lazy.carry, cpu->lazy.result);
+}
+
+// Materialize a pending lazy op into regs.f
+// Must be called before any partial read-modify-write of regs.f
+static inline void cpu_flags_sync(CPU *cpu) {
+    if (cpu->lazy.op != FLAGOP_NONE) {
+        cpu->regs.f  = cpu_flags_value(cpu);
+        cpu->lazy.op = FLAGOP_NONE;
+    }
+}
+
+// Overwrite all flags (drops any pending lazy op)
+static inline void cpu_flags_write(CPU *cpu, u8 f) {
+    cpu->lazy.op = FLAGOP_NONE;
+    cpu->regs.f  = f;
+}
+
+// Z flag, without materializing the others (conditional JP/JR/CALL/RET)
+static inline bool cpu_flag_z(const CPU *cpu) {
+    if (cpu->lazy.op == FLAGOP_NONE)
+        return (cpu->regs.f & FLAG_ZERO) != 0;
+    return cpu->lazy.result == 0;
+}
+
+// C flag, without materializing the others (conditionals, ADC/SBC, INC/DEC)
+static inline bool cpu_flag_c(const CPU *cpu) {
+    switch (cpu->lazy.op) {
+        case FLAGOP_NONE:
+            return (cpu->regs.f & FLAG_CARRY) != 0;
+        case FLAGOP_ADD:
+            return (alu_add_flags(cpu->lazy.a, cpu->lazy.b, cpu->lazy.carry) & FLAG_CARRY) != 0;
+        case FLAGOP_SUB:
+            return (alu_sub_flags(cpu->lazy.a, cpu->lazy.b, cpu->lazy.carry) & FLAG_CARRY) != 0;
+        case FLAGOP_INC:
+        case FLAGOP_DEC:
+            return cpu->lazy.carry != 0;
+        default: // AND / OR
+            return false;
+    }
+}
+
+// Record the flags of an ALU op
+// Eager mode computes them now, lazy mode keeps the inputs for later
+static inline void cpu_flags_defer(CPU *cpu, u8 op, u8 a, u8 b, u8 carry, u8 result) {
+    if (cpu->lazy_flags) {
+        cpu->lazy.op     = op;
+        cpu->lazy.a      = a;
+        cpu->lazy.b      = b;
+        cpu->lazy.carry  = carry;
+        cpu->lazy.result = result;
+    } else {
+        cpu->regs.f = alu_flags(op, a, b, carry, result);
+    }
+}
+
+// ---------------------------------------------
+// 8-bit ALU kernels
+// Return the result and record the flags
+// ---------------------------------------------
+
+// ADD / ADC
+static inline u8 alu_add(CPU *cpu, u8 a, u8 b, u8 carry) {
+    u8 result = a + b + carry;
+    cpu_flags_defer(cpu, FLAGOP_ADD, a, b, carry, result);
+    return result;
+}
+
+// SUB / SBC / CP
+static inline u8 alu_sub(CPU *cpu, u8 a, u8 b, u8 carry) {
+    u8 result = a - b - carry;
+    cpu_flags_defer(cpu, FLAGOP_SUB, a, b, carry, result);
+    return result;
+}
+
+static inline u8 alu_and(CPU *cpu, u8 a, u8 b) {
+    u8 result = a & b;
+    cpu_flags_defer(cpu, FLAGOP_AND, a, b, 0, result);
+    return result;
+}
+
+static inline u8 alu_or(CPU *cpu, u8 a, u8 b) {
+    u8 result = a | b;
+    cpu_flags_defer(cpu, FLAGOP_OR, a, b, 0, result);
+    return result;
+}
+
+static inline u8 alu_xor(CPU *cpu, u8 a, u8 b) {
+    u8 result = a ^ b;
+    cpu_flags_defer(cpu, FLAGOP_OR, a, b, 0, result);
+    return result;
+}
+
+// INC r8 (C preserved)
+static inline u8 alu_inc(CPU *cpu, u8 value) {
+    u8 result = value + 1;
+    cpu_flags_defer(cpu, FLAGOP_INC, value, 1, cpu_flag_c(cpu), result);
+    return result;
+}
+
+// DEC r8 (C preserved)
+static inline u8 alu_dec(CPU *cpu, u8 value) {
+    u8 result = value - 1;
+    cpu_flags_defer(cpu, FLAGOP_DEC, value, 1, cpu_flag_c(cpu), result);
+    return result;
+}
+
+// DAA: adjust A to BCD after an ADD/ADC or SUB/SBC (reads N/H/C)
+static inline u8 alu_daa(CPU *cpu, u8 a) {
+    cpu_flags_sync(cpu);
+
+#ifdef CPU_ALU_TABLES
+    u16 entry   = alu_daa_table[(cpu->regs.f >> 4) & 0x07][a];
+    cpu->regs.f = (u8)entry;
+    return entry >> 8;
+#else
+    bool sub    = (cpu->regs.f & FLAG_SUBT) != 0;
+    bool half   = (cpu->regs.f & FLAG_HF_CARRY) != 0;
+    bool carry  = (cpu->regs.f & FLAG_CARRY) != 0;
+
+    u8   result = adjust_bcd(a, sub, carry, half);
+
+    cpu->regs.f = 0;
+    if (result == 0)
+        cpu->regs.f |= FLAG_ZERO;
+    if (sub)
+        cpu->regs.f |= FLAG_SUBT;
+
+    // Carry is set if we corrected with 0x60
+    if (!sub && (carry || a > 0x99))
+        cpu->regs.f |= FLAG_CARRY;
+    if (sub && carry)
+        cpu->regs.f |= FLAG_CARRY;
+
+    return result;
+#endif
+}
+
+#endif // !CPU_ALU_H
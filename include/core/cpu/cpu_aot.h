@@ -0,0 +1,46 @@
+// include/core/cpu/cpu_aot.h
+#ifndef CPU_AOT_H
+#define CPU_AOT_H
+
+#include <core/cartridge.h>
+#include <core/cpu/cpu_block.h>
+
+// ---------------------------------------------
+// Ahead-of-time translated ROM code (CPU_DISPATCH_JIT)
+//
+// tools/gbaot.c walks a ROM from its entry point, the RST/interrupt vectors
+// and the jump tables it recognizes, and writes one C function per basic
+// block it reaches. Linked into a ROM-specific executable (see
+// add_aot_executable() in tools/CMakeLists.txt), the generated file registers
+// a CpuAotImage before main(). Loading the matching ROM selects the JIT
+// engine, and blocks decoded from a translated ROM offset run the generated
+// function as their native code. Anything the analysis missed (computed
+// jumps, code in RAM) runs on the interpreter and the JIT as usual.
+// ---------------------------------------------
+typedef struct {
+    u32           offset; // ROM offset of the first opcode
+    CpuNativeFunc func;   // Runs the block, leaves PC at the next one
+} CpuAotBlock;
+
+typedef struct CpuAotImage {
+    // ROM the code was generated from, as cart_load() pads it (cart_padded_rom_size())
+    u32                rom_size;
+    u32                rom_hash; // cpu_aot_rom_hash() of the padded ROM
+
+    const CpuAotBlock *blocks; // Sorted by offset
+    u32                count;
+} CpuAotImage;
+
+#define CPU_AOT_MAX_IMAGES 8
+
+// ---------------------------------------------
+// AOT functions
+// ---------------------------------------------
+void               cpu_aot_register(const CpuAotImage *image); // Called by generated code
+const CpuAotImage *cpu_aot_find(const Cartridge *cart);        // Image for `cart`, NULL if none
+u32                cpu_aot_rom_hash(const u8 *rom, size_t size); // FNV-1a over the whole ROM
+
+// Generated function for the block at ROM `offset`, NULL if not translated
+CpuNativeFunc      cpu_aot_lookup(const CpuAotImage *image, u32 offset);
+
+#endif // !CPU_AOT_H
@@ -0,0 +1,118 @@
+// include/core/cpu/cpu_block.h
+#ifndef CPU_BLOCK_H
+#define CPU_BLOCK_H
+
+#include <core/cpu/cpu.h>
+#include <core/utils.h>
+
+// ---------------------------------------------
+// Basic-block decode cache (CPU_DISPATCH_BLOCK)
+//
+// A block is the run of instructions from an entry PC up to and including
+// the next branch (see cpu_instr_ends_block()), decoded once into handler
+// pointers. Blocks are keyed by the host address of their first opcode, so
+// every ROM bank gets its own entries, and never cross a 256-byte page.
+//
+// Code in RAM: the page a block was decoded from is taken off the write map,
+// so the next write to it reaches mmu_write_slow(), which bumps the page
+// generation and drops every block built from that page.
+// ---------------------------------------------
+#define CPU_BLOCK_CACHE_SIZE 1024 // Entries, direct-mapped (power of two)
+#define CPU_BLOCK_MAX_INSTRS 16
+#define CPU_IDLE_MAX_READS   2 // Memory reads in an idle loop candidate
+
+// Translated block (see cpu_jit.h): runs the whole block, returns its cycles
+typedef u32 (*CpuNativeFunc)(CPU *cpu);
+
+struct CpuAotImage;
+
+// Where an idle loop read gets its address from
+typedef enum {
+    CPU_IDLE_ADDR, // Immediate (LDH A,(n) / LD A,(nn))
+    CPU_IDLE_BC,
+    CPU_IDLE_DE,
+    CPU_IDLE_HL,
+    CPU_IDLE_C, // 0xFF00 + C
+} CpuIdleSource;
+
+typedef struct {
+    const u8     *ptr;   // Host address of the first opcode (NULL = empty)
+    u32           gen;   // page_gen[] of the entry page when decoded
+    u16           pc;    // Entry PC
+    u8            count; // Number of instructions
+    u8 (*instrs[CPU_BLOCK_MAX_INSTRS])(CPU *cpu); // Handlers, opcode byte already decoded
+
+    // Idle loop candidate (see cpu_block_idle()): addresses it polls
+    bool          idle;
+    u8            idle_reads;
+    u8            idle_src[CPU_IDLE_MAX_READS];  // CpuIdleSource
+    u16           idle_addr[CPU_IDLE_MAX_READS]; // Address for CPU_IDLE_ADDR
+
+    // JIT state (CPU_DISPATCH_JIT)
+    u16           heat;         // Interpreted runs so far
+    u32           native_epoch; // cpu_jit_epoch when translated
+    CpuNativeFunc native;       // Translated code, NULL = interpret
+} CpuBlock;
+
+typedef struct {
+    CpuBlock blocks[CPU_BLOCK_CACHE_SIZE];
+
+    u32      page_gen[0x100];  // Per code page, bumped when the page is written
+    bool     code_page[0x100]; // Writable page with live blocks (off the write map)
+    bool     stale;            // Memory under the running block changed: leave it
+
+    // Ahead-of-time code for the loaded ROM, NULL = none (see cpu_aot.h)
+    const struct CpuAotImage *aot;
+
+    // Statistics
+    u64      hits;          // Lookups served from the cache
+    u64      misses;        // Lookups that decoded a block
+    u64      invalidations; // Writes that dropped the blocks of a page
+    u64      idle_skips;    // Idle loops fast-forwarded
+    u64      idle_cycles;   // Cycles skipped by them
+} CpuBlockCache;
+
+// Page whose generation covers `addr` (echo RAM shares the WRAM pages)
+static inline u8 cpu_block_page(u16 addr) {
+    u8 page = addr >> 8;
+    if (page >= 0xE0 && page < 0xFE)
+        page -= 0x20;
+    return page;
+}
+
+// Does a write to `addr` hit memory cached blocks were decoded from?
+static inline bool cpu_block_covers(const CpuBlockCache *cache, u16 addr) {
+    if (addr >= 0xFF00 && (addr < 0xFF80 || addr == 0xFFFF))
+        return false; // IO registers & IE share page 0xFF with HRAM
+    return cache->code_page[cpu_block_page(addr)];
+}
+
+// ---------------------------------------------
+// Block cache functions
+// ---------------------------------------------
+
+// Block starting at cpu->pc, decoded on a miss
+// NULL when PC has no fetch window (IO, OAM) or starts with an illegal opcode
+CpuBlock *cpu_block_lookup(CPU *cpu);
+
+// ---------------------------------------------
+// Idle loops
+// A block that jumps back to its own entry and only loads / tests values in
+// A and F (e.g. LDH A,(0x44); CP 0x90; JR NZ) is a busy wait: once an
+// iteration leaves A and F as it found them, all later iterations are
+// identical until an event changes memory or a polled register moves on its
+// own (mmu_poll_deadline(): LY, STAT, DIV, TIMA). The engines call this after
+// running a candidate (`af` and `start` as before the run): it skips all the
+// whole iterations that end before then and within the budget, and returns
+// the new cycle count.
+// ---------------------------------------------
+u32       cpu_block_idle(CPU *cpu, const CpuBlock *block, u16 af, u32 start, u32 cycles,
+                         u32 budget);
+
+// Drop the blocks of the page containing `addr` (called by mmu_write_slow)
+void      cpu_block_invalidate(CpuBlockCache *cache, u16 addr);
+
+// Drop every block (new ROM)
+void      cpu_block_flush(CpuBlockCache *cache);
+
+#endif // !CPU_BLOCK_H
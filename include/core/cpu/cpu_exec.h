@@ -8,6 +8,9 @@
 
 typedef u8 (*InstrFunc)(CPU *cpu);
 
+// Handler for `opcode`, NULL if illegal / not implemented (cpu_tables.c)
+InstrFunc cpu_instr_handler(u8 opcode);
+
 // =====================================================
 // 8-bit Load Instructions
 // =====================================================
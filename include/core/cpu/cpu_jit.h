@@ -0,0 +1,40 @@
+// include/core/cpu/cpu_jit.h
+#ifndef CPU_JIT_H
+#define CPU_JIT_H
+
+#include <core/cpu/cpu.h>
+#include <core/cpu/cpu_block.h>
+#include <stddef.h>
+
+// ---------------------------------------------
+// x86-64 translation of hot ROM blocks (CPU_DISPATCH_JIT, CPU_JIT build option)
+//
+// A decoded block from cpu_block.h that ran CPU_JIT_THRESHOLD times out of
+// ROM is translated to native code. A/F/BC/DE/HL/SP live in host registers
+// for the whole block. Register, immediate & (HL) loads, 8-bit ALU ops,
+// 16-bit INC/DEC and JR/JP are emitted inline ((HL) goes through the page
+// map, the bus.c slow path only for IO/MBC). Every other instruction calls
+// its interpreter handler. Cycles are added up and returned at block exits.
+//
+// Blocks in RAM are never translated, so self-modifying code keeps running
+// on the interpreter. Without CPU_JIT (or when no executable memory can be
+// mapped) the JIT engine behaves like the block engine.
+// ---------------------------------------------
+#define CPU_JIT_THRESHOLD 16 // Interpreted runs before a block gets translated
+
+// Translated code is valid while its epoch matches (the code buffer was not recycled)
+// CPU_AOT_EPOCH marks ahead-of-time code (cpu_aot.h), which is always valid
+#define CPU_AOT_EPOCH 0
+extern u32 cpu_jit_epoch;
+
+static inline CpuNativeFunc cpu_jit_native(const CpuBlock *block) {
+    if (block->native_epoch == cpu_jit_epoch || block->native_epoch == CPU_AOT_EPOCH)
+        return block->native;
+    return NULL;
+}
+
+bool          cpu_jit_available(void);                     // Built with CPU_JIT, code buffer mapped
+CpuNativeFunc cpu_jit_compile(CpuBlock *block);            // Translate, NULL if not possible
+u32           cpu_jit_run(CPU *cpu, CpuNativeFunc native); // Run translated code, return cycles
+
+#endif // !CPU_JIT_H
@@ -0,0 +1,303 @@
+// include/core/cpu/cpu_opcodes.h
+#ifndef CPU_OPCODES_H
+#define CPU_OPCODES_H
+
+// ---------------------------------------------
+// Opcode map (256 entries)
+// https://www.pastraiser.com/cpu/gameboy/gameboy_opcodes.html
+//
+// Single source for every dispatch path in cpu_tables.c and for the
+// handler names the AOT generator (tools/gbaot.c) emits:
+// OP(code, handler) - implemented opcode
+// NO_OP(code)       - illegal / not yet implemented opcode
+// ---------------------------------------------
+#define OPCODE_MAP(OP, NO_OP)                                                                      \
+    /* 0x0_ */                                                                                     \
+    OP(0x00, instr_nop)                                                                            \
+    OP(0x01, instr_ld_bc_nn)                                                                       \
+    OP(0x02, instr_ld_mem_bc_a)                                                                    \
+    OP(0x03, instr_inc_bc)                                                                         \
+    OP(0x04, instr_inc_b)                                                                          \
+    OP(0x05, instr_dec_b)                                                                          \
+    OP(0x06, instr_ld_b_n)                                                                         \
+    OP(0x07, instr_rlca)                                                                           \
+    OP(0x08, instr_ld_mem_a16_sp)                                                                  \
+    OP(0x09, instr_add_hl_bc)                                                                      \
+    OP(0x0A, instr_ld_a_mem_bc)                                                                    \
+    OP(0x0B, instr_dec_bc)                                                                         \
+    OP(0x0C, instr_inc_c)                                                                          \
+    OP(0x0D, instr_dec_c)                                                                          \
+    OP(0x0E, instr_ld_c_n)                                                                         \
+    OP(0x0F, instr_rrca)                                                                           \
+                                                                                                   \
+    /* 0x1_ */                                                                                     \
+    OP(0x10, instr_stop)                                                                           \
+    OP(0x11, instr_ld_de_nn)                                                                       \
+    OP(0x12, instr_ld_mem_de_a)                                                                    \
+    OP(0x13, instr_inc_de)                                                                         \
+    OP(0x14, instr_inc_d)                                                                          \
+    OP(0x15, instr_dec_d)                                                                          \
+    OP(0x16, instr_ld_d_n)                                                                         \
+    OP(0x17, instr_rla)                                                                            \
+    OP(0x18, instr_jr_e8)                                                                          \
+    OP(0x19, instr_add_hl_de)                                                                      \
+    OP(0x1A, instr_ld_a_mem_de)                                                                    \
+    OP(0x1B, instr_dec_de)                                                                         \
+    OP(0x1C, instr_inc_e)                                                                          \
+    OP(0x1D, instr_dec_e)                                                                          \
+    OP(0x1E, instr_ld_e_n)                                                                         \
+    OP(0x1F, instr_rra)                                                                            \
+                                                                                                   \
+    /* 0x2_ */                                                                                     \
+    OP(0x20, instr_jr_nz_e8)                                                                       \
+    OP(0x21, instr_ld_hl_nn)                                                                       \
+    OP(0x22, instr_ld_mem_hli_a)                                                                   \
+    OP(0x23, instr_inc_hl)                                                                         \
+    OP(0x24, instr_inc_h)                                                                          \
+    OP(0x25, instr_dec_h)                                                                          \
+    OP(0x26, instr_ld_h_n)                                                                         \
+    OP(0x27, instr_daa)                                                                            \
+    OP(0x28, instr_jr_z_e8)                                                                        \
+    OP(0x29, instr_add_hl_hl)                                                                      \
+    OP(0x2A, instr_ld_a_mem_hli)                                                                   \
+    OP(0x2B, instr_dec_hl)                                                                         \
+    OP(0x2C, instr_inc_l)                                                                          \
+    OP(0x2D, instr_dec_l)                                                                          \
+    OP(0x2E, instr_ld_l_n)                                                                         \
+    OP(0x2F, instr_cpl)                                                                            \
+                                                                                                   \
+    /* 0x3_ */                                                                                     \
+    OP(0x30, instr_jr_nc_e8)                                                                       \
+    OP(0x31, instr_ld_sp_nn)                                                                       \
+    OP(0x32, instr_ld_mem_hld_a)                                                                   \
+    OP(0x33, instr_inc_sp)                                                                         \
+    OP(0x34, instr_inc_mem_hl)                                                                     \
+    OP(0x35, instr_dec_mem_hl)                                                                     \
+    OP(0x36, instr_ld_mem_hl_n)                                                                    \
+    OP(0x37, instr_scf)                                                                            \
+    OP(0x38, instr_jr_c_e8)                                                                        \
+    OP(0x39, instr_add_hl_sp)                                                                      \
+    OP(0x3A, instr_ld_a_mem_hld)                                                                   \
+    OP(0x3B, instr_dec_sp)                                                                         \
+    OP(0x3C, instr_inc_a)                                                                          \
+    OP(0x3D, instr_dec_a)                                                                          \
+    OP(0x3E, instr_ld_a_n)                                                                         \
+    OP(0x3F, instr_ccf)                                                                            \
+                                                                                                   \
+    /* 0x4_ */                                                                                     \
+    OP(0x40, instr_ld_b_b)                                                                         \
+    OP(0x41, instr_ld_b_c)                                                                         \
+    OP(0x42, instr_ld_b_d)                                                                         \
+    OP(0x43, instr_ld_b_e)                                                                         \
+    OP(0x44, instr_ld_b_h)                                                                         \
+    OP(0x45, instr_ld_b_l)                                                                         \
+    OP(0x46, instr_ld_b_mem_hl)                                                                    \
+    OP(0x47, instr_ld_b_a)                                                                         \
+    OP(0x48, instr_ld_c_b)                                                                         \
+    OP(0x49, instr_ld_c_c)                                                                         \
+    OP(0x4A, instr_ld_c_d)                                                                         \
+    OP(0x4B, instr_ld_c_e)                                                                         \
+    OP(0x4C, instr_ld_c_h)                                                                         \
+    OP(0x4D, instr_ld_c_l)                                                                         \
+    OP(0x4E, instr_ld_c_mem_hl)                                                                    \
+    OP(0x4F, instr_ld_c_a)                                                                         \
+                                                                                                   \
+    /* 0x5_ */                                                                                     \
+    OP(0x50, instr_ld_d_b)                                                                         \
+    OP(0x51, instr_ld_d_c)                                                                         \
+    OP(0x52, instr_ld_d_d)                                                                         \
+    OP(0x53, instr_ld_d_e)                                                                         \
+    OP(0x54, instr_ld_d_h)                                                                         \
+    OP(0x55, instr_ld_d_l)                                                                         \
+    OP(0x56, instr_ld_d_mem_hl)                                                                    \
+    OP(0x57, instr_ld_d_a)                                                                         \
+    OP(0x58, instr_ld_e_b)                                                                         \
+    OP(0x59, instr_ld_e_c)                                                                         \
+    OP(0x5A, instr_ld_e_d)                                                                         \
+    OP(0x5B, instr_ld_e_e)                                                                         \
+    OP(0x5C, instr_ld_e_h)                                                                         \
+    OP(0x5D, instr_ld_e_l)                                                                         \
+    OP(0x5E, instr_ld_e_mem_hl)                                                                    \
+    OP(0x5F, instr_ld_e_a)                                                                         \
+                                                                                                   \
+    /* 0x6_ */                                                                                     \
+    OP(0x60, instr_ld_h_b)                                                                         \
+    OP(0x61, instr_ld_h_c)                                                                         \
+    OP(0x62, instr_ld_h_d)                                                                         \
+    OP(0x63, instr_ld_h_e)                                                                         \
+    OP(0x64, instr_ld_h_h)                                                                         \
+    OP(0x65, instr_ld_h_l)                                                                         \
+    OP(0x66, instr_ld_h_mem_hl)                                                                    \
+    OP(0x67, instr_ld_h_a)                                                                         \
+    OP(0x68, instr_ld_l_b)                                                                         \
+    OP(0x69, instr_ld_l_c)                                                                         \
+    OP(0x6A, instr_ld_l_d)                                                                         \
+    OP(0x6B, instr_ld_l_e)                                                                         \
+    OP(0x6C, instr_ld_l_h)                                                                         \
+    OP(0x6D, instr_ld_l_l)                                                                         \
+    OP(0x6E, instr_ld_l_mem_hl)                                                                    \
+    OP(0x6F, instr_ld_l_a)                                                                         \
+                                                                                                   \
+    /* 0x7_ */                                                                                     \
+    OP(0x70, instr_ld_mem_hl_b)                                                                    \
+    OP(0x71, instr_ld_mem_hl_c)                                                                    \
+    OP(0x72, instr_ld_mem_hl_d)                                                                    \
+    OP(0x73, instr_ld_mem_hl_e)                                                                    \
+    OP(0x74, instr_ld_mem_hl_h)                                                                    \
+    OP(0x75, instr_ld_mem_hl_l)                                                                    \
+    OP(0x76, instr_halt)                                                                           \
+    OP(0x77, instr_ld_mem_hl_a)                                                                    \
+    OP(0x78, instr_ld_a_b)                                                                         \
+    OP(0x79, instr_ld_a_c)                                                                         \
+    OP(0x7A, instr_ld_a_d)                                                                         \
+    OP(0x7B, instr_ld_a_e)                                                                         \
+    OP(0x7C, instr_ld_a_h)                                                                         \
+    OP(0x7D, instr_ld_a_l)                                                                         \
+    OP(0x7E, instr_ld_a_mem_hl)                                                                    \
+    OP(0x7F, instr_ld_a_a)                                                                         \
+                                                                                                   \
+    /* 0x8_ */                                                                                     \
+    OP(0x80, instr_add_a_b)                                                                        \
+    OP(0x81, instr_add_a_c)                                                                        \
+    OP(0x82, instr_add_a_d)                                                                        \
+    OP(0x83, instr_add_a_e)                                                                        \
+    OP(0x84, instr_add_a_h)                                                                        \
+    OP(0x85, instr_add_a_l)                                                                        \
+    OP(0x86, instr_add_a_mem_hl)                                                                   \
+    OP(0x87, instr_add_a_a)                                                                        \
+    OP(0x88, instr_adc_a_b)                                                                        \
+    OP(0x89, instr_adc_a_c)                                                                        \
+    OP(0x8A, instr_adc_a_d)                                                                        \
+    OP(0x8B, instr_adc_a_e)                                                                        \
+    OP(0x8C, instr_adc_a_h)                                                                        \
+    OP(0x8D, instr_adc_a_l)                                                                        \
+    OP(0x8E, instr_adc_a_mem_hl)                                                                   \
+    OP(0x8F, instr_adc_a_a)                                                                        \
+                                                                                                   \
+    /* 0x9_ */                                                                                     \
+    OP(0x90, instr_sub_a_b)                                                                        \
+    OP(0x91, instr_sub_a_c)                                                                        \
+    OP(0x92, instr_sub_a_d)                                                                        \
+    OP(0x93, instr_sub_a_e)                                                                        \
+    OP(0x94, instr_sub_a_h)                                                                        \
+    OP(0x95, instr_sub_a_l)                                                                        \
+    OP(0x96, instr_sub_a_mem_hl)                                                                   \
+    OP(0x97, instr_sub_a_a)                                                                        \
+    OP(0x98, instr_sbc_a_b)                                                                        \
+    OP(0x99, instr_sbc_a_c)                                                                        \
+    OP(0x9A, instr_sbc_a_d)                                                                        \
+    OP(0x9B, instr_sbc_a_e)                                                                        \
+    OP(0x9C, instr_sbc_a_h)                                                                        \
+    OP(0x9D, instr_sbc_a_l)                                                                        \
+    OP(0x9E, instr_sbc_a_mem_hl)                                                                   \
+    OP(0x9F, instr_sbc_a_a)                                                                        \
+                                                                                                   \
+    /* 0xA_ */                                                                                     \
+    OP(0xA0, instr_and_a_b)                                                                        \
+    OP(0xA1, instr_and_a_c)                                                                        \
+    OP(0xA2, instr_and_a_d)                                                                        \
+    OP(0xA3, instr_and_a_e)                                                                        \
+    OP(0xA4, instr_and_a_h)                                                                        \
+    OP(0xA5, instr_and_a_l)                                                                        \
+    OP(0xA6, instr_and_a_mem_hl)                                                                   \
+    OP(0xA7, instr_and_a_a)                                                                        \
+    OP(0xA8, instr_xor_a_b)                                                                        \
+    OP(0xA9, instr_xor_a_c)                                                                        \
+    OP(0xAA, instr_xor_a_d)                                                                        \
+    OP(0xAB, instr_xor_a_e)                                                                        \
+    OP(0xAC, instr_xor_a_h)                                                                        \
+    OP(0xAD, instr_xor_a_l)                                                                        \
+    OP(0xAE, instr_xor_a_mem_hl)                                                                   \
+    OP(0xAF, instr_xor_a_a)                                                                        \
+                                                                                                   \
+    /* 0xB_ */                                                                                     \
+    OP(0xB0, instr_or_a_b)                                                                         \
+    OP(0xB1, instr_or_a_c)                                                                         \
+    OP(0xB2, instr_or_a_d)                                                                         \
+    OP(0xB3, instr_or_a_e)                                                                         \
+    OP(0xB4, instr_or_a_h)                                                                         \
+    OP(0xB5, instr_or_a_l)                                                                         \
+    OP(0xB6, instr_or_a_mem_hl)                                                                    \
+    OP(0xB7, instr_or_a_a)                                                                         \
+    OP(0xB8, instr_cp_a_b)                                                                         \
+    OP(0xB9, instr_cp_a_c)                                                                         \
+    OP(0xBA, instr_cp_a_d)                                                                         \
+    OP(0xBB, instr_cp_a_e)                                                                         \
+    OP(0xBC, instr_cp_a_h)                                                                         \
+    OP(0xBD, instr_cp_a_l)                                                                         \
+    OP(0xBE, instr_cp_a_mem_hl)                                                                    \
+    OP(0xBF, instr_cp_a_a)                                                                         \
+                                                                                                   \
+    /* 0xC_ */                                                                                     \
+    OP(0xC0, instr_ret_nz)                                                                         \
+    OP(0xC1, instr_pop_bc)                                                                         \
+    OP(0xC2, instr_jp_nz_a16)                                                                      \
+    OP(0xC3, instr_jp_a16)                                                                         \
+    OP(0xC4, instr_call_nz_a16)                                                                    \
+    OP(0xC5, instr_push_bc)                                                                        \
+    OP(0xC6, instr_add_a_n)                                                                        \
+    OP(0xC7, instr_rst_00)                                                                         \
+    OP(0xC8, instr_ret_z)                                                                          \
+    OP(0xC9, instr_ret)                                                                            \
+    OP(0xCA, instr_jp_z_a16)                                                                       \
+    NO_OP(0xCB) /* TODO: instr_prefix_cb */                                                        \
+    OP(0xCC, instr_call_z_a16)                                                                     \
+    OP(0xCD, instr_call_a16)                                                                       \
+    OP(0xCE, instr_adc_a_n)                                                                        \
+    OP(0xCF, instr_rst_08)                                                                         \
+                                                                                                   \
+    /* 0xD_ */                                                                                     \
+    OP(0xD0, instr_ret_nc)                                                                         \
+    OP(0xD1, instr_pop_de)                                                                         \
+    OP(0xD2, instr_jp_nc_a16)                                                                      \
+    NO_OP(0xD3)                                                                                    \
+    OP(0xD4, instr_call_nc_a16)                                                                    \
+    OP(0xD5, instr_push_de)                                                                        \
+    OP(0xD6, instr_sub_a_n)                                                                        \
+    OP(0xD7, instr_rst_10)                                                                         \
+    OP(0xD8, instr_ret_c)                                                                          \
+    OP(0xD9, instr_reti)                                                                           \
+    OP(0xDA, instr_jp_c_a16)                                                                       \
+    NO_OP(0xDB)                                                                                    \
+    OP(0xDC, instr_call_c_a16)                                                                     \
+    NO_OP(0xDD)                                                                                    \
+    OP(0xDE, instr_sbc_a_n)                                                                        \
+    OP(0xDF, instr_rst_18)                                                                         \
+                                                                                                   \
+    /* 0xE_ */                                                                                     \
+    OP(0xE0, instr_ldh_mem_a8_a)                                                                   \
+    OP(0xE1, instr_pop_hl)                                                                         \
+    OP(0xE2, instr_ldh_mem_c_a)                                                                    \
+    NO_OP(0xE3)                                                                                    \
+    NO_OP(0xE4)                                                                                    \
+    OP(0xE5, instr_push_hl)                                                                        \
+    OP(0xE6, instr_and_a_n)                                                                        \
+    OP(0xE7, instr_rst_20)                                                                         \
+    OP(0xE8, instr_add_sp_e8)                                                                      \
+    OP(0xE9, instr_jp_hl)                                                                          \
+    OP(0xEA, instr_ld_mem_a16_a)                                                                   \
+    NO_OP(0xEB)                                                                                    \
+    NO_OP(0xEC)                                                                                    \
+    NO_OP(0xED)                                                                                    \
+    OP(0xEE, instr_xor_a_n)                                                                        \
+    OP(0xEF, instr_rst_28)                                                                         \
+                                                                                                   \
+    /* 0xF_ */                                                                                     \
+    OP(0xF0, instr_ldh_a_mem_a8)                                                                   \
+    OP(0xF1, instr_pop_af)                                                                         \
+    OP(0xF2, instr_ldh_a_mem_c)                                                                    \
+    OP(0xF3, instr_di)                                                                             \
+    NO_OP(0xF4)                                                                                    \
+    OP(0xF5, instr_push_af)                                                                        \
+    OP(0xF6, instr_or_a_n)                                                                         \
+    OP(0xF7, instr_rst_30)                                                                         \
+    OP(0xF8, instr_ld_hl_sp_e8)                                                                    \
+    OP(0xF9, instr_ld_sp_hl)                                                                       \
+    OP(0xFA, instr_ld_a_mem_a16)                                                                   \
+    OP(0xFB, instr_ei)                                                                             \
+    NO_OP(0xFC)                                                                                    \
+    NO_OP(0xFD)                                                                                    \
+    OP(0xFE, instr_cp_a_n)                                                                         \
+    OP(0xFF, instr_rst_38)
+
+#endif // !CPU_OPCODES_H
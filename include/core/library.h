@@ -0,0 +1,56 @@
+// include/core/library.h
+#ifndef LIBRARY_H
+#define LIBRARY_H
+
+#include <core/utils.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// ---------------------------------------------
+// ROM library index
+// library_scan() walks a directory tree and probes every .gb / .gbc / .sgb
+// file on a pool of threads: the header through cart_probe_fd(), then one
+// pread() pass over the file for the global checksum and the CRC32. Files
+// whose (path, mtime, size) match an entry of a previous index are taken
+// from it without being opened, so rescans only read what changed.
+// The index is written as CSV (which library_load() reads back) or JSON.
+// ---------------------------------------------
+typedef enum {
+    LIBRARY_CSV,
+    LIBRARY_JSON,
+} LibraryFormat;
+
+typedef struct {
+    char *path;
+    u64   size;  // File size
+    i64   mtime; // Modification time (seconds)
+    bool  valid; // Probed, false = unreadable / too small (left out of the index)
+
+    char  title[17];
+    u8    cart_type;
+    u8    rom_size_code;
+    u8    ram_size_code;
+    bool  cgb;       // CGB enhanced / only
+    bool  header_ok; // Header checksum (0x014D) matches
+    bool  global_ok; // Global checksum (0x014E - 0x014F) matches
+    u32   crc32;     // CRC-32 of the whole file
+} LibraryEntry;
+
+typedef struct {
+    LibraryEntry *entries; // Sorted by path
+    size_t        count;
+    size_t        capacity;
+    size_t        probed;  // Files the last scan opened, the others came from the cache
+} Library;
+
+// Index the ROMs under `dir` on `threads` threads (<= 0: one per CPU)
+// `cache` (may be NULL) is a previous index. Returns 0, or -1 if `dir` can't be opened
+int  library_scan(Library *lib, const char *dir, const Library *cache, int threads);
+
+// Read a CSV index written by library_write(). Returns 0, or -1 if the file can't be opened
+int  library_load(Library *lib, const char *path);
+
+void library_write(const Library *lib, FILE *out, LibraryFormat format);
+void library_free(Library *lib);
+
+#endif // !LIBRARY_H
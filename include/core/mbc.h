@@ -0,0 +1,105 @@
+// include/core/mbc.h
+#ifndef MBC_H
+#define MBC_H
+
+#include <core/utils.h>
+
+// ---------------------------------------------
+// Memory Bank Controllers (MBC1 / MBC2 / MBC3 / MBC5)
+// https://gbdev.io/pandocs/MBCs.html
+//
+// Bank-select writes recompute host pointers to the banks mapped at
+// 0x0000 - 0x3FFF, 0x4000 - 0x7FFF and 0xA000 - 0xBFFF, once per switch:
+// an access is then base pointer + offset, without bank arithmetic. The
+// bus drops the page table entries of a region only when its pointer
+// actually changed (see mbc_write()).
+// ---------------------------------------------
+typedef enum {
+    MBC_NONE, // ROM only / ROM+RAM: no banking
+    MBC_1,
+    MBC_2,
+    MBC_3,
+    MBC_5,
+} MbcType;
+
+// Regions whose bank pointer changed, returned by mbc_write()
+#define MBC_MAP_ROM0 0x01 // 0x0000 - 0x3FFF
+#define MBC_MAP_ROMN 0x02 // 0x4000 - 0x7FFF
+#define MBC_MAP_RAM  0x04 // 0xA000 - 0xBFFF
+
+#define MBC_ROM_BANK_SIZE 0x4000
+#define MBC_RAM_BANK_SIZE 0x2000
+#define MBC2_RAM_SIZE     0x200 // 512 x 4 bits, built in
+
+// ---------------------------------------------
+// MBC3 real-time clock
+// Nothing ticks: the live counter is brought up to date from a clock
+// reading only when the game latches it or writes a register. The clock is
+// gb->cycles (deterministic, stops with the emulator) or the host's wall
+// clock. Battery carts keep it in the 48-byte footer of the .sav file used
+// by BGB / VBA-M: live & latched registers as u32 LE, then a Unix time.
+// ---------------------------------------------
+#define MBC_RTC_CYCLE_RATE  4194304 // Clock units per second: cycles
+#define MBC_RTC_HOST_RATE   1000000 // Clock units per second: host microseconds
+#define MBC_RTC_SAVE_SIZE   48
+
+typedef struct {
+    // Live counter as of `stamp`
+    u8   sec;
+    u8   min;
+    u8   hour;
+    u16  days;  // 9 bits
+    bool halt;  // DH bit 6: stopped
+    bool carry; // DH bit 7: days overflowed, sticky
+
+    u64  stamp;      // Clock reading the counter is current at (sub-second phase kept)
+    bool host;       // Clock is host time instead of gb->cycles
+    u8   latched[5]; // Registers 0x08 - 0x0C as the game reads them (S, M, H, DL, DH)
+    u8   latch_last; // Last 0x6000 - 0x7FFF write (0x00 then 0x01 latches)
+} MbcRtc;
+
+struct Cartridge;
+
+typedef struct {
+    MbcType   type;
+
+    // Registers as last written
+    u16       rom_bank;    // ROM bank number (MBC1: 5 bits, MBC2: 4, MBC3: 7, MBC5: 9)
+    u8        bank2;       // MBC1 upper bits, MBC3 RAM bank / RTC register, MBC5 RAM bank
+    bool      ram_enabled; // 0x0A written to the RAM enable register
+    bool      mode;        // MBC1 banking mode (1 = bank2 also applies to 0x0000 & RAM)
+    MbcRtc    rtc;         // MBC3 clock, selected by bank2 = 0x08 - 0x0C
+
+    // Derived on every switch, NULL = nothing mapped (reads 0xFF)
+    const u8 *rom_bank0_ptr; // 0x0000 - 0x3FFF
+    const u8 *rom_bank_ptr;  // 0x4000 - 0x7FFF
+    u8       *ram_bank_ptr;  // 0xA000 - 0xBFFF (disabled RAM / RTC registers: NULL)
+    u16       ram_mask;      // Offset mask into the RAM bank (smaller RAMs are mirrored)
+
+    // Statistics: writes that changed a bank pointer
+    u64       rom_switches;
+    u64       ram_switches;
+} Mbc;
+
+// Controller of a header cartridge type (0x0147)
+MbcType mbc_type(u8 cart_type);
+
+// Reset the registers & bank pointers (after the ROM / RAM buffers are set)
+// The RTC starts at zero on clock reading 0 (cycles) / now (host)
+void    mbc_init(struct Cartridge *cart);
+
+// Register write (0x0000 - 0x7FFF), returns the MBC_MAP_* regions that changed
+// `now` is gb->cycles, for the RTC latch
+u8      mbc_write(struct Cartridge *cart, u16 addr, u8 value, u64 now);
+
+// External RAM access with no bank pointer to go through: disabled RAM,
+// MBC3 RTC registers, MBC2 writes (only the low 4 bits exist)
+u8      mbc_read_ram(const struct Cartridge *cart, u16 addr);
+void    mbc_write_ram(struct Cartridge *cart, u16 addr, u8 value, u64 now);
+
+// RTC state <-> .sav footer (MBC_RTC_SAVE_SIZE bytes). Loading a host-time
+// clock adds the wall time elapsed since it was stored
+void    mbc_rtc_load(struct Cartridge *cart, const u8 *footer);
+void    mbc_rtc_store(struct Cartridge *cart, u8 *footer, u64 now);
+
+#endif // !MBC_H
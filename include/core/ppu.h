@@ -0,0 +1,139 @@
+// include/core/ppu.h
+#ifndef PPU_H
+#define PPU_H
+
+#include <core/utils.h>
+
+// ---------------------------------------------
+// PPU timing (LY / STAT)
+// https://gbdev.io/pandocs/Rendering.html
+//
+// Nothing ticks: with the LCD on, the position in the frame is the time
+// since the frame started. LY and the STAT mode / coincidence bits are
+// brought up to date when an LCD register is accessed (ppu_sync()) and at
+// the end of gb_run_frame(). Interrupts are EVENT_PPU deadlines: VBlank
+// once per frame, plus every mode / line boundary while a STAT source is
+// enabled. With the LCD off no event is queued.
+//
+// Rendering catches up the same way: every sync first draws the visible
+// lines whose mode 3 ended since the last one, a whole line at a time
+// with the registers as they are then (ppu_render_line()). LCD register,
+// VRAM and OAM writes all sync, so a line sees the writes made before
+// the end of its mode 3 and none of the later ones.
+//
+// Each line is drawn by the PPU's renderer (PpuRenderer): the scanline one
+// (ppu_render.c), the dot-accurate pixel FIFO (ppu_fifo.c), or "auto",
+// which takes the FIFO only for lines that had an LCD register written
+// during their mode 3. Such writes are logged with their dot, so the FIFO
+// replays them at the pixel they hit. The STAT mode 3 length stays the
+// fixed PPU_DRAW_CYCLES whichever renderer is used.
+// ---------------------------------------------
+#define PPU_LINE_CYCLES   456 // One scanline
+#define PPU_LINES         154 // 144 visible + 10 VBlank
+#define PPU_FRAME_CYCLES  (PPU_LINE_CYCLES * PPU_LINES)
+#define PPU_VBLANK_LINE   144
+#define PPU_OAM_CYCLES    80  // Mode 2, from the start of the line
+#define PPU_DRAW_CYCLES   172 // Mode 3, after mode 2 (without sprite / scroll penalties)
+#define PPU_TILES         384 // 0x8000 - 0x97FF, 16 bytes each
+#define PPU_WIDTH         160
+#define PPU_HEIGHT        144
+#define PPU_LINE_SPRITES  10  // Sprites per line, the first ones in OAM order
+#define PPU_LOG_WRITES    48  // Mode 3 writes kept per line (172 dots, a write takes >= 4)
+
+// STAT bits 0-1
+typedef enum {
+    PPU_MODE_HBLANK,
+    PPU_MODE_VBLANK,
+    PPU_MODE_OAM,
+    PPU_MODE_DRAW,
+} PpuMode;
+
+struct GameBoy;
+
+// Line renderer, selected per instance through PPU.renderer
+typedef struct {
+    const char *name;
+    void (*render_line)(struct GameBoy *gb, u8 ly); // Visible line `ly` into the framebuffer
+} PpuRenderer;
+
+extern const PpuRenderer ppu_renderer_scanline; // Whole lines, writes in mode 3 hit the whole line
+extern const PpuRenderer ppu_renderer_fifo;     // Dot by dot: fetcher, BG & sprite FIFOs
+extern const PpuRenderer ppu_renderer_auto;     // FIFO for lines with mode 3 writes, else scanline
+
+// Rendering registers (LCDC, SCY, SCX, BGP, OBP0, OBP1, WY, WX)
+typedef struct {
+    u8 lcdc;
+    u8 scy;
+    u8 scx;
+    u8 bgp;
+    u8 obp0;
+    u8 obp1;
+    u8 wy;
+    u8 wx;
+} PpuRegs;
+
+// An LCD register write made during mode 3
+typedef struct {
+    u16 dot;  // Into the line
+    u8  addr; // Low byte of 0xFF40 - 0xFF4B
+    u8  value;
+} PpuWrite;
+
+typedef struct {
+    u64  frame_start; // Time LY 0 of the current frame started (LCD on)
+    u64  time;        // io.ly / io.stat are up to date as of this time
+    bool stat_line;   // OR of the enabled STAT sources, INT_LCD fires on its rising edge
+
+    // Tile cache: every tile of 0x8000 - 0x97FF as one palette index (0-3)
+    // per pixel, row after row. A write re-decodes the row it changed
+    // (ppu_vram_write()), renderers never touch the bit planes
+    u8   tiles[PPU_TILES][64];
+
+    // Output: one shade (0 = white - 3 = black, after the palettes) per pixel
+    u8   framebuffer[PPU_HEIGHT][PPU_WIDTH];
+    u64  frames;        // Frames whose last line was drawn
+    u8   window_line;   // Window row to draw next, advances only on lines showing it
+    bool window_active; // LY matched WY this frame
+
+    const PpuRenderer *renderer; // ppu_renderer_auto after ppu_init()
+
+    // Writes made during mode 3 of line log_line, and the registers before the first
+    PpuWrite log[PPU_LOG_WRITES];
+    u8       log_count;
+    u8       log_line;
+    PpuRegs  log_regs;
+    u16      draw_cycles; // Mode 3 length of the last line the FIFO drew
+} PPU;
+
+void ppu_init(struct GameBoy *gb);
+
+// Bring LY / STAT up to `now`
+void ppu_sync(struct GameBoy *gb, u64 now);
+
+// LCDC / STAT / LYC writes (the other LCD registers are plain storage)
+void ppu_write(struct GameBoy *gb, u16 addr, u8 value);
+
+// VRAM writes (0x8000 - 0x9FFF), keeps the tile cache in step
+void ppu_vram_write(struct GameBoy *gb, u16 addr, u8 value);
+
+// Log a write to LCD register `addr` made at ppu.time, before it is stored
+// (only rendering registers written during mode 3 are kept)
+void ppu_log_write(struct GameBoy *gb, u16 addr, u8 value);
+
+// Draw visible line `ly` into the framebuffer: background, window and
+// sprites from the current registers / VRAM / OAM (ppu_render.c)
+void ppu_render_line(struct GameBoy *gb, u8 ly);
+
+// Same, dot by dot from the registers at the start of mode 3, replaying the
+// line's logged writes (ppu_fifo.c)
+void ppu_fifo_render_line(struct GameBoy *gb, u8 ly);
+
+// Renderer called `name` ("scanline", "fifo", "auto"), NULL if there is none
+const PpuRenderer *ppu_renderer_find(const char *name);
+
+// First time after `time` at which LY / STAT (`addr`) changes, EVENT_NEVER with the LCD off
+u64  ppu_next_change(const struct GameBoy *gb, u16 addr, u64 time);
+
+void ppu_event(struct GameBoy *gb, u64 when); // EVENT_PPU handler
+
+#endif // !PPU_H
@@ -0,0 +1,43 @@
+// include/core/timer.h
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <core/utils.h>
+
+// ---------------------------------------------
+// Timer (DIV / TIMA / TMA / TAC)
+// https://gbdev.io/pandocs/Timer_and_Divider_Registers.html
+//
+// Nothing ticks: DIV is the upper byte of a 16-bit system counter that
+// runs at the CPU clock, computed from the cycle count when read. TIMA
+// counts the falling edges of the counter bit selected by TAC; it is
+// brought up to date (timer_sync()) before a timer register is accessed,
+// and its overflow is an EVENT_TIMER deadline. With the timer disabled no event is queued.
+// ---------------------------------------------
+#define TIMER_DIV_RESET 0xABCC // System counter when the boot ROM hands over (DMG)
+#define TIMER_RELOAD    4      // Cycles TIMA reads 0 after an overflow, before TMA & the IRQ
+
+struct GameBoy;
+
+typedef struct {
+    u64 div_base; // Time the system counter was 0 (counter = now - div_base)
+    u64 time;     // io.tima is up to date as of this time
+    u64 reload;   // Time of the pending TMA reload / interrupt, EVENT_NEVER = none
+} Timer;
+
+void timer_init(struct GameBoy *gb);
+
+// Bring TIMA up to `now`
+void timer_sync(struct GameBoy *gb, u64 now);
+
+// Register access (0xFF04 - 0xFF07), as of the last timer_sync()
+u8   timer_read(struct GameBoy *gb, u16 addr);
+void timer_write(struct GameBoy *gb, u16 addr, u8 value);
+
+// First time after `time` at which DIV / TIMA (`addr`) changes on its own
+u64  timer_next_change(const struct GameBoy *gb, u16 addr, u64 time);
+
+void timer_reset_div(struct GameBoy *gb);          // DIV write, STOP
+void timer_overflow(struct GameBoy *gb, u64 when); // EVENT_TIMER handler
+
+#endif // !TIMER_H
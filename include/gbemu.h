@@ -3,7 +3,10 @@
 #define GBEMU_H
 
 #include <core/cpu/cpu.h>
+#include <core/cpu/cpu_block.h>
 #include <core/cartridge.h>
+#include <core/ppu.h>
+#include <core/timer.h>
 #include <core/utils.h>
 
 // ---------------------------------------------
@@ -19,7 +22,7 @@ typedef struct {
     u8 sc; // 0xFF02 - Serial Control
 
     // Timer & Divider (0xFF04 - 0xFF07)
-    u8 div;  // 0xFF04 - Divider (auto-increments @ 16384 Hz)
+    // DIV is derived from the cycle count, see timer.h
     u8 tima; // 0xFF05 - Timer Counter
     u8 tma;  // 0xFF06 - Timer Modulo
     u8 tac;  // 0xFF07 - Timer Control
@@ -32,6 +35,7 @@ typedef struct {
     u8 sound[0x17]; // Sound registers (stubbed for now)
 
     // LCD (0xFF40 - 0xFF48)
+    // LY and the STAT mode bits are caught up on access, see ppu.h
     u8 lcdc; // 0xFF40 - LCD Control
     u8 stat; // 0xFF41 - LCD Status
     u8 scy;  // 0xFF42 - Scroll Y
@@ -49,28 +53,87 @@ typedef struct {
     u8 boot; // 0xFF50 - Boot ROM disable flag
 } IORegisters;
 
+// ---------------------------------------------
+// Interrupt sources: bit in IE / IF, in priority order
+// ---------------------------------------------
+typedef enum {
+    INT_VBLANK, // Vector 0x40
+    INT_LCD,    // Vector 0x48
+    INT_TIMER,  // Vector 0x50
+    INT_SERIAL, // Vector 0x58
+    INT_JOYPAD, // Vector 0x60
+} Interrupt;
+
+// ---------------------------------------------
+// Event Scheduler
+// Future events keyed on the absolute cycle count (gb->cycles), kept in a
+// binary min-heap with one slot per event type: scheduling, rescheduling
+// and cancelling are O(log n) and never allocate. gb_run() lets the CPU
+// run straight through to the earliest deadline, then fires what is due.
+// ---------------------------------------------
+typedef enum {
+    EVENT_SERIAL, // Serial transfer complete
+    EVENT_TIMER,  // TIMA overflow
+    EVENT_PPU,    // Next PPU mode change
+    EVENT_DMA,    // OAM DMA transfer complete
+    EVENT_SAVE,   // Write back the battery save
+    EVENT_COUNT,
+} EventType;
+
+#define EVENT_NEVER      UINT64_MAX
+#define EVENT_NOT_QUEUED 0xFF
+
+struct GameBoy;
+
+// Called once gb->cycles reached `when` (the deadline it was scheduled for;
+// the CPU may have run past it by the length of an instruction / block)
+typedef void (*EventHandler)(struct GameBoy *gb, u64 when);
+
+typedef struct {
+    u64          when[EVENT_COUNT];     // Deadline per event type
+    EventHandler handlers[EVENT_COUNT]; // Registered by the components
+    u8           heap[EVENT_COUNT];     // Pending event types, earliest first
+    u8           index[EVENT_COUNT];    // Position in heap[], EVENT_NOT_QUEUED = idle
+    u8           count;                 // Pending events
+} Scheduler;
+
 // ---------------------------------------------
 // Main GameBoy Struct
 // ---------------------------------------------
 typedef struct GameBoy {
     // Components will be added as they are implemented.
-    CPU         cpu;
-    Cartridge   cart;
+    CPU           cpu;
+    Cartridge     cart;
 
     // Memory
     // https://gbdev.io/pandocs/Memory_Map.html#memory-map
-    u8          vram[0x2000]; // Video RAM - 8 KB (0x8000 - 0x9FFF)
-    u8          wram[0x2000]; // Work RAM - 8 KB (0xC000 - 0xDFFF)
-    u8          oam[0xA0];    // Object Attribute Memory - 160 B (0xFE00 - 0xFE9E)
-    u8          hram[0x7F];   // High RAM - 127 B (0xFF88 - 0xFFFE)
+    u8            vram[0x2000]; // Video RAM - 8 KB (0x8000 - 0x9FFF)
+    u8            wram[0x2000]; // Work RAM - 8 KB (0xC000 - 0xDFFF)
+    u8            oam[0xA0];    // Object Attribute Memory - 160 B (0xFE00 - 0xFE9E)
+    u8            hram[0x7F];   // High RAM - 127 B (0xFF88 - 0xFFFE)
+
+    // Memory map: host pointer per 256-byte page, NULL = slow path (see bus.c)
+    const u8     *read_map[0x100];
+    u8           *write_map[0x100];
+    bool          dma_active; // OAM DMA running: the CPU only reaches 0xFF00 - 0xFFFF
+
+    // Decoded basic blocks (see cpu_block.h)
+    CpuBlockCache blocks;
 
     // I/O Registers
-    IORegisters io;
-    u8          ie_register; // Interrupt Enable Register (0xFFFF)
+    IORegisters   io;
+    u8            ie_register; // Interrupt Enable Register (0xFFFF)
+
+    // Components
+    Timer         timer;
+    PPU           ppu;
+
+    // Future events (see Scheduler)
+    Scheduler     events;
 
     // System state
-    u64         cycles;
-    bool        running;
+    u64           cycles;
+    bool          running;
 } GameBoy;
 
 // ---------------------------------------------
@@ -79,12 +142,37 @@ typedef struct GameBoy {
 void gb_init(GameBoy *gb);
 void gb_load_rom(GameBoy *gb, const char *path);
 void gb_step(GameBoy *gb);
+void gb_run(GameBoy *gb, u64 cycles); // Run at least `cycles`, firing events as they come due
 void gb_run_frame(GameBoy *gb);
 
+// Set the IF bit of `interrupt` (components raising an interrupt)
+void gb_request_interrupt(GameBoy *gb, Interrupt interrupt);
+
+// ---------------------------------------------
+// Event Scheduler Functions
+// ---------------------------------------------
+void gb_set_event_handler(GameBoy *gb, EventType type, EventHandler handler);
+void gb_schedule_event(GameBoy *gb, EventType type, u64 when); // (Re)schedule at absolute `when`
+void gb_cancel_event(GameBoy *gb, EventType type);
+void gb_run_events(GameBoy *gb); // Fire every event due at gb->cycles
+
+// Current time: gb->cycles is only written back when cpu_run() returns, the
+// engines publish how far into the run they are before every instruction
+static inline u64 gb_now(const GameBoy *gb) {
+    return gb->cycles + gb->cpu.run_cycles;
+}
+
+// Earliest deadline, EVENT_NEVER if nothing is pending
+static inline u64 gb_next_event(const GameBoy *gb) {
+    return (gb->events.count > 0) ? gb->events.when[gb->events.heap[0]] : EVENT_NEVER;
+}
+
 // ---------------------------------------------
 // I/O Handlers (called by MMU)
 // ---------------------------------------------
 u8   io_read(GameBoy *gb, u16 addr);
 void io_write(GameBoy *gb, u16 addr, u8 value);
+void io_serial_complete(GameBoy *gb, u64 when); // EVENT_SERIAL handler
+void io_dma_complete(GameBoy *gb, u64 when);    // EVENT_DMA handler
 
 #endif // !GBEMU_H
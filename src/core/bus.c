@@ -1,6 +1,9 @@
+// src/core/bus.c
+#include <core/bus.h>
 #include <core/utils.h>
 #include <gbemu.h>
 #include <stdio.h>
+#include <string.h>
 
 /*
 Memory Map:
@@ -23,26 +26,243 @@ https://gbdev.io/pandocs/Memory_Map.html#memory-map
 0xFFFF          : Interrupt Enable Register (IE)
 */
 
-// Read one byte from memory
-u8 mmu_read(GameBoy *gb, u16 addr) {
+#define SERIAL_TRANSFER_CYCLES 4096  // 8 bits at 8192 Hz (internal clock)
+#define OAM_DMA_CYCLES         640   // 160 bytes, one per M-cycle
+#define SAVE_FLUSH_CYCLES      70224 // Battery RAM written back one frame after the first write
+
+// ============================================================================
+// NOTE: Page Table
+// gb->read_map / gb->write_map hold one host pointer per 256-byte page.
+// Pages backed by plain memory resolve to a direct pointer the first time
+// they go through the slow path. NULL pages (IO, OAM, MBC control, unmapped,
+// VRAM for writes) always take the slow path.
+// ============================================================================
+
+// ---------------------------------------------
+// Cartridge banks
+// Without a controller ROM / RAM map linearly, and may be shorter than the
+// address range. With one, the MBC's bank pointers always have a whole
+// bank behind them (see mbc.h)
+// ---------------------------------------------
+
+// Host pointer to ROM `addr` with `len` bytes behind it, NULL = open bus
+static const u8 *cart_rom_ptr(const Cartridge *cart, u16 addr, size_t len) {
+    const Mbc *mbc = &cart->mbc;
+
+    if (mbc->type == MBC_NONE) {
+        if (cart->rom == NULL || addr + len > cart->rom_size)
+            return NULL;
+        return cart->rom + addr;
+    }
+
+    const u8 *bank = (addr < 0x4000) ? mbc->rom_bank0_ptr : mbc->rom_bank_ptr;
+    return (bank != NULL) ? bank + (addr & 0x3FFF) : NULL;
+}
+
+// Host pointer to external RAM `addr` with `len` bytes behind it
+// NULL = handled by the MBC (disabled, RTC, MBC2 nibbles) or unmapped
+static u8 *cart_ram_ptr(Cartridge *cart, u16 addr, size_t len, bool write) {
+    const Mbc *mbc    = &cart->mbc;
+    u16        offset = addr - 0xA000;
+
+    if (mbc->type == MBC_NONE) {
+        if (cart->ram == NULL || offset + len > cart->ram_size)
+            return NULL;
+        return cart->ram + offset;
+    }
+
+    if (mbc->ram_bank_ptr == NULL || (write && mbc->type == MBC_2))
+        return NULL;
+    return mbc->ram_bank_ptr + (offset & mbc->ram_mask);
+}
+
+// ---------------------------------------------
+// Battery save dirty tracking
+// Pages of a clean .sav mapping are kept off the write map: the first write
+// after a flush takes the slow path, marks the save dirty and schedules the
+// flush, later ones are plain stores until EVENT_SAVE drops the pages again
+// ---------------------------------------------
+static void save_touch(GameBoy *gb) {
+    if (gb->cart.save == NULL || gb->cart.save_dirty)
+        return;
+    gb->cart.save_dirty = true;
+    gb_schedule_event(gb, EVENT_SAVE, gb_now(gb) + SAVE_FLUSH_CYCLES);
+}
+
+void mmu_save_flush(GameBoy *gb, u64 when) {
+    (void)when;
+    cart_flush_save(&gb->cart, gb_now(gb));
+    memset(&gb->write_map[0xA0], 0, 0x20 * sizeof(gb->write_map[0]));
+}
+
+// Host pointer backing a whole 256-byte page, or NULL if the page needs a handler
+static u8 *mmu_page_ptr(GameBoy *gb, u8 page, bool write) {
+    u16 addr = page << 8;
+
+    // ROM (writes are MBC control)
+    if (addr < 0x8000) {
+        if (write)
+            return NULL;
+        return (u8 *)cart_rom_ptr(&gb->cart, addr, 0x100);
+    }
+
+    // VRAM (writes go through the PPU: tile cache & rendering, see ppu.h)
+    if (addr < 0xA000)
+        return write ? NULL : gb->vram + (addr - 0x8000);
+
+    // External RAM
+    if (addr < 0xC000)
+        return cart_ram_ptr(&gb->cart, addr, 0x100, write);
+
+    // WRAM & Echo RAM
+    if (addr < 0xE000)
+        return gb->wram + (addr - 0xC000);
+    if (addr < 0xFE00)
+        return gb->wram + (addr - 0xE000);
+
+    // OAM, unusable, IO, HRAM & IE
+    return NULL;
+}
+
+// Forget the cached pointers of pages [first_page, last_page]
+// Must be called whenever the memory behind those pages changes
+// (bank switch, boot ROM unmapping, cartridge load)
+void mmu_map_invalidate(GameBoy *gb, u8 first_page, u8 last_page) {
+    size_t count = (size_t)(last_page - first_page) + 1;
+    memset(&gb->read_map[first_page], 0, count * sizeof(gb->read_map[0]));
+    memset(&gb->write_map[first_page], 0, count * sizeof(gb->write_map[0]));
+
+    // The fetch window & the running block may point into one of those pages
+    gb->cpu.fetch_len = 0;
+    gb->blocks.stale  = true;
+}
+
+// ============================================================================
+// NOTE: Instruction Fetch Window
+// ============================================================================
+
+// Point the fetch window at the plain-memory region containing `addr`
+// Regions without a host buffer (OAM, IO, IE, missing ROM/RAM) get an empty window
+void mmu_fetch_region(GameBoy *gb, u16 addr, CPU *cpu) {
+    const u8 *base = NULL;
+    u16       lo   = 0;
+    size_t    size = 0;
+
+    if (gb->dma_active && addr < 0xFF00) {
+        // OAM DMA owns the bus: no window, fetches read 0xFF
+    } else if (addr < 0x8000 && gb->cart.mbc.type != MBC_NONE) {
+        // ROM Bank 0 / N: the banks the MBC has mapped
+        lo   = addr & 0x4000;
+        base = cart_rom_ptr(&gb->cart, lo, MBC_ROM_BANK_SIZE);
+        size = MBC_ROM_BANK_SIZE;
+    } else if (addr < 0x4000) {
+        // ROM Bank 0
+        base = gb->cart.rom;
+        size = gb->cart.rom_size;
+    } else if (addr < 0x8000) {
+        // ROM Bank N
+        lo = 0x4000;
+        if (gb->cart.rom_size > 0x4000) {
+            base = gb->cart.rom + 0x4000;
+            size = gb->cart.rom_size - 0x4000;
+        }
+    } else if (addr < 0xA000) {
+        base = gb->vram;
+        lo   = 0x8000;
+        size = sizeof(gb->vram);
+    } else if (addr < 0xC000) {
+        // External RAM: the current bank (code in RAM rarely spans banks)
+        lo   = 0xA000;
+        base = cart_ram_ptr(&gb->cart, lo, 1, false);
+        size = (gb->cart.mbc.type == MBC_NONE) ? gb->cart.ram_size : gb->cart.mbc.ram_mask + 1u;
+    } else if (addr < 0xE000) {
+        base = gb->wram;
+        lo   = 0xC000;
+        size = sizeof(gb->wram);
+    } else if (addr < 0xFE00) {
+        base = gb->wram; // Echo RAM
+        lo   = 0xE000;
+        size = 0xFE00 - 0xE000;
+    } else if (addr >= 0xFF80 && addr < 0xFFFF) {
+        base = gb->hram;
+        lo   = 0xFF80;
+        size = sizeof(gb->hram);
+    }
+
+    if (base == NULL)
+        size = 0;
+    if (size > 0x4000)
+        size = 0x4000; // A window never spans more than one bank
+
+    cpu->fetch_ptr = base;
+    cpu->fetch_lo  = lo;
+    cpu->fetch_len = (u16)size;
+}
+
+u8 mmu_fetch8_slow(CPU *cpu) {
+    u16 pc = cpu->pc++;
+
+    mmu_fetch_region(cpu->gb, pc, cpu);
+
+    u16 offset = pc - cpu->fetch_lo;
+    if (offset < cpu->fetch_len)
+        return cpu->fetch_ptr[offset];
+    return mmu_read(cpu->gb, pc); // No window (IO, OAM, ...)
+}
+
+// ============================================================================
+// NOTE: Idle Loop Polling
+// ============================================================================
+
+// Memory only changes through CPU writes, DMA and the IO registers through
+// their event handlers, except for the counters that tick on their own
+u64 mmu_poll_deadline(GameBoy *gb, u16 addr, u64 time) {
+    if (addr < 0xFF00 || addr >= 0xFF80)
+        return EVENT_NEVER; // ROM, RAM, OAM, HRAM, IE
+
+    if (addr == 0xFF04 || addr == 0xFF05)
+        return timer_next_change(gb, addr, time); // DIV, TIMA
+    if (addr == 0xFF41 || addr == 0xFF44)
+        return ppu_next_change(gb, addr, time); // STAT, LY
+    if (addr >= 0xFF10 && addr < 0xFF40)
+        return time; // Sound (channel status, wave RAM)
+    return EVENT_NEVER;
+}
+
+// ============================================================================
+// NOTE: Memory Access
+// ============================================================================
+
+// Read one byte from memory without the page table
+u8 mmu_read_slow(GameBoy *gb, u16 addr) {
+    // ---------------------------
+    // HRAM 0xFF80 - 0xFFFE
+    // Shares page 0xFF with IO, so it never gets a map entry
+    // ---------------------------
+    if (addr >= 0xFF80 && addr < 0xFFFF)
+        return gb->hram[addr - 0xFF80];
+
+    // ---------------------------
+    // OAM DMA in progress: the CPU only reaches 0xFF00 - 0xFFFF
     // ---------------------------
-    // ROM Bank 0 (0x0000 - 0x3FFF) - Fixed
+    if (gb->dma_active && addr < 0xFF00)
+        return 0xFF;
+
+    // ---------------------------
+    // Plain memory: map the page, next access takes the fast path
     // ---------------------------
-    if (addr < 0x4000) {
-        if (addr < gb->cart.rom_size)
-            return gb->cart.rom[addr];
-        return 0xFF; // Open bus
+    u8 *page = mmu_page_ptr(gb, addr >> 8, false);
+    if (page != NULL) {
+        gb->read_map[addr >> 8] = page;
+        return page[addr & 0xFF];
     }
 
     // ---------------------------
-    // ROM Bank N (0x4000 - 0x7FFF) - Switchable
+    // ROM (0x0000 - 0x7FFF) - Bank 0 & the bank selected through the MBC
     // ---------------------------
     if (addr < 0x8000) {
-        // For now, just read from ROM directly
-        // TODO: MBC will handle bank switching
-        if (addr < gb->cart.rom_size)
-            return gb->cart.rom[addr];
-        return 0xFF;
+        const u8 *rom = cart_rom_ptr(&gb->cart, addr, 1);
+        return (rom != NULL) ? *rom : 0xFF; // Open bus
     }
 
     // ---------------------------
@@ -58,12 +278,8 @@ u8 mmu_read(GameBoy *gb, u16 addr) {
     // External RAM (0xA000 - 0xBFFF) - Cartridge RAM
     // ---------------------------
     if (addr < 0xC000) {
-        // TODO: Implement with MBC (bank switching, enalbe/disable)
-        // For now, direct access if RAM exists
-        u16 ram_addr = addr - 0xA000;
-        if (ram_addr < gb->cart.ram_size)
-            return gb->cart.ram[ram_addr];
-        return 0xFF;
+        const u8 *ram = cart_ram_ptr(&gb->cart, addr, 1, false);
+        return (ram != NULL) ? *ram : mbc_read_ram(&gb->cart, addr);
     }
 
     // ---------------------------
@@ -121,15 +337,56 @@ u8 mmu_read(GameBoy *gb, u16 addr) {
     return 0xFF; // Open Bus
 }
 
-// Write one Byte to memory
-void mmu_write(GameBoy *gb, u16 addr, u8 value) {
+// Write one byte to memory without the page table
+void mmu_write_slow(GameBoy *gb, u16 addr, u8 value) {
+    // ---------------------------
+    // Code pages are kept off the write map (see cpu_block.h)
+    // ---------------------------
+    if (cpu_block_covers(&gb->blocks, addr))
+        cpu_block_invalidate(&gb->blocks, addr);
+
+    // ---------------------------
+    // HRAM 0xFF80 - 0xFFFE
+    // ---------------------------
+    if (addr >= 0xFF80 && addr < 0xFFFF) {
+        gb->hram[addr - 0xFF80] = value;
+        return;
+    }
+
+    // ---------------------------
+    // OAM DMA in progress: the CPU only reaches 0xFF00 - 0xFFFF
+    // ---------------------------
+    if (gb->dma_active && addr < 0xFF00)
+        return;
+
+    // ---------------------------
+    // Plain memory: map the page, next access takes the fast path
+    // ---------------------------
+    u8 *page = mmu_page_ptr(gb, addr >> 8, true);
+    if (page != NULL) {
+        if (addr >= 0xA000 && addr < 0xC000)
+            save_touch(gb);
+        gb->write_map[addr >> 8] = page;
+        page[addr & 0xFF]        = value;
+        return;
+    }
+
     // ---------------------------
     // ROM (0x0000 - 0x7FFF) - MBC Control
+    // A bank switch drops the page table entries of the regions it remapped
     // ---------------------------
     if (addr < 0x8000) {
-        // TODO: Implement when MBC is ready
-        // Writes to ROM control MBC (bank switching, RAM enable, etc)
-        // Ignore writes to ROM for now
+        u8 changed = mbc_write(&gb->cart, addr, value, gb_now(gb));
+        if (changed & MBC_MAP_ROM0)
+            mmu_map_invalidate(gb, 0x00, 0x3F);
+        if (changed & MBC_MAP_ROMN)
+            mmu_map_invalidate(gb, 0x40, 0x7F);
+        if (changed & MBC_MAP_RAM)
+            mmu_map_invalidate(gb, 0xA0, 0xBF);
+
+        // A game latching the clock: save it with the next flush
+        if (addr >= 0x6000 && gb->cart.save_size > gb->cart.ram_size)
+            save_touch(gb);
         return;
     }
 
@@ -138,7 +395,7 @@ void mmu_write(GameBoy *gb, u16 addr, u8 value) {
     // ---------------------------
     if (addr < 0xA000) {
         // TODO: Check if VRAM is accessible (not during PPU mode 3)
-        gb->vram[addr - 0x8000] = value;
+        ppu_vram_write(gb, addr, value);
         return;
     }
 
@@ -146,11 +403,12 @@ void mmu_write(GameBoy *gb, u16 addr, u8 value) {
     // External RAM (0xA000 - 0xBFFF) - Cartridge RAM
     // ---------------------------
     if (addr < 0xC000) {
-        // TODO: Implement with MBC (check if RAM is enabled)
-        u16 ram_addr = addr - 0xA000;
-        if (ram_addr < gb->cart.ram_size) {
-            gb->cart.ram[ram_addr] = value;
-        }
+        u8 *ram = cart_ram_ptr(&gb->cart, addr, 1, true);
+        if (ram != NULL)
+            *ram = value;
+        else
+            mbc_write_ram(&gb->cart, addr, value, gb_now(gb));
+        save_touch(gb);
         return;
     }
 
@@ -176,6 +434,7 @@ void mmu_write(GameBoy *gb, u16 addr, u8 value) {
     // ---------------------------
     if (addr < 0xFEA0) {
         // TODO: Check if OAM is accessible (not during PPU mode 2/3)
+        ppu_sync(gb, gb_now(gb));
         gb->oam[addr - 0xFE00] = value;
         return;
     }
@@ -209,11 +468,58 @@ void mmu_write(GameBoy *gb, u16 addr, u8 value) {
     // ---------------------------
     if (addr == 0xFFFF) {
         gb->ie_register = value;
+        cpu_irq_update(&gb->cpu); // May unmask a pending interrupt
+    }
+}
+
+// ============================================================================
+// NOTE: OAM DMA
+// The 160 bytes are copied into OAM up front, one memcpy() when the source
+// page is plain memory. The transfer time is a busy window ending with
+// EVENT_DMA: until then the CPU only reaches IO, HRAM and IE, so it can't
+// tell the copy from one byte per M-cycle. The page table is emptied for
+// the window, every other access lands in the slow paths above.
+// ============================================================================
+static void io_dma_start(GameBoy *gb, u8 page) {
+    gb->dma_active = false; // A restart reads the new source normally
+
+    const u8 *src = mmu_page_ptr(gb, page, false);
+    if (src != NULL) {
+        memcpy(gb->oam, src, sizeof(gb->oam));
+    } else {
+        for (u16 i = 0; i < sizeof(gb->oam); i++)
+            gb->oam[i] = mmu_read_slow(gb, (page << 8) | i);
     }
+
+    gb->dma_active = true;
+    mmu_map_invalidate(gb, 0x00, 0xFE);
+    gb_schedule_event(gb, EVENT_DMA, gb_now(gb) + OAM_DMA_CYCLES);
+}
+
+// EVENT_DMA: the bus is free again, pages are re-mapped on their next access
+void io_dma_complete(GameBoy *gb, u64 when) {
+    (void)when;
+    gb->dma_active = false;
+}
+
+// ============================================================================
+// NOTE: I/O Registers
+// Components are not stepped with the CPU: each one records the time it was
+// last brought up to and catches up only when one of its registers is
+// accessed (or its next event fires)
+// ============================================================================
+
+// Bring the component behind `addr` up to the current time
+static void io_sync(GameBoy *gb, u16 addr) {
+    if (addr >= 0xFF04 && addr <= 0xFF07)
+        timer_sync(gb, gb_now(gb));
+    else if (addr >= 0xFF40 && addr <= 0xFF4B)
+        ppu_sync(gb, gb_now(gb));
 }
 
-// I/O Register handlers
 u8 io_read(GameBoy *gb, u16 addr) {
+    io_sync(gb, addr);
+
     switch (addr) {
         // Joypad
         case 0xFF00:
@@ -227,13 +533,10 @@ u8 io_read(GameBoy *gb, u16 addr) {
 
         // Timer
         case 0xFF04:
-            return gb->io.div;
         case 0xFF05:
-            return gb->io.tima;
         case 0xFF06:
-            return gb->io.tma;
         case 0xFF07:
-            return gb->io.tac;
+            return timer_read(gb, addr);
 
         // Interrupt Flag (upper 3 bits always 1)
         case 0xFF0F:
@@ -280,6 +583,10 @@ u8 io_read(GameBoy *gb, u16 addr) {
 }
 
 void io_write(GameBoy *gb, u16 addr, u8 value) {
+    io_sync(gb, addr);
+    if (addr >= 0xFF40 && addr <= 0xFF4B)
+        ppu_log_write(gb, addr, value); // Mid-line changes, replayed by the FIFO renderer
+
     switch (addr) {
         // Joypad (bits 4-5 writable)
         case 0xFF00:
@@ -295,28 +602,27 @@ void io_write(GameBoy *gb, u16 addr, u8 value) {
             if (CHECK_BIT(value, 7)) {
                 putchar(gb->io.sb);
                 fflush(stdout);
-                gb->io.sc     = CLEAR_BIT(gb->io.sc, 7);
-                gb->io.if_reg = SET_BIT(gb->io.if_reg, 3);
+                // Internal clock: 8 bits at 8192 Hz. External clock: no link
+                // partner is connected, so the transfer never completes
+                if (CHECK_BIT(value, 0))
+                    gb_schedule_event(gb, EVENT_SERIAL, gb_now(gb) + SERIAL_TRANSFER_CYCLES);
+                else
+                    gb_cancel_event(gb, EVENT_SERIAL);
             }
             break;
 
         // Timer
         case 0xFF04:
-            gb->io.div = 0; // Any write resets to 0
-            break;
         case 0xFF05:
-            gb->io.tima = value;
-            break;
         case 0xFF06:
-            gb->io.tma = value;
-            break;
         case 0xFF07:
-            gb->io.tac = MASK_BITS(value, 0x07);
+            timer_write(gb, addr, value);
             break;
 
         // Interrupt Flag (only lower 5 bits writable)
         case 0xFF0F:
             gb->io.if_reg = MASK_BITS(value, 0x1F);
+            cpu_irq_update(&gb->cpu); // May raise a pending interrupt
             break;
 
         // Sound (NOTE: stubbed)
@@ -326,10 +632,8 @@ void io_write(GameBoy *gb, u16 addr, u8 value) {
 
         // LCD
         case 0xFF40:
-            gb->io.lcdc = value;
-            break;
         case 0xFF41:
-            gb->io.stat = REPLACE_BITS(gb->io.stat, value, 0x78); // Bits 3-6 writable
+            ppu_write(gb, addr, value);
             break;
         case 0xFF42:
             gb->io.scy = value;
@@ -340,16 +644,12 @@ void io_write(GameBoy *gb, u16 addr, u8 value) {
         case 0xFF44:
             break; // Read-only
         case 0xFF45:
-            gb->io.lyc = value;
+            ppu_write(gb, addr, value);
             break;
-        case 0xFF46: {
+        case 0xFF46:
             gb->io.dma = value;
-            u16 src    = value << 8;
-            for (int i = 0; i < 0xA0; i++) {
-                gb->oam[i] = mmu_read(gb, src + i);
-            }
+            io_dma_start(gb, value);
             break;
-        }
         case 0xFF47:
             gb->io.bgp = value;
             break;
@@ -369,6 +669,7 @@ void io_write(GameBoy *gb, u16 addr, u8 value) {
         // Boot ROM
         case 0xFF50:
             gb->io.boot = value;
+            mmu_map_invalidate(gb, 0x00, 0x00); // Boot ROM overlay unmapped
             break;
 
         default:
@@ -376,6 +677,13 @@ void io_write(GameBoy *gb, u16 addr, u8 value) {
     }
 }
 
+// EVENT_SERIAL: the byte in SB has been shifted out
+void io_serial_complete(GameBoy *gb, u64 when) {
+    (void)when;
+    gb->io.sc = CLEAR_BIT(gb->io.sc, 7);
+    gb_request_interrupt(gb, INT_SERIAL);
+}
+
 // Debug Helper: Dump Memory Region
 void mmu_dump_region(GameBoy *gb, u16 start, u16 end) {
     printf("Memory Dump [0x%04x - 0x%04x]:\n", start, end);
@@ -1,56 +1,299 @@
 // src/core/cartridge.c
 #include <stdio.h>
 #include <core/cartridge.h>
+#include <fcntl.h>
+#include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 /*
 EXIT CODES
 return 1; -->  failed to open
 return 2; -->  too small
-return 3; -->  malloc ROM failed
-return 4; -->  malloc RAM failed
-return 5; -->  fread failed
+return 3; -->  mmap ROM failed
+return 4; -->  malloc RAM failed (a .sav that can't be mapped falls back to malloc)
 return -1; --> cart header checksum failed
 */
 
-// Load ROM from disk & parse header
-int cart_load(Cartridge *cart, const char *path) {
-    // Open the ROM file
-    FILE *rom_f = fopen(path, "rb");
-    if (!rom_f) {
+// ============================================================================
+// NOTE: ROM Registry
+// Every Cartridge loading the same file shares one read-only MAP_PRIVATE
+// mapping of it, keyed on the file identity (device, inode, size, mtime)
+// and reference counted. The mapping is padded with 0xFF to a power-of-two
+// number of 16 KiB banks, so the MBC bank masks never reach past it; only
+// the padding pages take memory, once per file.
+// ============================================================================
+struct RomMapping {
+    dev_t              dev;
+    ino_t              ino;
+    off_t              file_size;
+    time_t             mtime;
+    u8                *data;
+    size_t             size; // Padded
+    u32                refs;
+    struct RomMapping *next;
+};
+
+static RomMapping     *rom_registry      = NULL;
+static pthread_mutex_t rom_registry_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Power-of-two number of banks holding `file_size`, at least the 32 KiB of 0x0000 - 0x7FFF
+size_t cart_padded_rom_size(size_t file_size) {
+    size_t size = 0x8000;
+    while (size < file_size)
+        size *= 2;
+    return size;
+}
+
+// Map `file_size` bytes of `fd` at the start of `size` bytes of 0xFF
+static u8 *rom_map_file(int fd, size_t file_size, size_t size) {
+    size_t page     = (size_t)sysconf(_SC_PAGESIZE);
+    size_t file_end = (file_size + page - 1) / page * page;
+
+    u8 *data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED)
+        return NULL;
+    if (file_end < size)
+        memset(data + file_end, 0xFF, size - file_end);
+
+    // The file over the start, the tail of its last page is copied on write
+    if (mmap(data, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) ==
+        MAP_FAILED) {
+        munmap(data, size);
+        return NULL;
+    }
+    memset(data + file_size, 0xFF, file_end - file_size);
+
+    mprotect(data, size, PROT_READ);
+    return data;
+}
+
+// Point cart->rom at the shared mapping of `path`, returns a cart_load() exit code
+static int rom_acquire(Cartridge *cart, const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
         fprintf(stderr, "Failed to open ROM: %s\n", path);
         return 1;
     }
 
-    // Get the file size
-    fseek(rom_f, 0, SEEK_END);
-    cart->rom_size = ftell(rom_f);
-    rewind(rom_f);
-
     // Actual ROM file size should be greater than 0x0150
-    if (cart->rom_size < 0x0150) {
-        fclose(rom_f);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < 0x0150) {
+        close(fd);
         fprintf(stderr, "ROM file too small\n");
         return 2;
     }
 
-    // Allocate memory for ROM from heap
-    cart->rom = malloc(cart->rom_size);
-    if (!cart->rom) {
-        fclose(rom_f);
-        fprintf(stderr, "Failed to allocate ROM memory\n");
-        return 3;
+    pthread_mutex_lock(&rom_registry_lock);
+
+    RomMapping *map = rom_registry;
+    while (map != NULL && !(map->dev == st.st_dev && map->ino == st.st_ino &&
+                            map->file_size == st.st_size && map->mtime == st.st_mtime))
+        map = map->next;
+
+    if (map == NULL) {
+        // Sizes a page bigger than a bank are padded to whole pages
+        size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        size_t size = cart_padded_rom_size((size_t)st.st_size);
+        size        = (size + page - 1) / page * page;
+
+        u8 *data    = rom_map_file(fd, (size_t)st.st_size, size);
+        map         = (data != NULL) ? malloc(sizeof(RomMapping)) : NULL;
+        if (map == NULL) {
+            if (data != NULL)
+                munmap(data, size);
+            pthread_mutex_unlock(&rom_registry_lock);
+            close(fd);
+            fprintf(stderr, "Failed to map ROM\n");
+            return 3;
+        }
+
+        map->dev       = st.st_dev;
+        map->ino       = st.st_ino;
+        map->file_size = st.st_size;
+        map->mtime     = st.st_mtime;
+        map->data      = data;
+        map->size      = size;
+        map->refs      = 0;
+        map->next      = rom_registry;
+        rom_registry   = map;
+    }
+    map->refs++;
+
+    pthread_mutex_unlock(&rom_registry_lock);
+    close(fd); // The mapping outlives the descriptor
+
+    cart->rom      = map->data;
+    cart->rom_size = map->size;
+    cart->rom_map  = map;
+    return 0;
+}
+
+// Drop a reference, unmapping the file with the last one
+static void rom_release(RomMapping *map) {
+    pthread_mutex_lock(&rom_registry_lock);
+
+    if (--map->refs == 0) {
+        RomMapping **link = &rom_registry;
+        while (*link != map)
+            link = &(*link)->next;
+        *link = map->next;
+
+        munmap(map->data, map->size);
+        free(map);
+    }
+
+    pthread_mutex_unlock(&rom_registry_lock);
+}
+
+size_t cart_rom_mappings(void) {
+    size_t count = 0;
+
+    pthread_mutex_lock(&rom_registry_lock);
+    for (const RomMapping *map = rom_registry; map != NULL; map = map->next)
+        count++;
+    pthread_mutex_unlock(&rom_registry_lock);
+    return count;
+}
+
+// ============================================================================
+// NOTE: Battery Saves
+// Battery-backed RAM is a MAP_SHARED mapping of the .sav file next to the
+// ROM, followed by the MBC3 clock (see mbc.h) on carts that have one:
+// games write straight into the page cache, nothing copies the RAM out.
+// The bus sets save_dirty on the first write after a flush (see
+// mmu_save_flush()), cart_flush_save() then only asks the kernel to start
+// writing back the dirty pages.
+// ============================================================================
+bool cart_has_battery(u8 cart_type) {
+    switch (cart_type) {
+        case 0x03: // MBC1+RAM+BATTERY
+        case 0x06: // MBC2+BATTERY
+        case 0x09: // ROM+RAM+BATTERY
+        case 0x0D: // MMM01+RAM+BATTERY
+        case 0x0F: // MBC3+TIMER+BATTERY
+        case 0x10: // MBC3+TIMER+RAM+BATTERY
+        case 0x13: // MBC3+RAM+BATTERY
+        case 0x1B: // MBC5+RAM+BATTERY
+        case 0x1E: // MBC5+RUMBLE+RAM+BATTERY
+        case 0x22: // MBC7+SENSOR+RUMBLE+RAM+BATTERY
+        case 0xFF: // HuC1+RAM+BATTERY
+            return true;
+        default:
+            return false;
+    }
+}
+
+// `rom_path` with its extension replaced by .sav (malloc()ed)
+static char *save_path(const char *rom_path) {
+    const char *slash = strrchr(rom_path, '/');
+    const char *dot   = strrchr(rom_path, '.');
+    size_t      len   = (dot != NULL && (slash == NULL || dot > slash)) ? (size_t)(dot - rom_path)
+                                                                        : strlen(rom_path);
+
+    char *path = malloc(len + sizeof(".sav"));
+    if (path != NULL) {
+        memcpy(path, rom_path, len);
+        memcpy(path + len, ".sav", sizeof(".sav"));
+    }
+    return path;
+}
+
+// MBC3 with the clock: the .sav also holds the RTC footer
+static bool cart_has_rtc(u8 cart_type) {
+    return cart_type == 0x0F || cart_type == 0x10;
+}
+
+// Map `size` bytes of the .sav of `rom_path` as cart->save, growing the file
+// if shorter (the new part reads as zeros). Returns the previous file size,
+// -1 if it can't be opened / mapped
+static off_t save_map(Cartridge *cart, const char *rom_path, size_t size) {
+    char *path = save_path(rom_path);
+    if (path == NULL)
+        return -1;
+
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "Warning: Cannot open save file %s, saves won't persist\n", path);
+        free(path);
+        return -1;
     }
+    free(path);
+
+    struct stat st;
+    void       *save = MAP_FAILED;
+    if (fstat(fd, &st) == 0 &&
+        ((size_t)st.st_size >= size || ftruncate(fd, (off_t)size) == 0))
+        save = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd); // The mapping keeps the file
 
-    // Read the ROM data from file into ROM buffer
-    size_t read = fread(cart->rom, 1, cart->rom_size, rom_f);
-    fclose(rom_f);
+    if (save == MAP_FAILED)
+        return -1;
+    cart->save      = save;
+    cart->save_size = size;
+    return st.st_size;
+}
 
-    if (read != cart->rom_size) {
-        fprintf(stderr, "Failed to read ROM\n");
-        return 5;
+bool cart_flush_save(Cartridge *cart, u64 now) {
+    if (cart->save == NULL)
+        return false;
+
+    // The clock moves without being written: refresh its footer
+    if (cart->save_size > cart->ram_size) {
+        mbc_rtc_store(cart, cart->save + cart->ram_size, now);
+        cart->save_dirty = true;
     }
+    if (!cart->save_dirty)
+        return false;
+
+    msync(cart->save, cart->save_size, MS_ASYNC);
+    cart->save_dirty = false;
+    cart->save_syncs++;
+    return true;
+}
+
+// ============================================================================
+// NOTE: Header Probe
+// Only the 0x0150 bytes up to the end of the header are read, for info mode
+// and library scans (see library.h)
+// ============================================================================
+int cart_probe_fd(int fd, RawRomHeader *raw, CartHeader *out) {
+    u8 head[0x0150];
+
+    ssize_t got = pread(fd, head, sizeof(head), 0);
+    if (got < 0)
+        return 1;
+    if ((size_t)got < sizeof(head))
+        return 2;
+
+    memcpy(raw, head + 0x0100, sizeof(RawRomHeader));
+    parse_header(raw, out);
+    return header_checksum_valid(raw) ? 0 : -1;
+}
+
+int cart_probe(const char *path, RawRomHeader *raw, CartHeader *out) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return 1;
+
+    int status = cart_probe_fd(fd, raw, out);
+    close(fd);
+    return status;
+}
+
+// ============================================================================
+// NOTE: Cartridge Loading
+// ============================================================================
+
+// Load ROM from disk & parse header
+int cart_load(Cartridge *cart, const char *path) {
+    // Map the ROM file, shared with the other cartridges using it
+    int status = rom_acquire(cart, path);
+    if (status != 0)
+        return status;
 
     // Copy raw header (located at 0x100 - 0x14F)
     memcpy(&cart->raw_header, cart->rom + 0x0100, sizeof(RawRomHeader));
@@ -67,37 +310,66 @@ int cart_load(Cartridge *cart, const char *path) {
     printf("\nCartridge header checksum: OK\n");
 
     // Allocate RAM if needed (based on ram_size_code)
+    // MBC2 has its RAM built in, the header says there is none
     cart->ram_size = get_ram_size(cart->header.ram_size_code);
-    if (cart->ram_size > 0) {
-        cart->ram = calloc(1, cart->ram_size);
-        if (!cart->ram) {
+    if (mbc_type(cart->header.cart_type) == MBC_2)
+        cart->ram_size = MBC2_RAM_SIZE;
+    // Battery-backed RAM & clock live in the .sav file (see Battery Saves)
+    bool rtc      = cart_has_rtc(cart->header.cart_type);
+    bool rtc_load = false;
+
+    cart->ram        = NULL;
+    cart->save       = NULL;
+    cart->save_size  = 0;
+    cart->save_dirty = false;
+    if (cart_has_battery(cart->header.cart_type) && (cart->ram_size > 0 || rtc)) {
+        size_t save_size = cart->ram_size + (rtc ? MBC_RTC_SAVE_SIZE : 0);
+        off_t  saved     = save_map(cart, path, save_size);
+        rtc_load         = rtc && saved >= (off_t)save_size;
+        cart->ram        = (cart->ram_size > 0) ? cart->save : NULL;
+    }
+    if (cart->ram == NULL && cart->ram_size > 0) {
+        cart->ram = calloc(1, cart->ram_size); // No battery, or the .sav can't be mapped
+        if (cart->ram == NULL) {
             fprintf(stderr, "Failed to allocate cartridge RAM\n");
-            free(cart->rom);
-            cart->rom      = NULL;
-            cart->rom_size = 0;
+            cart_unload(cart);
             return 4;
         }
-    } else {
-        cart->ram = NULL;
     }
 
+    // Map the power-on banks, restore the clock if the .sav had one
+    mbc_init(cart);
+    if (rtc_load)
+        mbc_rtc_load(cart, cart->save + cart->ram_size);
     return 0;
 }
 
-// Unload the cart: Free the allocated memory for RAM & ROM
+// Unload the cart: Drop the ROM mapping (or free a ROM set by hand), write
+// back & unmap the save / free the RAM
 void cart_unload(Cartridge *cart) {
-    if (cart->rom) {
+    if (cart->rom_map) {
+        rom_release(cart->rom_map);
+        cart->rom_map = NULL;
+    } else if (cart->rom) {
         free(cart->rom);
-        cart->rom = NULL;
     }
+    cart->rom = NULL;
 
-    if (cart->ram) {
+    if (cart->save) {
+        if (cart->save_dirty)
+            msync(cart->save, cart->save_size, MS_SYNC);
+        munmap(cart->save, cart->save_size);
+    } else if (cart->ram) {
         free(cart->ram);
-        cart->ram = NULL;
     }
+    cart->ram        = NULL;
+    cart->save       = NULL;
+    cart->save_size  = 0;
+    cart->save_dirty = false;
 
     cart->rom_size = 0;
     cart->ram_size = 0;
+    memset(&cart->mbc, 0, sizeof(cart->mbc)); // Bank pointers into the freed buffers
 }
 
 // Parse raw header into usable format
@@ -285,14 +557,18 @@ const char *get_cart_type_name(u8 type) {
 // Get header checksum
 // https://gbdev.io/pandocs/The_Cartridge_Header.html#014d--header-checksum
 bool cart_verify_header_checksum(const Cartridge *cart) {
-    const u8 *rom      = cart->rom;
+    return header_checksum_valid((const RawRomHeader *)(cart->rom + 0x0100));
+}
+
+bool header_checksum_valid(const RawRomHeader *raw) {
+    const u8 *header   = (const u8 *)raw;
 
     u8        checksum = 0;
-    for (u16 addr = 0x0134; addr <= 0x014C; addr++) {
-        checksum = checksum - rom[addr] - 1;
+    for (u16 offset = 0x34; offset <= 0x4C; offset++) {
+        checksum = checksum - header[offset] - 1;
     }
 
-    return checksum == rom[0x014D];
+    return checksum == raw->header_checksum;
 }
 
 // Get publisher name from license code
@@ -1,13 +1,17 @@
 // src/core/cpu/cpu.c
 #include <core/cpu/cpu.h>
+#include <core/cpu/cpu_alu.h>
 #include <core/bus.h>
 #include <gbemu.h>
 #include <string.h>
-#include <utils.h>
+#include <core/utils.h>
 
 void cpu_init(CPU *cpu, GameBoy *gb) {
     memset(cpu, 0, sizeof(CPU));
-    cpu->gb = gb;
+    cpu_alu_init();
+    cpu->gb         = gb;
+    cpu->dispatch   = CPU_DISPATCH_THREADED;
+    cpu->lazy_flags = true;
     cpu_reset(cpu);
 }
 
@@ -15,7 +19,7 @@ void cpu_reset(CPU *cpu) {
     // Game Boy boot sequence sets these initial values
     // https://gbdev.io/pandocs/Power_Up_Sequence.html
     cpu->regs.a = 0x01; // GB/SGB identifier
-    cpu->regs.f = 0xB0; // Flags: Z = 1, N = 0, H = 1, C = 1
+    cpu_flags_write(cpu, 0xB0); // Flags: Z = 1, N = 0, H = 1, C = 1
     cpu->regs.b = 0x00;
     cpu->regs.c = 0x13;
     cpu->regs.d = 0x00;
@@ -26,13 +30,16 @@ void cpu_reset(CPU *cpu) {
     cpu->sp     = 0xFFFE;
     cpu->pc     = 0x0100; // Start after boot ROM
 
-    cpu->ime    = false;
-    cpu->halted = false;
+    cpu->ime           = false;
+    cpu->ime_scheduled = false;
+    cpu->halted        = false;
+    cpu->stopped       = false;
+    cpu_irq_update(cpu);
 }
 
 // Register Pair Read Functions
 u16 cpu_read_af(const CPU *cpu) {
-    return MAKE_U16(cpu->regs.a, cpu->regs.f);
+    return MAKE_U16(cpu->regs.a, cpu_flags_value(cpu));
 }
 
 u16 cpu_read_bc(const CPU *cpu) {
@@ -50,7 +57,7 @@ u16 cpu_read_hl(const CPU *cpu) {
 // Register Pair Write Functions
 void cpu_write_af(CPU *cpu, u16 value) {
     cpu->regs.a = GET_HIGH_BYTE(value);
-    cpu->regs.f = GET_LOW_BYTE(value) & 0xF0; // Lower 4 bits always zero
+    cpu_flags_write(cpu, GET_LOW_BYTE(value) & 0xF0); // Lower 4 bits always zero
 }
 
 void cpu_write_bc(CPU *cpu, u16 value) {
@@ -69,37 +76,126 @@ void cpu_write_hl(CPU *cpu, u16 value) {
 }
 
 // Flag Helpers
+// Reading or modifying a single flag materializes any pending lazy op
 bool cpu_get_flag(CPU *cpu, u8 flag) {
+    cpu_flags_sync(cpu);
     return (cpu->regs.f & flag) != 0;
 }
 
 void cpu_set_flag(CPU *cpu, u8 flag) {
+    cpu_flags_sync(cpu);
     cpu->regs.f |= flag;
 }
 
 void cpu_clear_flag(CPU *cpu, u8 flag) {
+    cpu_flags_sync(cpu);
     cpu->regs.f &= ~flag;
 }
 
+void cpu_set_lazy_flags(CPU *cpu, bool enabled) {
+    cpu_flags_sync(cpu);
+    cpu->lazy_flags = enabled;
+}
+
+// ---------------------------------------------
+// HALT / STOP wake-up
+// HALT ends once an enabled interrupt is requested, whether or not IME is
+// set. STOP only ends on a joypad request (a P1 line going low)
+// ---------------------------------------------
+static bool cpu_wake(CPU *cpu) {
+    GameBoy *gb = cpu->gb;
+
+    if (cpu->stopped && CHECK_BIT(gb->io.if_reg, INT_JOYPAD))
+        cpu->stopped = false;
+    if (cpu->halted && cpu->irq_pending)
+        cpu->halted = false;
+
+    return !cpu->halted && !cpu->stopped;
+}
+
 // Main execute function
 u8 cpu_step(CPU *cpu) {
-    if (cpu->halted) {
-        // TODO: Check for interrupts here
-        // If interrupt pending, unhalt
+    // Asleep: one 4-cycle idle step
+    if (!cpu_wake(cpu))
         return 4;
+
+    // EI delay / interrupt dispatch (mirrors the dispatch prologue)
+    u8 cycles = 0;
+    if (cpu->irq_check)
+        cycles = cpu_interrupt(cpu);
+
+    // FETCH: Read OpCode at PC, increment PC
+    u8 opcode = mmu_fetch8(cpu);
+
+    // Decode & Execute
+    cycles += cpu_execute(cpu, opcode);
+
+    return cycles;
+}
+
+// Run many instructions in one go
+u32 cpu_run(CPU *cpu, u32 budget) {
+    u32 cycles;
+
+    if (!cpu_wake(cpu)) {
+        // Only a scheduled event can request the interrupt that ends the
+        // sleep: skip straight to the earliest one instead of stepping there,
+        // in the 4-cycle steps cpu_step() would have taken
+        u64 next = gb_next_event(cpu->gb);
+        if (next > cpu->gb->cycles && next - cpu->gb->cycles < budget)
+            budget = (u32)(next - cpu->gb->cycles);
+        cycles = (budget + 3) & ~3u;
+    } else {
+        cpu->run_exit = false;
+        cycles        = cpu_dispatch(cpu, budget);
     }
 
-    // Check if IME should be enabled (from previous EI)
-    if (cpu->ime_scheduled) {
+    // Single write-back of the system clock
+    cpu->gb->cycles += cycles;
+    cpu->run_cycles  = 0;
+    return cycles;
+}
+
+void cpu_request_exit(CPU *cpu) {
+    cpu->run_exit = true;
+}
+
+// ============================================================================
+// NOTE: Interrupts
+// ============================================================================
+void cpu_irq_update(CPU *cpu) {
+    GameBoy *gb      = cpu->gb;
+    u8       pending = gb->ie_register & gb->io.if_reg & 0x1F;
+
+    cpu->irq_pending = pending;
+    cpu->irq_check   = (cpu->ime ? pending : 0) | (cpu->ime_scheduled ? CPU_IRQ_EI : 0);
+
+    // Blocks and cpu_run() callers only look at the prologue between runs
+    if (cpu->ime && pending)
+        cpu->run_exit = true;
+}
+
+u8 cpu_interrupt(CPU *cpu) {
+    GameBoy *gb = cpu->gb;
+
+    // EI: IME is on from here, the instruction after EI still runs first
+    if (cpu->irq_check & CPU_IRQ_EI) {
         cpu->ime           = true;
         cpu->ime_scheduled = false;
+        cpu_irq_update(cpu);
+        return 0;
     }
 
-    // FETCH: Read OpCode at PC, increment PC
-    u8 opcode = mmu_read(cpu->gb, cpu->pc++);
+    // Lowest bit first: VBlank 0x40, LCD 0x48, Timer 0x50, Serial 0x58, Joypad 0x60
+    u8 bit = 0;
+    while (!CHECK_BIT(cpu->irq_check, bit))
+        bit++;
 
-    // Decode & Execute
-    u8 cycles = cpu_execute(cpu, opcode);
+    cpu->ime      = false;
+    gb->io.if_reg = CLEAR_BIT(gb->io.if_reg, bit);
+    cpu_irq_update(cpu);
 
-    return cycles;
+    mmu_push16(cpu, cpu->pc);
+    cpu->pc = 0x0040 + bit * 8;
+    return CPU_IRQ_CYCLES;
 }
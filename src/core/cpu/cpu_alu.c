@@ -0,0 +1,109 @@
+// src/core/cpu/cpu_alu.c
+#include <core/cpu/cpu_alu.h>
+#include <core/utils.h>
+
+#ifdef CPU_ALU_TABLES
+#include <pthread.h>
+
+// ---------------------------------------------
+// ALU tables
+// Entry = (result << 8) | flags
+// ---------------------------------------------
+u16         alu_add_table[2][256][256];
+u16         alu_sub_table[2][256][256];
+u16         alu_inc_table[256];
+u16         alu_dec_table[256];
+u16         alu_daa_table[8][256];
+
+// Shared by every instance, built once whichever thread gets there first
+static pthread_once_t alu_tables_once = PTHREAD_ONCE_INIT;
+
+// Pack a result and flags computed by the reference helpers in utils.c
+static u16 alu_entry(u8 result, u8 flags) {
+    return (u16)(result << 8) | flags;
+}
+
+static void build_add_sub_tables(void) {
+    for (int carry = 0; carry < 2; carry++) {
+        for (int a = 0; a < 256; a++) {
+            for (int b = 0; b < 256; b++) {
+                u8 sum  = (u8)(a + b + carry);
+                u8 diff = (u8)(a - b - carry);
+
+                u8 f    = (sum == 0) ? FLAG_ZERO : 0;
+                if (check_half_carry_adc(a, b, carry))
+                    f |= FLAG_HF_CARRY;
+                if (check_carry_adc(a, b, carry))
+                    f |= FLAG_CARRY;
+                alu_add_table[carry][a][b] = alu_entry(sum, f);
+
+                f = FLAG_SUBT | ((diff == 0) ? FLAG_ZERO : 0);
+                if (check_half_carry_sbc(a, b, carry))
+                    f |= FLAG_HF_CARRY;
+                if (check_carry_sbc(a, b, carry))
+                    f |= FLAG_CARRY;
+                alu_sub_table[carry][a][b] = alu_entry(diff, f);
+            }
+        }
+    }
+}
+
+static void build_inc_dec_tables(void) {
+    for (int value = 0; value < 256; value++) {
+        u8 inc = (u8)(value + 1);
+        u8 dec = (u8)(value - 1);
+
+        u8 f   = (inc == 0) ? FLAG_ZERO : 0;
+        if ((value & 0x0F) == 0x0F)
+            f |= FLAG_HF_CARRY;
+        alu_inc_table[value] = alu_entry(inc, f);
+
+        f = FLAG_SUBT | ((dec == 0) ? FLAG_ZERO : 0);
+        if ((value & 0x0F) == 0)
+            f |= FLAG_HF_CARRY;
+        alu_dec_table[value] = alu_entry(dec, f);
+    }
+}
+
+// Index = N:H:C, i.e. bits 6..4 of F
+static void build_daa_table(void) {
+    for (int nhc = 0; nhc < 8; nhc++) {
+        bool sub   = (nhc & 0x04) != 0;
+        bool half  = (nhc & 0x02) != 0;
+        bool carry = (nhc & 0x01) != 0;
+
+        for (int a = 0; a < 256; a++) {
+            u8 result = adjust_bcd(a, sub, carry, half);
+
+            u8 f      = 0;
+            if (result == 0)
+                f |= FLAG_ZERO;
+            if (sub)
+                f |= FLAG_SUBT;
+
+            // Carry is set if we corrected with 0x60
+            if ((!sub && (carry || a > 0x99)) || (sub && carry))
+                f |= FLAG_CARRY;
+
+            alu_daa_table[nhc][a] = alu_entry(result, f);
+        }
+    }
+}
+
+static void build_tables(void) {
+    build_add_sub_tables();
+    build_inc_dec_tables();
+    build_daa_table();
+}
+
+void cpu_alu_init(void) {
+    pthread_once(&alu_tables_once, build_tables);
+}
+
+#else
+
+void cpu_alu_init(void) {
+    // Arithmetic path: nothing to build
+}
+
+#endif // CPU_ALU_TABLES
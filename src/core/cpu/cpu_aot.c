@@ -0,0 +1,56 @@
+// src/core/cpu/cpu_aot.c
+#include <core/cpu/cpu_aot.h>
+#include <stddef.h>
+
+// Images linked into this executable (registered before main())
+static const CpuAotImage *aot_images[CPU_AOT_MAX_IMAGES];
+static u32                aot_count = 0;
+
+void cpu_aot_register(const CpuAotImage *image) {
+    if (aot_count < CPU_AOT_MAX_IMAGES)
+        aot_images[aot_count++] = image;
+}
+
+// Header checksums are not reliable (homebrew leaves the global one at 0),
+// so images are matched on a hash of the whole ROM
+u32 cpu_aot_rom_hash(const u8 *rom, size_t size) {
+    u32 hash = 2166136261u;
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ rom[i]) * 16777619u;
+    return hash;
+}
+
+const CpuAotImage *cpu_aot_find(const Cartridge *cart) {
+    if (cart->rom == NULL)
+        return NULL;
+
+    u32 hash = 0;
+    for (u32 i = 0; i < aot_count; i++) {
+        const CpuAotImage *image = aot_images[i];
+        if (image->rom_size != cart->rom_size)
+            continue;
+        if (hash == 0)
+            hash = cpu_aot_rom_hash(cart->rom, cart->rom_size);
+        if (image->rom_hash == hash)
+            return image;
+    }
+    return NULL;
+}
+
+CpuNativeFunc cpu_aot_lookup(const CpuAotImage *image, u32 offset) {
+    u32 lo = 0;
+    u32 hi = image->count;
+
+    // Binary search
+    while (lo < hi) {
+        u32 mid = lo + (hi - lo) / 2;
+        if (image->blocks[mid].offset < offset)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if (lo < image->count && image->blocks[lo].offset == offset)
+        return image->blocks[lo].func;
+    return NULL;
+}
@@ -0,0 +1,261 @@
+// src/core/cpu/cpu_block.c
+#include <core/cpu/cpu_block.h>
+#include <core/cpu/cpu_aot.h>
+#include <core/cpu/cpu_jit.h>
+#include <core/cpu/cpu_exec.h>
+#include <core/bus.h>
+#include <gbemu.h>
+#include <stdint.h>
+#include <string.h>
+
+// ---------------------------------------------
+// Cache slot for a block entry
+// Mixes in the bits above the bank size so the same PC in different ROM
+// banks lands in different slots
+// ---------------------------------------------
+static u32 block_slot(const u8 *ptr) {
+    uintptr_t key = (uintptr_t)ptr;
+    return (u32)(key ^ (key >> 14)) & (CPU_BLOCK_CACHE_SIZE - 1);
+}
+
+// ---------------------------------------------
+// Idle loop candidates
+// Loop bodies may only change A and F (and PC)
+// ---------------------------------------------
+
+// Instructions without memory operands that qualify
+static const bool idle_body_op[256] = {
+    [0x00] = true, // NOP
+    [0x07] = true, [0x0F] = true, [0x17] = true, [0x1F] = true, // RLCA / RRCA / RLA / RRA
+    [0x2F] = true, [0x37] = true, [0x3F] = true, // CPL / SCF / CCF
+    [0x3C] = true, [0x3D] = true, [0x3E] = true, // INC A / DEC A / LD A, n
+    [0xC6] = true, [0xCE] = true, [0xD6] = true, [0xDE] = true, // ADD / ADC / SUB / SBC A, n
+    [0xE6] = true, [0xEE] = true, [0xF6] = true, [0xFE] = true, // AND / XOR / OR / CP A, n
+};
+
+// Does the instruction at `instr` qualify? Memory reads store where their
+// address comes from in `src` / `addr`
+static bool idle_body_instr(const u8 *instr, bool *reads, u8 *src, u16 *addr) {
+    u8 opcode = instr[0];
+
+    *reads    = true;
+    *addr     = 0;
+    switch (opcode) {
+        case 0x0A: // LD A, (BC)
+            *src = CPU_IDLE_BC;
+            return true;
+        case 0x1A: // LD A, (DE)
+            *src = CPU_IDLE_DE;
+            return true;
+        case 0xF0: // LDH A, (n)
+            *src  = CPU_IDLE_ADDR;
+            *addr = 0xFF00 | instr[1];
+            return true;
+        case 0xF2: // LD A, (C)
+            *src = CPU_IDLE_C;
+            return true;
+        case 0xFA: // LD A, (nn)
+            *src  = CPU_IDLE_ADDR;
+            *addr = MAKE_U16(instr[2], instr[1]);
+            return true;
+    }
+
+    // LD A, r / ALU A, r: (HL) operands read memory
+    *src   = CPU_IDLE_HL;
+    *reads = (opcode & 0x07) == 0x06;
+    if (opcode >= 0x78 && opcode < 0xC0)
+        return true;
+
+    *reads = false;
+    return idle_body_op[opcode];
+}
+
+// Branch target of a JR / JP at `pc`, -1 for anything else
+static int idle_branch_target(const u8 *instr, u16 pc) {
+    u8 opcode = instr[0];
+
+    if (opcode == 0x18 || (opcode & 0xE7) == 0x20) // JR e / JR cc, e
+        return (u16)(pc + 2 + (i8)instr[1]);
+    if (opcode == 0xC3 || (opcode & 0xE7) == 0xC2) // JP nn / JP cc, nn
+        return MAKE_U16(instr[2], instr[1]);
+    return -1;
+}
+
+// A block that branches back to its entry through a body of idle_body_instr()
+static void block_scan_idle(CpuBlock *block, const u8 *code, u16 last) {
+    block->idle       = false;
+    block->idle_reads = 0;
+
+    if (idle_branch_target(code + last, block->pc + last) != block->pc)
+        return;
+
+    for (u16 pos = 0; pos < last; pos += cpu_instr_length(code[pos])) {
+        bool reads;
+        u8   src;
+        u16  addr;
+
+        if (!idle_body_instr(code + pos, &reads, &src, &addr))
+            return;
+        if (!reads)
+            continue;
+        if (block->idle_reads == CPU_IDLE_MAX_READS)
+            return;
+
+        block->idle_src[block->idle_reads]  = src;
+        block->idle_addr[block->idle_reads] = addr;
+        block->idle_reads++;
+    }
+    block->idle = true;
+}
+
+// ---------------------------------------------
+// Decode the block at cpu->pc into `block`
+// `code` points at the opcode, `avail` bytes are readable from there
+// without leaving the fetch window or the page
+// ---------------------------------------------
+static CpuBlock *block_decode(CPU *cpu, CpuBlock *block, const u8 *code, u16 avail) {
+    GameBoy       *gb    = cpu->gb;
+    CpuBlockCache *cache = &gb->blocks;
+    u16            pos   = 0;
+    u16            last  = 0;
+    u8             count = 0;
+
+    while (count < CPU_BLOCK_MAX_INSTRS) {
+        u8        opcode  = code[pos];
+        InstrFunc handler = cpu_instr_handler(opcode);
+        u8        length  = cpu_instr_length(opcode);
+
+        // Illegal opcodes & instructions running off the page go through cpu_execute()
+        if (handler == NULL || pos + length > avail)
+            break;
+
+        block->instrs[count++] = handler;
+        last  = pos;
+        pos  += length;
+
+        if (cpu_instr_ends_block(opcode))
+            break;
+    }
+
+    block->ptr = NULL;
+    if (count == 0)
+        return NULL;
+
+    u8 page       = cpu_block_page(cpu->pc);
+    block->ptr    = code;
+    block->pc     = cpu->pc;
+    block->count  = count;
+    block->gen    = cache->page_gen[page];
+    block->heat   = 0;
+    block->native = NULL;
+    block_scan_idle(block, code, last);
+
+    // Ahead-of-time code for this ROM offset
+    uintptr_t rom = (uintptr_t)gb->cart.rom;
+    if (cache->aot != NULL && (uintptr_t)code - rom < gb->cart.rom_size) {
+        block->native       = cpu_aot_lookup(cache->aot, (u32)((uintptr_t)code - rom));
+        block->native_epoch = CPU_AOT_EPOCH;
+    }
+
+    // Writable memory: route writes to this page through mmu_write_slow()
+    if (cpu->pc >= 0x8000 && !cache->code_page[page]) {
+        cache->code_page[page] = true;
+        gb->write_map[page]    = NULL;
+        if (page >= 0xC0 && page < 0xDE)
+            gb->write_map[page + 0x20] = NULL; // Echo RAM
+    }
+
+    return block;
+}
+
+CpuBlock *cpu_block_lookup(CPU *cpu) {
+    CpuBlockCache *cache  = &cpu->gb->blocks;
+    u16            offset = cpu->pc - cpu->fetch_lo;
+
+    if (offset >= cpu->fetch_len) {
+        mmu_fetch_region(cpu->gb, cpu->pc, cpu);
+        offset = cpu->pc - cpu->fetch_lo;
+        if (offset >= cpu->fetch_len)
+            return NULL; // No window (IO, OAM, ...)
+    }
+
+    const u8 *code  = cpu->fetch_ptr + offset;
+    CpuBlock *block = &cache->blocks[block_slot(code)];
+
+    if (block->ptr == code && block->pc == cpu->pc &&
+        block->gen == cache->page_gen[cpu_block_page(cpu->pc)]) {
+        cache->hits++;
+        return block;
+    }
+
+    // Decode up to the end of the window or the page, whichever comes first
+    u16 avail    = cpu->fetch_len - offset;
+    u16 page_end = 0x100 - (cpu->pc & 0xFF);
+    if (avail > page_end)
+        avail = page_end;
+
+    cache->misses++;
+    return block_decode(cpu, block, code, avail);
+}
+
+// Address an idle loop read, the registers it uses are the same every iteration
+static u16 idle_read_addr(const CPU *cpu, const CpuBlock *block, u8 i) {
+    switch (block->idle_src[i]) {
+        case CPU_IDLE_BC:
+            return cpu_read_bc(cpu);
+        case CPU_IDLE_DE:
+            return cpu_read_de(cpu);
+        case CPU_IDLE_HL:
+            return cpu_read_hl(cpu);
+        case CPU_IDLE_C:
+            return 0xFF00 | cpu->regs.c;
+        default:
+            return block->idle_addr[i];
+    }
+}
+
+u32 cpu_block_idle(CPU *cpu, const CpuBlock *block, u16 af, u32 start, u32 cycles,
+                   u32 budget) {
+    GameBoy       *gb    = cpu->gb;
+    CpuBlockCache *cache = &gb->blocks;
+
+    // Left the loop, or the iteration changed A / F
+    if (cpu->pc != block->pc || cpu->run_exit || cycles >= budget || cpu_read_af(cpu) != af)
+        return cycles;
+
+    // Every read of the iteration happened after `start`: the values hold
+    // until the first polled address changes
+    u64 now   = gb->cycles + cycles;
+    u64 until = gb->cycles + budget;
+    for (u8 i = 0; i < block->idle_reads; i++) {
+        u64 deadline = mmu_poll_deadline(gb, idle_read_addr(cpu, block, i), gb->cycles + start);
+        if (deadline < until)
+            until = deadline;
+    }
+    if (until <= now)
+        return cycles;
+
+    // Skip the iterations that would have ended by then: the engine then
+    // finishes the run exactly as if it had stepped through them
+    u32 iteration = cycles - start;
+    u32 skipped   = (u32)((until - now) / iteration * iteration);
+    if (skipped > 0) {
+        cache->idle_skips++;
+        cache->idle_cycles += skipped;
+    }
+    return cycles + skipped;
+}
+
+void cpu_block_invalidate(CpuBlockCache *cache, u16 addr) {
+    u8 page                = cpu_block_page(addr);
+    cache->page_gen[page] += 1;
+    cache->code_page[page] = false;
+    cache->stale           = true;
+    cache->invalidations++;
+}
+
+void cpu_block_flush(CpuBlockCache *cache) {
+    memset(cache->blocks, 0, sizeof(cache->blocks));
+    memset(cache->code_page, 0, sizeof(cache->code_page));
+    cache->stale = true;
+}
@@ -0,0 +1,57 @@
+// src/core/cpu/cpu_decode.c
+#include <core/cpu/cpu.h>
+
+// ---------------------------------------------
+// Instruction length in bytes (opcode + immediates)
+// https://www.pastraiser.com/cpu/gameboy/gameboy_opcodes.html
+// Illegal opcodes count as 1 byte
+// ---------------------------------------------
+// clang-format off
+static const u8 instr_length[256] = {
+    /*       _0 _1 _2 _3 _4 _5 _6 _7 _8 _9 _A _B _C _D _E _F */
+    /* 0_ */ 1, 3, 1, 1, 1, 1, 2, 1, 3, 1, 1, 1, 1, 1, 2, 1,
+    /* 1_ */ 2, 3, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 2, 1,
+    /* 2_ */ 2, 3, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 2, 1,
+    /* 3_ */ 2, 3, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 2, 1,
+    /* 4_ */ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    /* 5_ */ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    /* 6_ */ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    /* 7_ */ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    /* 8_ */ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    /* 9_ */ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    /* A_ */ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    /* B_ */ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    /* C_ */ 1, 1, 3, 3, 3, 1, 2, 1, 1, 1, 3, 2, 3, 3, 2, 1,
+    /* D_ */ 1, 1, 3, 1, 3, 1, 2, 1, 1, 1, 3, 1, 3, 1, 2, 1,
+    /* E_ */ 2, 1, 1, 1, 1, 1, 2, 1, 2, 1, 3, 1, 1, 1, 2, 1,
+    /* F_ */ 2, 1, 1, 1, 1, 1, 2, 1, 2, 1, 3, 1, 1, 1, 2, 1,
+};
+// clang-format on
+
+// ---------------------------------------------
+// Instructions that end a basic block
+// Anything that may change PC non-sequentially (JR/JP/CALL/RET/RETI/RST),
+// plus HALT/STOP and the IME changes (EI/DI), so the dispatch prologue
+// runs right after them
+// ---------------------------------------------
+static const bool instr_ends_block[256] = {
+    [0x10] = true, // STOP
+    [0x18] = true, [0x20] = true, [0x28] = true, [0x30] = true, [0x38] = true, // JR
+    [0x76] = true, // HALT
+    [0xC0] = true, [0xC8] = true, [0xC9] = true, [0xD0] = true, [0xD8] = true, // RET
+    [0xD9] = true, // RETI
+    [0xC2] = true, [0xC3] = true, [0xCA] = true, [0xD2] = true, [0xDA] = true, // JP
+    [0xE9] = true, // JP HL
+    [0xC4] = true, [0xCC] = true, [0xCD] = true, [0xD4] = true, [0xDC] = true, // CALL
+    [0xC7] = true, [0xCF] = true, [0xD7] = true, [0xDF] = true, // RST
+    [0xE7] = true, [0xEF] = true, [0xF7] = true, [0xFF] = true, // RST
+    [0xF3] = true, [0xFB] = true, // DI / EI
+};
+
+u8 cpu_instr_length(u8 opcode) {
+    return instr_length[opcode];
+}
+
+bool cpu_instr_ends_block(u8 opcode) {
+    return instr_ends_block[opcode];
+}
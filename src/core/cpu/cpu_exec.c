@@ -1,6 +1,7 @@
 // src/core/cpu/cpu_exec.c
 #include <core/cpu/cpu.h>
 #include <core/cpu/cpu_exec.h>
+#include <core/cpu/cpu_alu.h>
 #include <core/bus.h>
 #include <gbemu.h>
 #include <core/utils.h>
@@ -13,47 +14,38 @@ u8 instr_nop(CPU *cpu) {
     return 4;
 }
 
-// NOTE: Full STOP implementation requires joypad
-// therefore, for now we treat it as HALT
+// STOP: sleep until a joypad interrupt is requested (see cpu_run())
+// NOTE: The LCD keeps running, DMG games only STOP with it off anyway
 u8 instr_stop(CPU *cpu) {
     // STOP is a 2-byte instruction: 0x10 0x00
     // Read and discard the next byte (always 0x00)
-    mmu_read(cpu->gb, cpu->pc++);
-
-    // In a real Game Boy, STOP halts CPU/LCD until button press
-    // For testing/emulation without full power management:
-    // Just treat as a 2-byte NOP and continue execution
-
-    // cpu->halted = true;  // DON'T halt!
-
-    // TODO: Implement proper STOP behavior when joypad is ready:
-    // - Stop CPU clock
-    // - Stop LCD display
-    // - Wake on button press
+    mmu_fetch8(cpu);
 
+    timer_reset_div(cpu->gb); // The divider is reset on entry
+    cpu->stopped  = true;
+    cpu->run_exit = true;
     return 4;
 }
 
+// HALT: sleep until an enabled interrupt is requested (see cpu_run())
 u8 instr_halt(CPU *cpu) {
-    cpu->halted = true;
-
-    // TODO: When implementing interrupts:
-    // - CPU enters low-power mode
-    // - Wakes up when interrupt occurs (even if IME is disabled)
-    // - If IME is enabled, interrupt handler runs
-    // - If IME is disabled, execution continues after HALT
+    cpu->halted   = true;
+    cpu->run_exit = true; // Let cpu_run() hand the halt back to its caller
     return 4;
 }
 
-// Disable interrupts
+// Disable interrupts (also cancels a pending EI)
 u8 instr_di(CPU *cpu) {
-    cpu->ime = false;
+    cpu->ime           = false;
+    cpu->ime_scheduled = false;
+    cpu_irq_update(cpu);
     return 4;
 }
 
 // Enable interrupts
 u8 instr_ei(CPU *cpu) {
     cpu->ime_scheduled = true; // Set after NEXT instruction
+    cpu_irq_update(cpu);
     return 4;
 }
 
@@ -66,37 +58,37 @@ u8 instr_ei(CPU *cpu) {
 
 // Immediate loads
 u8 instr_ld_b_n(CPU *cpu) {
-    cpu->regs.b = mmu_read(cpu->gb, cpu->pc++);
+    cpu->regs.b = mmu_fetch8(cpu);
     return 8;
 }
 
 u8 instr_ld_c_n(CPU *cpu) {
-    cpu->regs.c = mmu_read(cpu->gb, cpu->pc++);
+    cpu->regs.c = mmu_fetch8(cpu);
     return 8;
 }
 
 u8 instr_ld_d_n(CPU *cpu) {
-    cpu->regs.d = mmu_read(cpu->gb, cpu->pc++);
+    cpu->regs.d = mmu_fetch8(cpu);
     return 8;
 }
 
 u8 instr_ld_e_n(CPU *cpu) {
-    cpu->regs.e = mmu_read(cpu->gb, cpu->pc++);
+    cpu->regs.e = mmu_fetch8(cpu);
     return 8;
 }
 
 u8 instr_ld_h_n(CPU *cpu) {
-    cpu->regs.h = mmu_read(cpu->gb, cpu->pc++);
+    cpu->regs.h = mmu_fetch8(cpu);
     return 8;
 }
 
 u8 instr_ld_l_n(CPU *cpu) {
-    cpu->regs.l = mmu_read(cpu->gb, cpu->pc++);
+    cpu->regs.l = mmu_fetch8(cpu);
     return 8;
 }
 
 u8 instr_ld_a_n(CPU *cpu) {
-    cpu->regs.a = mmu_read(cpu->gb, cpu->pc++);
+    cpu->regs.a = mmu_fetch8(cpu);
     return 8;
 }
 
@@ -439,21 +431,21 @@ u8 instr_ld_mem_hl_a(CPU *cpu) {
 // [hl] <- immediate (n)
 u8 instr_ld_mem_hl_n(CPU *cpu) {
     u16 addr  = cpu_read_hl(cpu);
-    u8  value = mmu_read(cpu->gb, cpu->pc++); // Read immediate value
+    u8  value = mmu_fetch8(cpu); // Read immediate value
     mmu_write(cpu->gb, addr, value);
     return 12;
 }
 
 // ld hl, sp+e8
 u8 instr_ld_hl_sp_e8(CPU *cpu) {
-    i8  e8      = (i8)mmu_read(cpu->gb, cpu->pc++);
+    i8  e8      = (i8)mmu_fetch8(cpu);
     u16 sp      = cpu->sp;
     u16 result  = sp + e8;
 
     u8  sp_low  = sp & 0xFF;
     u8  val     = (u8)e8;
 
-    cpu->regs.f = 0; // Z=0, N=0
+    cpu_flags_write(cpu, 0); // Z=0, N=0
 
     if (check_half_carry_add(sp_low, val))
         cpu->regs.f |= FLAG_HF_CARRY;
@@ -535,7 +527,7 @@ u8 instr_ld_a_mem_hli(CPU *cpu) {
 
 // [0xFF00 + a8] <- a
 u8 instr_ldh_mem_a8_a(CPU *cpu) {
-    u8  offset = mmu_read(cpu->gb, cpu->pc++);
+    u8  offset = mmu_fetch8(cpu);
     u16 addr   = 0xFF00 + offset;
     mmu_write(cpu->gb, addr, cpu->regs.a);
     return 12;
@@ -551,7 +543,7 @@ u8 instr_ldh_mem_c_a(CPU *cpu) {
 
 // a <- [0xFF00 + a8]
 u8 instr_ldh_a_mem_a8(CPU *cpu) {
-    u8  offset  = mmu_read(cpu->gb, cpu->pc++);
+    u8  offset  = mmu_fetch8(cpu);
     u16 addr    = 0xFF00 + offset;
     cpu->regs.a = mmu_read(cpu->gb, addr);
     return 12;
@@ -567,33 +559,23 @@ u8 instr_ldh_a_mem_c(CPU *cpu) {
 
 // [a16] <- a
 u8 instr_ld_mem_a16_a(CPU *cpu) {
-    u8  lo   = mmu_read(cpu->gb, cpu->pc++);
-    u8  hi   = mmu_read(cpu->gb, cpu->pc++);
-    u16 addr = MAKE_U16(hi, lo);
+    u16 addr = mmu_fetch16(cpu);
     mmu_write(cpu->gb, addr, cpu->regs.a);
     return 16;
 }
 
 // a <- [a16]
 u8 instr_ld_a_mem_a16(CPU *cpu) {
-    u8  lo      = mmu_read(cpu->gb, cpu->pc++);
-    u8  hi      = mmu_read(cpu->gb, cpu->pc++);
-    u16 addr    = MAKE_U16(hi, lo);
+    u16 addr    = mmu_fetch16(cpu);
     cpu->regs.a = mmu_read(cpu->gb, addr);
     return 16;
 }
 
 // [a16] <- SP
 u8 instr_ld_mem_a16_sp(CPU *cpu) {
-    u8  lo   = mmu_read(cpu->gb, cpu->pc++);
-    u8  hi   = mmu_read(cpu->gb, cpu->pc++);
-    u16 addr = MAKE_U16(hi, lo);
-
-    u16 sp   = cpu->sp;
-
-    mmu_write(cpu->gb, addr, GET_LOW_BYTE(sp));
-    mmu_write(cpu->gb, addr + 1, GET_HIGH_BYTE(sp));
+    u16 addr = mmu_fetch16(cpu);
 
+    mmu_write16(cpu->gb, addr, cpu->sp);
     return 20;
 }
 
@@ -602,30 +584,22 @@ u8 instr_ld_mem_a16_sp(CPU *cpu) {
 // ============================================================================
 
 u8 instr_ld_bc_nn(CPU *cpu) {
-    u8 lo = mmu_read(cpu->gb, cpu->pc++);
-    u8 hi = mmu_read(cpu->gb, cpu->pc++);
-    cpu_write_bc(cpu, MAKE_U16(hi, lo));
+    cpu_write_bc(cpu, mmu_fetch16(cpu));
     return 12;
 }
 
 u8 instr_ld_de_nn(CPU *cpu) {
-    u8 lo = mmu_read(cpu->gb, cpu->pc++);
-    u8 hi = mmu_read(cpu->gb, cpu->pc++);
-    cpu_write_de(cpu, MAKE_U16(hi, lo));
+    cpu_write_de(cpu, mmu_fetch16(cpu));
     return 12;
 }
 
 u8 instr_ld_hl_nn(CPU *cpu) {
-    u8 lo = mmu_read(cpu->gb, cpu->pc++);
-    u8 hi = mmu_read(cpu->gb, cpu->pc++);
-    cpu_write_hl(cpu, MAKE_U16(hi, lo));
+    cpu_write_hl(cpu, mmu_fetch16(cpu));
     return 12;
 }
 
 u8 instr_ld_sp_nn(CPU *cpu) {
-    u8 lo   = mmu_read(cpu->gb, cpu->pc++);
-    u8 hi   = mmu_read(cpu->gb, cpu->pc++);
-    cpu->sp = MAKE_U16(hi, lo);
+    cpu->sp = mmu_fetch16(cpu);
     return 12;
 }
 
@@ -642,149 +616,45 @@ u8 instr_ld_sp_nn(CPU *cpu) {
 // H - Set if overflow from 3rd bit
 // ----------------------------------------------
 u8 instr_inc_b(CPU *cpu) {
-    u8   result    = cpu->regs.b + 1;
-
-    // Preserve carry flag
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = 0;
-
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;     // Set Z if result = 0
-    if ((cpu->regs.b & 0x0F) == 0x0F) // Set H if lower nibble overlfows
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY; // Restore C (if it was set)
-
-    cpu->regs.b = result;
+    cpu->regs.b = alu_inc(cpu, cpu->regs.b);
     return 4;
 }
 
 u8 instr_inc_c(CPU *cpu) {
-    u8   result    = cpu->regs.c + 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.c & 0x0F) == 0x0F)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.c = result;
+    cpu->regs.c = alu_inc(cpu, cpu->regs.c);
     return 4;
 }
 
 u8 instr_inc_d(CPU *cpu) {
-    u8   result    = cpu->regs.d + 1;
-
-    // Preserve carry flag
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = 0;
-
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.d & 0x0F) == 0x0F)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.d = result;
+    cpu->regs.d = alu_inc(cpu, cpu->regs.d);
     return 4;
 }
 
 u8 instr_inc_e(CPU *cpu) {
-    u8   result    = cpu->regs.e + 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = 0;
-
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.e & 0x0F) == 0x0F)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.e = result;
+    cpu->regs.e = alu_inc(cpu, cpu->regs.e);
     return 4;
 }
 
 u8 instr_inc_h(CPU *cpu) {
-    u8   result    = cpu->regs.h + 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = 0;
-
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.h & 0x0F) == 0x0F)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.h = result;
+    cpu->regs.h = alu_inc(cpu, cpu->regs.h);
     return 4;
 }
 
 u8 instr_inc_l(CPU *cpu) {
-    u8   result    = cpu->regs.l + 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = 0;
-
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.l & 0x0F) == 0x0F)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.l = result;
+    cpu->regs.l = alu_inc(cpu, cpu->regs.l);
     return 4;
 }
 
 u8 instr_inc_a(CPU *cpu) {
-    u8   result    = cpu->regs.a + 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = 0;
-
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.a & 0x0F) == 0x0F)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_inc(cpu, cpu->regs.a);
     return 4;
 }
 
 u8 instr_inc_mem_hl(CPU *cpu) {
-    u16  addr      = cpu_read_hl(cpu);
-    u8   value     = mmu_read(cpu->gb, addr);
-    u8   result    = value + 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = 0;
-
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((value & 0x0F) == 0x0F)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
+    u16 addr  = cpu_read_hl(cpu);
+    u8  value = mmu_read(cpu->gb, addr);
 
-    mmu_write(cpu->gb, addr, result);
+    mmu_write(cpu->gb, addr, alu_inc(cpu, value));
     return 12;
 }
 
@@ -796,141 +666,45 @@ u8 instr_inc_mem_hl(CPU *cpu) {
 // H - Set if borrow from 4th bit
 // ----------------------------------------------
 u8 instr_dec_b(CPU *cpu) {
-    u8   result    = cpu->regs.b - 1;
-
-    // Preserve carry flag
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;  // Set Z if result is zero
-    if ((cpu->regs.b & 0x0F) == 0) // Set H if lower nibble underflows
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY; // Restore the carry flag
-
-    cpu->regs.b = result;
+    cpu->regs.b = alu_dec(cpu, cpu->regs.b);
     return 4;
 }
 
 u8 instr_dec_c(CPU *cpu) {
-    u8   result    = cpu->regs.c - 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.c & 0x0F) == 0)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.c = result;
+    cpu->regs.c = alu_dec(cpu, cpu->regs.c);
     return 4;
 }
 
 u8 instr_dec_d(CPU *cpu) {
-    u8   result    = cpu->regs.d - 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.d & 0x0F) == 0)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.d = result;
+    cpu->regs.d = alu_dec(cpu, cpu->regs.d);
     return 4;
 }
 
 u8 instr_dec_e(CPU *cpu) {
-    u8   result    = cpu->regs.e - 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.e & 0x0F) == 0)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.e = result;
+    cpu->regs.e = alu_dec(cpu, cpu->regs.e);
     return 4;
 }
 
 u8 instr_dec_h(CPU *cpu) {
-    u8   result    = cpu->regs.h - 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.h & 0x0F) == 0)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.h = result;
+    cpu->regs.h = alu_dec(cpu, cpu->regs.h);
     return 4;
 }
 
 u8 instr_dec_l(CPU *cpu) {
-    u8   result    = cpu->regs.l - 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.l & 0x0F) == 0)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.l = result;
+    cpu->regs.l = alu_dec(cpu, cpu->regs.l);
     return 4;
 }
 
 u8 instr_dec_a(CPU *cpu) {
-    u8   result    = cpu->regs.a - 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.a & 0x0F) == 0)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_dec(cpu, cpu->regs.a);
     return 4;
 }
 
 u8 instr_dec_mem_hl(CPU *cpu) {
-    u16  addr      = cpu_read_hl(cpu);
-    u8   value     = mmu_read(cpu->gb, addr);
-    u8   result    = value - 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((value & 0x0F) == 0)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
+    u16 addr  = cpu_read_hl(cpu);
+    u8  value = mmu_read(cpu->gb, addr);
 
-    mmu_write(cpu->gb, addr, result);
+    mmu_write(cpu->gb, addr, alu_dec(cpu, value));
     return 12;
 }
 
@@ -943,155 +717,51 @@ u8 instr_dec_mem_hl(CPU *cpu) {
 // C - Set if overflow from bit 7
 // ----------------------------------------------
 u8 instr_add_a_b(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 b        = cpu->regs.b;
-    u8 result   = a + b;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_add(a, b))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_add(a, b))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.b, 0);
     return 4;
 }
 
 u8 instr_add_a_c(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 c        = cpu->regs.c;
-    u8 result   = a + c;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_add(a, c))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_add(a, c))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.c, 0);
     return 4;
 }
 
 u8 instr_add_a_d(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 d        = cpu->regs.d;
-    u8 result   = a + d;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_add(a, d))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_add(a, d))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.d, 0);
     return 4;
 }
 
 u8 instr_add_a_e(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 e        = cpu->regs.e;
-    u8 result   = a + e;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_add(a, e))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_add(a, e))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.e, 0);
     return 4;
 }
 
 u8 instr_add_a_h(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 h        = cpu->regs.h;
-    u8 result   = a + h;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_add(a, h))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_add(a, h))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.h, 0);
     return 4;
 }
 
 u8 instr_add_a_l(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 l        = cpu->regs.l;
-    u8 result   = a + l;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_add(a, l))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_add(a, l))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.l, 0);
     return 4;
 }
 
 u8 instr_add_a_a(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 result   = a + a;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_add(a, a))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_add(a, a))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.a, 0);
     return 4;
 }
 
 u8 instr_add_a_mem_hl(CPU *cpu) {
-    u8  a       = cpu->regs.a;
-    u16 address = cpu_read_hl(cpu);
-    u8  value   = mmu_read(cpu->gb, address);
-    u8  result  = a + value;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_add(a, value))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_add(a, value))
-        cpu->regs.f |= FLAG_CARRY;
+    u8 value = mmu_read(cpu->gb, cpu_read_hl(cpu));
 
-    cpu->regs.a = result;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, value, 0);
     return 8;
 }
 
 u8 instr_add_a_n(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 n        = mmu_read(cpu->gb, cpu->pc++);
-    u8 result   = a + n;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_add(a, n))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_add(a, n))
-        cpu->regs.f |= FLAG_CARRY;
+    u8 n = mmu_fetch8(cpu);
 
-    cpu->regs.a = result;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, n, 0);
     return 8;
 }
 
@@ -1104,164 +774,51 @@ u8 instr_add_a_n(CPU *cpu) {
 // C - Set if overflow from bit 7
 // ----------------------------------------------
 u8 instr_adc_a_b(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 b        = cpu->regs.b;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY) ? 1 : 0;
-    u8 result   = a + b + carry;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_adc(a, b, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_adc(a, b, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.b, cpu_flag_c(cpu));
     return 4;
 }
 
 u8 instr_adc_a_c(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 c        = cpu->regs.c;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY) ? 1 : 0;
-    u8 result   = a + c + carry;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_adc(a, c, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_adc(a, c, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.c, cpu_flag_c(cpu));
     return 4;
 }
 
 u8 instr_adc_a_d(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 d        = cpu->regs.d;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY) ? 1 : 0;
-    u8 result   = a + d + carry;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_adc(a, d, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_adc(a, d, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.d, cpu_flag_c(cpu));
     return 4;
 }
 
 u8 instr_adc_a_e(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 e        = cpu->regs.e;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY) ? 1 : 0;
-    u8 result   = a + e + carry;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_adc(a, e, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_adc(a, e, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.e, cpu_flag_c(cpu));
     return 4;
 }
 
 u8 instr_adc_a_h(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 h        = cpu->regs.h;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY) ? 1 : 0;
-    u8 result   = a + h + carry;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_adc(a, h, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_adc(a, h, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.h, cpu_flag_c(cpu));
     return 4;
 }
 
 u8 instr_adc_a_l(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 l        = cpu->regs.l;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY) ? 1 : 0;
-    u8 result   = a + l + carry;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_adc(a, l, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_adc(a, l, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.l, cpu_flag_c(cpu));
     return 4;
 }
 
 u8 instr_adc_a_a(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY) ? 1 : 0;
-    u8 result   = a + a + carry;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_adc(a, a, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_adc(a, a, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.a, cpu_flag_c(cpu));
     return 4;
 }
 
 u8 instr_adc_a_mem_hl(CPU *cpu) {
-    u8  a       = cpu->regs.a;
-    u8  carry   = cpu_get_flag(cpu, FLAG_CARRY) ? 1 : 0;
-    u16 addr    = cpu_read_hl(cpu);
-    u8  value   = mmu_read(cpu->gb, addr);
-    u8  result  = a + value + carry;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_adc(a, value, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_adc(a, value, carry))
-        cpu->regs.f |= FLAG_CARRY;
+    u8 value = mmu_read(cpu->gb, cpu_read_hl(cpu));
 
-    cpu->regs.a = result;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, value, cpu_flag_c(cpu));
     return 8;
 }
 
 u8 instr_adc_a_n(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY) ? 1 : 0;
-    u8 value    = mmu_read(cpu->gb, cpu->pc++);
-    u8 result   = a + value + carry;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_adc(a, value, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_adc(a, value, carry))
-        cpu->regs.f |= FLAG_CARRY;
+    u8 n = mmu_fetch8(cpu);
 
-    cpu->regs.a = result;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, n, cpu_flag_c(cpu));
     return 8;
 }
 
@@ -1274,145 +831,51 @@ u8 instr_adc_a_n(CPU *cpu) {
 // C - Set if borrow (r8 > A)
 // ----------------------------------------------
 u8 instr_sub_a_b(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 b        = cpu->regs.b;
-    u8 result   = a - b;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, b))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, b))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.b, 0);
     return 4;
 }
 
 u8 instr_sub_a_c(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 c        = cpu->regs.c;
-    u8 result   = a - c;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, c))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, c))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.c, 0);
     return 4;
 }
 
 u8 instr_sub_a_d(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 d        = cpu->regs.d;
-    u8 result   = a - d;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, d))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, d))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.d, 0);
     return 4;
 }
 
 u8 instr_sub_a_e(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 e        = cpu->regs.e;
-    u8 result   = a - e;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, e))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, e))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.e, 0);
     return 4;
 }
 
 u8 instr_sub_a_h(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 h        = cpu->regs.h;
-    u8 result   = a - h;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, h))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, h))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.h, 0);
     return 4;
 }
 
 u8 instr_sub_a_l(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 l        = cpu->regs.l;
-    u8 result   = a - l;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, l))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, l))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.l, 0);
     return 4;
 }
 
 u8 instr_sub_a_a(CPU *cpu) {
-    cpu->regs.a = 0;
-    cpu->regs.f = FLAG_ZERO | FLAG_SUBT; // Z=1, N=1, H=0, C=0
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.a, 0);
     return 4;
 }
 
 u8 instr_sub_a_mem_hl(CPU *cpu) {
-    u8  a       = cpu->regs.a;
-    u16 address = cpu_read_hl(cpu);
-    u8  value   = mmu_read(cpu->gb, address);
-    u8  result  = a - value;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, value))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, value))
-        cpu->regs.f |= FLAG_CARRY;
+    u8 value = mmu_read(cpu->gb, cpu_read_hl(cpu));
 
-    cpu->regs.a = result;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, value, 0);
     return 8;
 }
 
 u8 instr_sub_a_n(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 n        = mmu_read(cpu->gb, cpu->pc++);
-    u8 result   = a - n;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, n))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, n))
-        cpu->regs.f |= FLAG_CARRY;
+    u8 n = mmu_fetch8(cpu);
 
-    cpu->regs.a = result;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, n, 0);
     return 8;
 }
 
@@ -1425,164 +888,51 @@ u8 instr_sub_a_n(CPU *cpu) {
 // C - Set if borrow (r8 + carry > A)
 // ----------------------------------------------
 u8 instr_sbc_a_b(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 b        = cpu->regs.b;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY);
-    u8 result   = a - b - carry;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sbc(a, b, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sbc(a, b, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.b, cpu_flag_c(cpu));
     return 4;
 }
 
 u8 instr_sbc_a_c(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 c        = cpu->regs.c;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY);
-    u8 result   = a - c - carry;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sbc(a, c, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sbc(a, c, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.c, cpu_flag_c(cpu));
     return 4;
 }
 
 u8 instr_sbc_a_d(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 d        = cpu->regs.d;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY);
-    u8 result   = a - d - carry;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sbc(a, d, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sbc(a, d, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.d, cpu_flag_c(cpu));
     return 4;
 }
 
 u8 instr_sbc_a_e(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 e        = cpu->regs.e;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY);
-    u8 result   = a - e - carry;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sbc(a, e, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sbc(a, e, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.e, cpu_flag_c(cpu));
     return 4;
 }
 
 u8 instr_sbc_a_h(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 h        = cpu->regs.h;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY);
-    u8 result   = a - h - carry;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sbc(a, h, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sbc(a, h, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.h, cpu_flag_c(cpu));
     return 4;
 }
 
 u8 instr_sbc_a_l(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 l        = cpu->regs.l;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY);
-    u8 result   = a - l - carry;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sbc(a, l, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sbc(a, l, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.l, cpu_flag_c(cpu));
     return 4;
 }
 
 u8 instr_sbc_a_a(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY);
-    u8 result   = a - a - carry;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (carry) {
-        cpu->regs.f |= FLAG_HF_CARRY;
-        cpu->regs.f |= FLAG_CARRY;
-    }
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.a, cpu_flag_c(cpu));
     return 4;
 }
 
 u8 instr_sbc_a_mem_hl(CPU *cpu) {
-    u8  a       = cpu->regs.a;
-    u8  carry   = cpu_get_flag(cpu, FLAG_CARRY);
-    u16 addr    = cpu_read_hl(cpu);
-    u8  value   = mmu_read(cpu->gb, addr);
-    u8  result  = a - value - carry;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sbc(a, value, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sbc(a, value, carry))
-        cpu->regs.f |= FLAG_CARRY;
+    u8 value = mmu_read(cpu->gb, cpu_read_hl(cpu));
 
-    cpu->regs.a = result;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, value, cpu_flag_c(cpu));
     return 8;
 }
 
 u8 instr_sbc_a_n(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY);
-    u8 n        = mmu_read(cpu->gb, cpu->pc++);
-    u8 result   = a - n - carry;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sbc(a, n, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sbc(a, n, carry))
-        cpu->regs.f |= FLAG_CARRY;
+    u8 n = mmu_fetch8(cpu);
 
-    cpu->regs.a = result;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, n, cpu_flag_c(cpu));
     return 8;
 }
 
@@ -1600,101 +950,51 @@ u8 instr_sbc_a_n(CPU *cpu) {
 // C - 0
 // ----------------------------------------------
 u8 instr_and_a_b(CPU *cpu) {
-    u8 result   = cpu->regs.a & cpu->regs.b;
-
-    cpu->regs.f = FLAG_HF_CARRY;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_and(cpu, cpu->regs.a, cpu->regs.b);
     return 4;
 }
 
 u8 instr_and_a_c(CPU *cpu) {
-    u8 result   = cpu->regs.a & cpu->regs.c;
-
-    cpu->regs.f = FLAG_HF_CARRY;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_and(cpu, cpu->regs.a, cpu->regs.c);
     return 4;
 }
 
 u8 instr_and_a_d(CPU *cpu) {
-    u8 result   = cpu->regs.a & cpu->regs.d;
-
-    cpu->regs.f = FLAG_HF_CARRY;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_and(cpu, cpu->regs.a, cpu->regs.d);
     return 4;
 }
 
 u8 instr_and_a_e(CPU *cpu) {
-    u8 result   = cpu->regs.a & cpu->regs.e;
-
-    cpu->regs.f = FLAG_HF_CARRY;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_and(cpu, cpu->regs.a, cpu->regs.e);
     return 4;
 }
 
 u8 instr_and_a_h(CPU *cpu) {
-    u8 result   = cpu->regs.a & cpu->regs.h;
-
-    cpu->regs.f = FLAG_HF_CARRY;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_and(cpu, cpu->regs.a, cpu->regs.h);
     return 4;
 }
 
 u8 instr_and_a_l(CPU *cpu) {
-    u8 result   = cpu->regs.a & cpu->regs.l;
-
-    cpu->regs.f = FLAG_HF_CARRY;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_and(cpu, cpu->regs.a, cpu->regs.l);
     return 4;
 }
 
 u8 instr_and_a_a(CPU *cpu) {
-    cpu->regs.f = FLAG_HF_CARRY;
-    if (cpu->regs.a == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
+    cpu->regs.a = alu_and(cpu, cpu->regs.a, cpu->regs.a);
     return 4;
 }
 
 u8 instr_and_a_mem_hl(CPU *cpu) {
-    u16 addr    = cpu_read_hl(cpu);
-    u8  value   = mmu_read(cpu->gb, addr);
-    u8  result  = cpu->regs.a & value;
+    u8 value = mmu_read(cpu->gb, cpu_read_hl(cpu));
 
-    cpu->regs.f = FLAG_HF_CARRY;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_and(cpu, cpu->regs.a, value);
     return 8;
 }
 
 u8 instr_and_a_n(CPU *cpu) {
-    u8 n        = mmu_read(cpu->gb, cpu->pc++);
-    u8 result   = cpu->regs.a & n;
-
-    cpu->regs.f = FLAG_HF_CARRY;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
+    u8 n = mmu_fetch8(cpu);
 
-    cpu->regs.a = result;
+    cpu->regs.a = alu_and(cpu, cpu->regs.a, n);
     return 8;
 }
 
@@ -1707,101 +1007,51 @@ u8 instr_and_a_n(CPU *cpu) {
 // C - 0
 // ----------------------------------------------
 u8 instr_or_a_b(CPU *cpu) {
-    u8 result   = cpu->regs.a | cpu->regs.b;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_or(cpu, cpu->regs.a, cpu->regs.b);
     return 4;
 }
 
 u8 instr_or_a_c(CPU *cpu) {
-    u8 result   = cpu->regs.a | cpu->regs.c;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_or(cpu, cpu->regs.a, cpu->regs.c);
     return 4;
 }
 
 u8 instr_or_a_d(CPU *cpu) {
-    u8 result   = cpu->regs.a | cpu->regs.d;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_or(cpu, cpu->regs.a, cpu->regs.d);
     return 4;
 }
 
 u8 instr_or_a_e(CPU *cpu) {
-    u8 result   = cpu->regs.a | cpu->regs.e;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_or(cpu, cpu->regs.a, cpu->regs.e);
     return 4;
 }
 
 u8 instr_or_a_h(CPU *cpu) {
-    u8 result   = cpu->regs.a | cpu->regs.h;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_or(cpu, cpu->regs.a, cpu->regs.h);
     return 4;
 }
 
 u8 instr_or_a_l(CPU *cpu) {
-    u8 result   = cpu->regs.a | cpu->regs.l;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_or(cpu, cpu->regs.a, cpu->regs.l);
     return 4;
 }
 
 u8 instr_or_a_a(CPU *cpu) {
-    cpu->regs.f = 0;
-    if (cpu->regs.a == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
+    cpu->regs.a = alu_or(cpu, cpu->regs.a, cpu->regs.a);
     return 4;
 }
 
 u8 instr_or_a_mem_hl(CPU *cpu) {
-    u16 addr    = cpu_read_hl(cpu);
-    u8  value   = mmu_read(cpu->gb, addr);
-    u8  result  = cpu->regs.a | value;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
+    u8 value = mmu_read(cpu->gb, cpu_read_hl(cpu));
 
-    cpu->regs.a = result;
+    cpu->regs.a = alu_or(cpu, cpu->regs.a, value);
     return 8;
 }
 
 u8 instr_or_a_n(CPU *cpu) {
-    u8 value    = mmu_read(cpu->gb, cpu->pc++);
-    u8 result   = cpu->regs.a | value;
+    u8 n = mmu_fetch8(cpu);
 
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_or(cpu, cpu->regs.a, n);
     return 8;
 }
 
@@ -1814,99 +1064,51 @@ u8 instr_or_a_n(CPU *cpu) {
 // C - 0
 // ----------------------------------------------
 u8 instr_xor_a_b(CPU *cpu) {
-    u8 result   = cpu->regs.a ^ cpu->regs.b;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_xor(cpu, cpu->regs.a, cpu->regs.b);
     return 4;
 }
 
 u8 instr_xor_a_c(CPU *cpu) {
-    u8 result   = cpu->regs.a ^ cpu->regs.c;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_xor(cpu, cpu->regs.a, cpu->regs.c);
     return 4;
 }
 
 u8 instr_xor_a_d(CPU *cpu) {
-    u8 result   = cpu->regs.a ^ cpu->regs.d;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_xor(cpu, cpu->regs.a, cpu->regs.d);
     return 4;
 }
 
 u8 instr_xor_a_e(CPU *cpu) {
-    u8 result   = cpu->regs.a ^ cpu->regs.e;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_xor(cpu, cpu->regs.a, cpu->regs.e);
     return 4;
 }
 
 u8 instr_xor_a_h(CPU *cpu) {
-    u8 result   = cpu->regs.a ^ cpu->regs.h;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_xor(cpu, cpu->regs.a, cpu->regs.h);
     return 4;
 }
 
 u8 instr_xor_a_l(CPU *cpu) {
-    u8 result   = cpu->regs.a ^ cpu->regs.l;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_xor(cpu, cpu->regs.a, cpu->regs.l);
     return 4;
 }
 
 u8 instr_xor_a_a(CPU *cpu) {
-    cpu->regs.f = FLAG_ZERO;
-    cpu->regs.a = 0;
+    cpu->regs.a = alu_xor(cpu, cpu->regs.a, cpu->regs.a);
     return 4;
 }
 
 u8 instr_xor_a_mem_hl(CPU *cpu) {
-    u16 addr    = cpu_read_hl(cpu);
-    u8  value   = mmu_read(cpu->gb, addr);
-    u8  result  = cpu->regs.a ^ value;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
+    u8 value = mmu_read(cpu->gb, cpu_read_hl(cpu));
 
-    cpu->regs.a = result;
+    cpu->regs.a = alu_xor(cpu, cpu->regs.a, value);
     return 8;
 }
 
 u8 instr_xor_a_n(CPU *cpu) {
-    u8 value    = mmu_read(cpu->gb, cpu->pc++);
-    u8 result   = cpu->regs.a ^ value;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
+    u8 n = mmu_fetch8(cpu);
 
-    cpu->regs.a = result;
+    cpu->regs.a = alu_xor(cpu, cpu->regs.a, n);
     return 8;
 }
 
@@ -1920,136 +1122,51 @@ u8 instr_xor_a_n(CPU *cpu) {
 // C - Set if borrow (r8 > A)
 // ----------------------------------------------
 u8 instr_cp_a_b(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 b        = cpu->regs.b;
-    u8 result   = a - b;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, b))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, b))
-        cpu->regs.f |= FLAG_CARRY;
-
+    alu_sub(cpu, cpu->regs.a, cpu->regs.b, 0);
     return 4;
 }
 
 u8 instr_cp_a_c(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 c        = cpu->regs.c;
-    u8 result   = a - c;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, c))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, c))
-        cpu->regs.f |= FLAG_CARRY;
-
+    alu_sub(cpu, cpu->regs.a, cpu->regs.c, 0);
     return 4;
 }
 
 u8 instr_cp_a_d(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 d        = cpu->regs.d;
-    u8 result   = a - d;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, d))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, d))
-        cpu->regs.f |= FLAG_CARRY;
-
+    alu_sub(cpu, cpu->regs.a, cpu->regs.d, 0);
     return 4;
 }
 
 u8 instr_cp_a_e(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 e        = cpu->regs.e;
-    u8 result   = a - e;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, e))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, e))
-        cpu->regs.f |= FLAG_CARRY;
-
+    alu_sub(cpu, cpu->regs.a, cpu->regs.e, 0);
     return 4;
 }
 
 u8 instr_cp_a_h(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 h        = cpu->regs.h;
-    u8 result   = a - h;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, h))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, h))
-        cpu->regs.f |= FLAG_CARRY;
-
+    alu_sub(cpu, cpu->regs.a, cpu->regs.h, 0);
     return 4;
 }
 
 u8 instr_cp_a_l(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 l        = cpu->regs.l;
-    u8 result   = a - l;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, l))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, l))
-        cpu->regs.f |= FLAG_CARRY;
-
+    alu_sub(cpu, cpu->regs.a, cpu->regs.l, 0);
     return 4;
 }
 
 u8 instr_cp_a_a(CPU *cpu) {
-    cpu->regs.f = FLAG_SUBT | FLAG_ZERO;
+    alu_sub(cpu, cpu->regs.a, cpu->regs.a, 0);
     return 4;
 }
 
 u8 instr_cp_a_mem_hl(CPU *cpu) {
-    u8  a       = cpu->regs.a;
-    u16 addr    = cpu_read_hl(cpu);
-    u8  value   = mmu_read(cpu->gb, addr);
-    u8  result  = a - value;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, value))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, value))
-        cpu->regs.f |= FLAG_CARRY;
+    u8 value = mmu_read(cpu->gb, cpu_read_hl(cpu));
 
+    alu_sub(cpu, cpu->regs.a, value, 0);
     return 8;
 }
 
 u8 instr_cp_a_n(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 n        = mmu_read(cpu->gb, cpu->pc++);
-    u8 result   = a - n;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, n))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, n))
-        cpu->regs.f |= FLAG_CARRY;
+    u8 n = mmu_fetch8(cpu);
 
+    alu_sub(cpu, cpu->regs.a, n, 0);
     return 8;
 }
 
@@ -2071,9 +1188,9 @@ u8 instr_add_hl_bc(CPU *cpu) {
     u16 result   = hl + bc;
 
     // Preserve Z flag
-    u8  old_flag = cpu_get_flag(cpu, FLAG_ZERO);
+    u8  old_flag = cpu_flag_z(cpu) ? FLAG_ZERO : 0;
 
-    cpu->regs.f  = 0;
+    cpu_flags_write(cpu, 0);
     if (check_half_carry_add_u16(hl, bc))
         cpu->regs.f |= FLAG_HF_CARRY;
     if (check_carry_add_u16(hl, bc))
@@ -2090,9 +1207,9 @@ u8 instr_add_hl_de(CPU *cpu) {
     u16 result   = hl + de;
 
     // Preserve Z flag
-    u8  old_flag = cpu_get_flag(cpu, FLAG_ZERO);
+    u8  old_flag = cpu_flag_z(cpu) ? FLAG_ZERO : 0;
 
-    cpu->regs.f  = 0;
+    cpu_flags_write(cpu, 0);
     if (check_half_carry_add_u16(hl, de))
         cpu->regs.f |= FLAG_HF_CARRY;
     if (check_carry_add_u16(hl, de))
@@ -2108,9 +1225,9 @@ u8 instr_add_hl_hl(CPU *cpu) {
     u16 result   = hl + hl;
 
     // Preserve Z flag
-    u8  old_flag = cpu_get_flag(cpu, FLAG_ZERO);
+    u8  old_flag = cpu_flag_z(cpu) ? FLAG_ZERO : 0;
 
-    cpu->regs.f  = 0;
+    cpu_flags_write(cpu, 0);
     if (check_half_carry_add_u16(hl, hl))
         cpu->regs.f |= FLAG_HF_CARRY;
     if (check_carry_add_u16(hl, hl))
@@ -2127,9 +1244,9 @@ u8 instr_add_hl_sp(CPU *cpu) {
     u16 result   = hl + sp;
 
     // Preserve Z flag
-    u8  old_flag = cpu_get_flag(cpu, FLAG_ZERO);
+    u8  old_flag = cpu_flag_z(cpu) ? FLAG_ZERO : 0;
 
-    cpu->regs.f  = 0;
+    cpu_flags_write(cpu, 0);
     if (check_half_carry_add_u16(hl, sp))
         cpu->regs.f |= FLAG_HF_CARRY;
     if (check_carry_add_u16(hl, sp))
@@ -2148,14 +1265,14 @@ u8 instr_add_hl_sp(CPU *cpu) {
 // C - Set if overflow from bit 7
 // ----------------------------------------------
 u8 instr_add_sp_e8(CPU *cpu) {
-    i8  e8      = (i8)mmu_read(cpu->gb, cpu->pc++);
+    i8  e8      = (i8)mmu_fetch8(cpu);
     u16 sp      = cpu->sp;
     u16 result  = sp + e8;
 
     u8  sp_low  = sp & 0xFF;
     u8  val     = (u8)e8;
 
-    cpu->regs.f = 0;
+    cpu_flags_write(cpu, 0);
 
     if (check_half_carry_add(sp_low, val))
         cpu->regs.f |= FLAG_HF_CARRY;
@@ -2231,34 +1348,22 @@ u8 instr_dec_sp(CPU *cpu) {
 // None affected
 // ----------------------------------------------
 u8 instr_push_bc(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, cpu->regs.b);
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, cpu->regs.c);
+    mmu_push16(cpu, cpu_read_bc(cpu));
     return 16;
 }
 
 u8 instr_push_de(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, cpu->regs.d);
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, cpu->regs.e);
+    mmu_push16(cpu, cpu_read_de(cpu));
     return 16;
 }
 
 u8 instr_push_hl(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, cpu->regs.h);
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, cpu->regs.l);
+    mmu_push16(cpu, cpu_read_hl(cpu));
     return 16;
 }
 
 u8 instr_push_af(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, cpu->regs.a);
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, cpu->regs.f);
+    mmu_push16(cpu, cpu_read_af(cpu));
     return 16;
 }
 
@@ -2268,98 +1373,70 @@ u8 instr_push_af(CPU *cpu) {
 // None affected
 // ----------------------------------------------
 u8 instr_pop_bc(CPU *cpu) {
-    cpu->regs.c = mmu_read(cpu->gb, cpu->sp++);
-    cpu->regs.b = mmu_read(cpu->gb, cpu->sp++);
+    cpu_write_bc(cpu, mmu_pop16(cpu));
     return 12;
 }
 
 u8 instr_pop_de(CPU *cpu) {
-    cpu->regs.e = mmu_read(cpu->gb, cpu->sp++);
-    cpu->regs.d = mmu_read(cpu->gb, cpu->sp++);
+    cpu_write_de(cpu, mmu_pop16(cpu));
     return 12;
 }
 
 u8 instr_pop_hl(CPU *cpu) {
-    cpu->regs.l = mmu_read(cpu->gb, cpu->sp++);
-    cpu->regs.h = mmu_read(cpu->gb, cpu->sp++);
+    cpu_write_hl(cpu, mmu_pop16(cpu));
     return 12;
 }
 
 u8 instr_pop_af(CPU *cpu) {
-    cpu->regs.f = mmu_read(cpu->gb, cpu->sp++);
-    cpu->regs.a = mmu_read(cpu->gb, cpu->sp++);
+    cpu_write_af(cpu, mmu_pop16(cpu)); // Lower 4 bits of F always zero
     return 12;
 }
 
 // Restart Vectors
 u8 instr_rst_00(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    mmu_push16(cpu, cpu->pc);
     cpu->pc = 0x00;
     return 16;
 }
 
 u8 instr_rst_08(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    mmu_push16(cpu, cpu->pc);
     cpu->pc = 0x08;
     return 16;
 }
 
 u8 instr_rst_10(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    mmu_push16(cpu, cpu->pc);
     cpu->pc = 0x10;
     return 16;
 }
 
 u8 instr_rst_18(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    mmu_push16(cpu, cpu->pc);
     cpu->pc = 0x18;
     return 16;
 }
 
 u8 instr_rst_20(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    mmu_push16(cpu, cpu->pc);
     cpu->pc = 0x20;
     return 16;
 }
 
 u8 instr_rst_28(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    mmu_push16(cpu, cpu->pc);
     cpu->pc = 0x28;
     return 16;
 }
 
 u8 instr_rst_30(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    mmu_push16(cpu, cpu->pc);
     cpu->pc = 0x30;
     return 16;
 }
 
 u8 instr_rst_38(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    mmu_push16(cpu, cpu->pc);
     cpu->pc = 0x38;
     return 16;
 }
@@ -2375,9 +1452,7 @@ u8 instr_rst_38(CPU *cpu) {
 // None affected
 // ----------------------------------------------
 u8 instr_jp_a16(CPU *cpu) {
-    u8 lo   = mmu_read(cpu->gb, cpu->pc++);
-    u8 hi   = mmu_read(cpu->gb, cpu->pc++);
-    cpu->pc = MAKE_U16(hi, lo);
+    cpu->pc = mmu_fetch16(cpu);
     return 16;
 }
 
@@ -2399,11 +1474,10 @@ u8 instr_jp_hl(CPU *cpu) {
 // None affected
 // ----------------------------------------------
 u8 instr_jp_nz_a16(CPU *cpu) {
-    u8 lo = mmu_read(cpu->gb, cpu->pc++);
-    u8 hi = mmu_read(cpu->gb, cpu->pc++);
+    u16 addr = mmu_fetch16(cpu);
 
-    if (!cpu_get_flag(cpu, FLAG_ZERO)) {
-        cpu->pc = MAKE_U16(hi, lo);
+    if (!cpu_flag_z(cpu)) {
+        cpu->pc = addr;
         return 16;
     }
 
@@ -2411,33 +1485,30 @@ u8 instr_jp_nz_a16(CPU *cpu) {
 }
 
 u8 instr_jp_z_a16(CPU *cpu) {
-    u8 lo = mmu_read(cpu->gb, cpu->pc++);
-    u8 hi = mmu_read(cpu->gb, cpu->pc++);
+    u16 addr = mmu_fetch16(cpu);
 
-    if (cpu_get_flag(cpu, FLAG_ZERO)) {
-        cpu->pc = MAKE_U16(hi, lo);
+    if (cpu_flag_z(cpu)) {
+        cpu->pc = addr;
         return 16;
     }
     return 12;
 }
 
 u8 instr_jp_nc_a16(CPU *cpu) {
-    u8 lo = mmu_read(cpu->gb, cpu->pc++);
-    u8 hi = mmu_read(cpu->gb, cpu->pc++);
+    u16 addr = mmu_fetch16(cpu);
 
-    if (!cpu_get_flag(cpu, FLAG_CARRY)) {
-        cpu->pc = MAKE_U16(hi, lo);
+    if (!cpu_flag_c(cpu)) {
+        cpu->pc = addr;
         return 16;
     }
     return 12;
 }
 
 u8 instr_jp_c_a16(CPU *cpu) {
-    u8 lo = mmu_read(cpu->gb, cpu->pc++);
-    u8 hi = mmu_read(cpu->gb, cpu->pc++);
+    u16 addr = mmu_fetch16(cpu);
 
-    if (cpu_get_flag(cpu, FLAG_CARRY)) {
-        cpu->pc = MAKE_U16(hi, lo);
+    if (cpu_flag_c(cpu)) {
+        cpu->pc = addr;
         return 16;
     }
     return 12;
@@ -2449,7 +1520,7 @@ u8 instr_jp_c_a16(CPU *cpu) {
 // None affected
 // ----------------------------------------------
 u8 instr_jr_e8(CPU *cpu) {
-    i8 offset = (i8)mmu_read(cpu->gb, cpu->pc++);
+    i8 offset = (i8)mmu_fetch8(cpu);
     cpu->pc += offset;
     return 12;
 }
@@ -2462,9 +1533,9 @@ u8 instr_jr_e8(CPU *cpu) {
 // None affected
 // ----------------------------------------------
 u8 instr_jr_nz_e8(CPU *cpu) {
-    i8 offset = (i8)mmu_read(cpu->gb, cpu->pc++);
+    i8 offset = (i8)mmu_fetch8(cpu);
 
-    if (!cpu_get_flag(cpu, FLAG_ZERO)) {
+    if (!cpu_flag_z(cpu)) {
         cpu->pc += offset;
         return 12;
     }
@@ -2473,9 +1544,9 @@ u8 instr_jr_nz_e8(CPU *cpu) {
 }
 
 u8 instr_jr_z_e8(CPU *cpu) {
-    i8 offset = (i8)mmu_read(cpu->gb, cpu->pc++);
+    i8 offset = (i8)mmu_fetch8(cpu);
 
-    if (cpu_get_flag(cpu, FLAG_ZERO)) {
+    if (cpu_flag_z(cpu)) {
         cpu->pc += offset;
         return 12;
     }
@@ -2484,9 +1555,9 @@ u8 instr_jr_z_e8(CPU *cpu) {
 }
 
 u8 instr_jr_nc_e8(CPU *cpu) {
-    i8 offset = (i8)mmu_read(cpu->gb, cpu->pc++);
+    i8 offset = (i8)mmu_fetch8(cpu);
 
-    if (!cpu_get_flag(cpu, FLAG_CARRY)) {
+    if (!cpu_flag_c(cpu)) {
         cpu->pc += offset;
         return 12;
     }
@@ -2495,9 +1566,9 @@ u8 instr_jr_nc_e8(CPU *cpu) {
 }
 
 u8 instr_jr_c_e8(CPU *cpu) {
-    i8 offset = (i8)mmu_read(cpu->gb, cpu->pc++);
+    i8 offset = (i8)mmu_fetch8(cpu);
 
-    if (cpu_get_flag(cpu, FLAG_CARRY)) {
+    if (cpu_flag_c(cpu)) {
         cpu->pc += offset;
         return 12;
     }
@@ -2511,15 +1582,10 @@ u8 instr_jr_c_e8(CPU *cpu) {
 // None affected
 // ----------------------------------------------
 u8 instr_call_a16(CPU *cpu) {
-    u8  lo   = mmu_read(cpu->gb, cpu->pc++);
-    u8  hi   = mmu_read(cpu->gb, cpu->pc++);
-    u16 addr = MAKE_U16(hi, lo);
+    u16 addr = mmu_fetch16(cpu);
 
     // Push return address onto stack
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    mmu_push16(cpu, cpu->pc);
 
     // Update the pc
     cpu->pc = addr;
@@ -2534,15 +1600,10 @@ u8 instr_call_a16(CPU *cpu) {
 // None affected
 // ----------------------------------------------
 u8 instr_call_nz_a16(CPU *cpu) {
-    u8  lo   = mmu_read(cpu->gb, cpu->pc++);
-    u8  hi   = mmu_read(cpu->gb, cpu->pc++);
-    u16 addr = MAKE_U16(hi, lo);
+    u16 addr = mmu_fetch16(cpu);
 
-    if (!cpu_get_flag(cpu, FLAG_ZERO)) {
-        cpu->sp--;
-        mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-        cpu->sp--;
-        mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    if (!cpu_flag_z(cpu)) {
+        mmu_push16(cpu, cpu->pc);
 
         cpu->pc = addr;
         return 24;
@@ -2551,15 +1612,10 @@ u8 instr_call_nz_a16(CPU *cpu) {
 }
 
 u8 instr_call_z_a16(CPU *cpu) {
-    u8  lo   = mmu_read(cpu->gb, cpu->pc++);
-    u8  hi   = mmu_read(cpu->gb, cpu->pc++);
-    u16 addr = MAKE_U16(hi, lo);
+    u16 addr = mmu_fetch16(cpu);
 
-    if (cpu_get_flag(cpu, FLAG_ZERO)) {
-        cpu->sp--;
-        mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-        cpu->sp--;
-        mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    if (cpu_flag_z(cpu)) {
+        mmu_push16(cpu, cpu->pc);
 
         cpu->pc = addr;
         return 24;
@@ -2568,15 +1624,10 @@ u8 instr_call_z_a16(CPU *cpu) {
 }
 
 u8 instr_call_nc_a16(CPU *cpu) {
-    u8  lo   = mmu_read(cpu->gb, cpu->pc++);
-    u8  hi   = mmu_read(cpu->gb, cpu->pc++);
-    u16 addr = MAKE_U16(hi, lo);
+    u16 addr = mmu_fetch16(cpu);
 
-    if (!cpu_get_flag(cpu, FLAG_CARRY)) {
-        cpu->sp--;
-        mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-        cpu->sp--;
-        mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    if (!cpu_flag_c(cpu)) {
+        mmu_push16(cpu, cpu->pc);
 
         cpu->pc = addr;
         return 24;
@@ -2585,15 +1636,10 @@ u8 instr_call_nc_a16(CPU *cpu) {
 }
 
 u8 instr_call_c_a16(CPU *cpu) {
-    u8  lo   = mmu_read(cpu->gb, cpu->pc++);
-    u8  hi   = mmu_read(cpu->gb, cpu->pc++);
-    u16 addr = MAKE_U16(hi, lo);
+    u16 addr = mmu_fetch16(cpu);
 
-    if (cpu_get_flag(cpu, FLAG_CARRY)) {
-        cpu->sp--;
-        mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-        cpu->sp--;
-        mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    if (cpu_flag_c(cpu)) {
+        mmu_push16(cpu, cpu->pc);
 
         cpu->pc = addr;
         return 24;
@@ -2607,10 +1653,7 @@ u8 instr_call_c_a16(CPU *cpu) {
 // None affected
 // ----------------------------------------------
 u8 instr_ret(CPU *cpu) {
-    u8 lo   = mmu_read(cpu->gb, cpu->pc++);
-    u8 hi   = mmu_read(cpu->gb, cpu->pc++);
-
-    cpu->pc = MAKE_U16(hi, lo);
+    cpu->pc = mmu_pop16(cpu);
     return 16;
 }
 
@@ -2622,40 +1665,32 @@ u8 instr_ret(CPU *cpu) {
 // None affected
 // ----------------------------------------------
 u8 instr_ret_nz(CPU *cpu) {
-    if (!cpu_get_flag(cpu, FLAG_ZERO)) {
-        u8 lo   = mmu_read(cpu->gb, cpu->sp++);
-        u8 hi   = mmu_read(cpu->gb, cpu->sp++);
-        cpu->pc = MAKE_U16(hi, lo);
+    if (!cpu_flag_z(cpu)) {
+        cpu->pc = mmu_pop16(cpu);
         return 20;
     }
     return 8;
 }
 
 u8 instr_ret_z(CPU *cpu) {
-    if (cpu_get_flag(cpu, FLAG_ZERO)) {
-        u8 lo   = mmu_read(cpu->gb, cpu->sp++);
-        u8 hi   = mmu_read(cpu->gb, cpu->sp++);
-        cpu->pc = MAKE_U16(hi, lo);
+    if (cpu_flag_z(cpu)) {
+        cpu->pc = mmu_pop16(cpu);
         return 20;
     }
     return 8;
 }
 
 u8 instr_ret_nc(CPU *cpu) {
-    if (!cpu_get_flag(cpu, FLAG_CARRY)) {
-        u8 lo   = mmu_read(cpu->gb, cpu->sp++);
-        u8 hi   = mmu_read(cpu->gb, cpu->sp++);
-        cpu->pc = MAKE_U16(hi, lo);
+    if (!cpu_flag_c(cpu)) {
+        cpu->pc = mmu_pop16(cpu);
         return 20;
     }
     return 8;
 }
 
 u8 instr_ret_c(CPU *cpu) {
-    if (cpu_get_flag(cpu, FLAG_CARRY)) {
-        u8 lo   = mmu_read(cpu->gb, cpu->sp++);
-        u8 hi   = mmu_read(cpu->gb, cpu->sp++);
-        cpu->pc = MAKE_U16(hi, lo);
+    if (cpu_flag_c(cpu)) {
+        cpu->pc = mmu_pop16(cpu);
         return 20;
     }
     return 8;
@@ -2663,10 +1698,9 @@ u8 instr_ret_c(CPU *cpu) {
 
 // Return from subroutine & enable interrupts
 u8 instr_reti(CPU *cpu) {
-    u8 lo    = mmu_read(cpu->gb, cpu->sp++);
-    u8 hi    = mmu_read(cpu->gb, cpu->sp++);
-    cpu->pc  = MAKE_U16(hi, lo);
-    cpu->ime = true;
+    cpu->pc  = mmu_pop16(cpu);
+    cpu->ime = true; // No delay, unlike EI
+    cpu_irq_update(cpu);
     return 16;
 }
 
@@ -2687,7 +1721,7 @@ u8 instr_rlca(CPU *cpu) {
 
     cpu->regs.a = (a << 1) | carry;
 
-    cpu->regs.f = 0;
+    cpu_flags_write(cpu, 0);
     if (carry)
         cpu->regs.f |= FLAG_CARRY;
 
@@ -2706,7 +1740,7 @@ u8 instr_rrca(CPU *cpu) {
 
     cpu->regs.a = (a >> 1) | (carry << 7);
 
-    cpu->regs.f = 0;
+    cpu_flags_write(cpu, 0);
     if (carry)
         cpu->regs.f |= FLAG_CARRY;
 
@@ -2721,12 +1755,12 @@ u8 instr_rrca(CPU *cpu) {
 // ----------------------------------------------
 u8 instr_rla(CPU *cpu) {
     u8 a         = cpu->regs.a;
-    u8 old_carry = cpu_get_flag(cpu, FLAG_CARRY);
+    u8 old_carry = cpu_flag_c(cpu);
     u8 new_carry = CHECK_BIT(a, 7);
 
     cpu->regs.a  = (a << 1) | old_carry;
 
-    cpu->regs.f  = 0;
+    cpu_flags_write(cpu, 0);
     if (new_carry)
         cpu->regs.f |= FLAG_CARRY;
 
@@ -2741,12 +1775,12 @@ u8 instr_rla(CPU *cpu) {
 // ----------------------------------------------
 u8 instr_rra(CPU *cpu) {
     u8 a         = cpu->regs.a;
-    u8 old_carry = cpu_get_flag(cpu, FLAG_CARRY);
+    u8 old_carry = cpu_flag_c(cpu);
     u8 new_carry = CHECK_BIT(a, 7);
 
     cpu->regs.a  = (a >> 1) | (old_carry << 7);
 
-    cpu->regs.f  = 0;
+    cpu_flags_write(cpu, 0);
     if (new_carry)
         cpu->regs.f |= FLAG_CARRY;
 
@@ -2758,6 +1792,7 @@ u8 instr_rra(CPU *cpu) {
 // Flags:
 // N = H = 1
 u8 instr_cpl(CPU *cpu) {
+    cpu_flags_sync(cpu);
     cpu->regs.a ^= 0xFF;
     cpu->regs.f |= FLAG_SUBT | FLAG_HF_CARRY;
     return 4;
@@ -2768,6 +1803,7 @@ u8 instr_cpl(CPU *cpu) {
 // N = H = 0
 // C = 1
 u8 instr_scf(CPU *cpu) {
+    cpu_flags_sync(cpu);
     cpu->regs.f &= FLAG_ZERO;  // Preserve Z
     cpu->regs.f |= FLAG_CARRY; // Set C
     return 4;
@@ -2779,7 +1815,8 @@ u8 instr_scf(CPU *cpu) {
 // N = H = 0
 // C = inverted
 u8 instr_ccf(CPU *cpu) {
-    bool carry = cpu_get_flag(cpu, FLAG_CARRY);
+    cpu_flags_sync(cpu);
+    bool carry = cpu_flag_c(cpu);
 
     cpu->regs.f &= FLAG_ZERO;
     if (!carry)
@@ -2795,27 +1832,6 @@ u8 instr_ccf(CPU *cpu) {
 // Exact behavior of this instruction depends on N flag
 // https://rgbds.gbdev.io/docs/v1.0.1/gbz80.7#DAA
 u8 instr_daa(CPU *cpu) {
-    u8   a      = cpu->regs.a;
-
-    bool sub    = cpu_get_flag(cpu, FLAG_SUBT);
-    bool half   = cpu_get_flag(cpu, FLAG_HF_CARRY);
-    bool carry  = cpu_get_flag(cpu, FLAG_CARRY);
-
-    u8   result = adjust_bcd(a, sub, carry, half);
-
-    // Update flags
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (sub)
-        cpu->regs.f |= FLAG_SUBT;
-
-    // Carry is set if we corrected with 0x60
-    if (!sub && (carry || a > 0x99))
-        cpu->regs.f |= FLAG_CARRY;
-    if (sub && carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
+    cpu->regs.a = alu_daa(cpu, cpu->regs.a);
     return 4;
 }
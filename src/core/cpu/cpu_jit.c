@@ -0,0 +1,751 @@
+// src/core/cpu/cpu_jit.c
+#include <core/cpu/cpu_jit.h>
+#include <core/cpu/cpu_alu.h>
+#include <core/cpu/cpu_exec.h>
+#include <core/bus.h>
+#include <gbemu.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+u32 cpu_jit_epoch = 1;
+
+// ---------------------------------------------
+// Run translated code
+// Handlers called from native code must leave regs.f up to date, so the
+// CPU runs with eager flags for the duration of the block
+// ---------------------------------------------
+u32 cpu_jit_run(CPU *cpu, CpuNativeFunc native) {
+    bool lazy = cpu->lazy_flags;
+
+    cpu_flags_sync(cpu);
+    cpu->lazy_flags       = false;
+    cpu->gb->blocks.stale = false;
+
+    u32 cycles            = native(cpu);
+
+    cpu->lazy_flags       = lazy;
+    return cycles;
+}
+
+#ifdef CPU_JIT
+
+#include <sys/mman.h>
+
+// ============================================================================
+// NOTE: Code Buffer
+// One executable buffer per process, shared by every GameBoy instance.
+// When it fills up it is recycled and cpu_jit_epoch is bumped, which
+// invalidates every translated block at once. Not thread-safe.
+// ============================================================================
+#define JIT_BUFFER_SIZE (4u << 20) // 4 MB
+#define JIT_BLOCK_MAX   8192       // Upper bound for one translated block
+
+static u8    *jit_buffer = NULL;
+static size_t jit_used   = 0;
+static bool   jit_failed = false;
+
+static bool jit_buffer_init(void) {
+    if (jit_buffer != NULL)
+        return true;
+    if (jit_failed)
+        return false;
+
+    void *mem = mmap(NULL, JIT_BUFFER_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) {
+        jit_failed = true; // W^X systems: stay on the interpreter
+        return false;
+    }
+
+    jit_buffer = mem;
+    return true;
+}
+
+bool cpu_jit_available(void) {
+    return jit_buffer_init();
+}
+
+// ============================================================================
+// NOTE: x86-64 Emitter
+// Only the encodings the translator needs. Host register assignment (all
+// callee-saved, so they survive calls into C):
+//   rbx = CPU *     r12 = AF (A << 8 | F)    r13 = BC    r14 = DE
+//   rbp = SP        r15 = HL
+// Pairs are kept zero-extended to 32 bits. eax/ecx/edx/esi/edi are scratch.
+// [rsp] holds the cycles returned by handlers called from the block,
+// [rsp + 4] cpu->run_cycles on entry.
+// ============================================================================
+enum {
+    RAX = 0,
+    RCX = 1,
+    RDX = 2,
+    RBX = 3,
+    RBP = 5,
+    RSI = 6,
+    RDI = 7,
+    R12 = 12,
+    R13 = 13,
+    R14 = 14,
+    R15 = 15,
+};
+
+#define HOST_CPU RBX
+#define HOST_SP  RBP
+
+#define JIT_MAX_EXITS (2 * CPU_BLOCK_MAX_INSTRS + 1)
+
+typedef struct {
+    u8    *code;
+    size_t len;
+    size_t exits[JIT_MAX_EXITS]; // rel32 fields that jump to the epilogue
+    int    exit_count;
+    u32    instr_cycles; // Inline cycles before the instruction being translated
+} Emitter;
+
+// GB register operand (opcode bits: B, C, D, E, H, L, (HL), A) -> host pair & half
+typedef struct {
+    u8   host;
+    bool high;
+} HostReg;
+
+static const HostReg host_regs[8] = {
+    {R13, true}, {R13, false}, {R14, true}, {R14, false},
+    {R15, true}, {R15, false}, {0, false},  {R12, true},
+};
+
+// BC, DE, HL, SP (opcode bits 4-5)
+static const u8 host_pairs[4] = {R13, R14, R15, HOST_SP};
+
+static void emit8(Emitter *e, u8 byte) {
+    e->code[e->len++] = byte;
+}
+
+static void emit16(Emitter *e, u16 value) {
+    memcpy(e->code + e->len, &value, 2);
+    e->len += 2;
+}
+
+static void emit32(Emitter *e, u32 value) {
+    memcpy(e->code + e->len, &value, 4);
+    e->len += 4;
+}
+
+static void emit64(Emitter *e, u64 value) {
+    memcpy(e->code + e->len, &value, 8);
+    e->len += 8;
+}
+
+static void emit_bytes(Emitter *e, const u8 *bytes, size_t count) {
+    memcpy(e->code + e->len, bytes, count);
+    e->len += count;
+}
+
+#define EMIT(e, ...)                                                                               \
+    do {                                                                                           \
+        static const u8 bytes_[] = {__VA_ARGS__};                                                  \
+        emit_bytes((e), bytes_, sizeof(bytes_));                                                   \
+    } while (0)
+
+static void emit_rex(Emitter *e, bool wide, int reg, int rm) {
+    u8 rex = 0x40 | (wide ? 0x08 : 0) | ((reg & 8) ? 0x04 : 0) | ((rm & 8) ? 0x01 : 0);
+    if (rex != 0x40)
+        emit8(e, rex);
+}
+
+// <op> rm, reg (register direct)
+static void emit_op_rr(Emitter *e, u8 op, bool wide, int reg, int rm) {
+    emit_rex(e, wide, reg, rm);
+    emit8(e, op);
+    emit8(e, 0xC0 | (reg & 7) << 3 | (rm & 7));
+}
+
+// <op> reg, [base + disp32] (base must not be rsp/r12)
+static void emit_op_mem(Emitter *e, const u8 *op, size_t op_len, bool wide, int reg, int base,
+                        u32 disp) {
+    emit_rex(e, wide, reg, base);
+    emit_bytes(e, op, op_len);
+    emit8(e, 0x80 | (reg & 7) << 3 | (base & 7));
+    emit32(e, disp);
+}
+
+static void emit_mov_rr(Emitter *e, int dst, int src) {
+    emit_op_rr(e, 0x89, false, src, dst);
+}
+
+// movzx dst32, src8 (src = al/cl/dl or r8b-r15b)
+static void emit_movzx8_rr(Emitter *e, int dst, int src) {
+    emit_rex(e, false, dst, src);
+    emit8(e, 0x0F);
+    emit8(e, 0xB6);
+    emit8(e, 0xC0 | (dst & 7) << 3 | (src & 7));
+}
+
+// <group-1 op> reg, imm (ext: 0 add, 1 or, 4 and, 5 sub, 7 cmp)
+static void emit_alu_imm(Emitter *e, int ext, int reg, u32 imm) {
+    emit_rex(e, false, 0, reg);
+    if (imm < 0x80) {
+        emit8(e, 0x83);
+        emit8(e, 0xC0 | ext << 3 | (reg & 7));
+        emit8(e, (u8)imm);
+    } else {
+        emit8(e, 0x81);
+        emit8(e, 0xC0 | ext << 3 | (reg & 7));
+        emit32(e, imm);
+    }
+}
+
+// shl/shr reg, imm (ext: 4 shl, 5 shr)
+static void emit_shift(Emitter *e, int ext, int reg, u8 count) {
+    emit_rex(e, false, 0, reg);
+    emit8(e, 0xC1);
+    emit8(e, 0xC0 | ext << 3 | (reg & 7));
+    emit8(e, count);
+}
+
+static void emit_mov_imm(Emitter *e, int reg, u32 imm) {
+    emit_rex(e, false, 0, reg);
+    emit8(e, 0xB8 + (reg & 7));
+    emit32(e, imm);
+}
+
+static void emit_call(Emitter *e, uintptr_t target) {
+    emit8(e, 0x48); // mov rax, imm64
+    emit8(e, 0xB8);
+    emit64(e, (u64)target);
+    EMIT(e, 0xFF, 0xD0); // call rax
+}
+
+// jcc rel32 / jmp rel32, returns the offset of the rel32 field
+static size_t emit_jump(Emitter *e, u8 cc) {
+    if (cc == 0) {
+        emit8(e, 0xE9);
+    } else {
+        emit8(e, 0x0F);
+        emit8(e, cc);
+    }
+    emit32(e, 0);
+    return e->len - 4;
+}
+
+#define JMP 0x00
+#define JZ  0x84
+#define JNZ 0x85
+
+// Point a rel32 field at the current position
+static void patch_jump(Emitter *e, size_t at) {
+    u32 rel = (u32)(e->len - (at + 4));
+    memcpy(e->code + at, &rel, 4);
+}
+
+// ---------------------------------------------
+// Guest state <-> host registers
+// ---------------------------------------------
+#define CPU_OFF(field) ((u32)offsetof(CPU, field))
+
+static void emit_load_pair(Emitter *e, int host, u32 hi, u32 lo) {
+    static const u8 movzx8[] = {0x0F, 0xB6};
+
+    emit_op_mem(e, movzx8, 2, false, host, HOST_CPU, hi);
+    emit_shift(e, 4, host, 8);
+    emit_op_mem(e, movzx8, 2, false, RCX, HOST_CPU, lo);
+    emit_op_rr(e, 0x09, false, RCX, host); // or host, ecx
+}
+
+static void emit_store_pair(Emitter *e, int host, u32 hi, u32 lo) {
+    static const u8 mov8[] = {0x88};
+
+    emit_op_mem(e, mov8, 1, false, host, HOST_CPU, lo);
+    emit_mov_rr(e, RCX, host);
+    emit_shift(e, 5, RCX, 8);
+    emit_op_mem(e, mov8, 1, false, RCX, HOST_CPU, hi);
+}
+
+static void emit_load_state(Emitter *e) {
+    static const u8 movzx16[] = {0x0F, 0xB7};
+
+    emit_load_pair(e, R12, CPU_OFF(regs.a), CPU_OFF(regs.f));
+    emit_load_pair(e, R13, CPU_OFF(regs.b), CPU_OFF(regs.c));
+    emit_load_pair(e, R14, CPU_OFF(regs.d), CPU_OFF(regs.e));
+    emit_load_pair(e, R15, CPU_OFF(regs.h), CPU_OFF(regs.l));
+    emit_op_mem(e, movzx16, 2, false, HOST_SP, HOST_CPU, CPU_OFF(sp));
+}
+
+// Clobbers ecx only
+static void emit_store_state(Emitter *e) {
+    static const u8 mov16[] = {0x89};
+
+    emit_store_pair(e, R12, CPU_OFF(regs.a), CPU_OFF(regs.f));
+    emit_store_pair(e, R13, CPU_OFF(regs.b), CPU_OFF(regs.c));
+    emit_store_pair(e, R14, CPU_OFF(regs.d), CPU_OFF(regs.e));
+    emit_store_pair(e, R15, CPU_OFF(regs.h), CPU_OFF(regs.l));
+    emit8(e, 0x66);
+    emit_op_mem(e, mov16, 1, false, HOST_SP, HOST_CPU, CPU_OFF(sp));
+}
+
+// eax = GB register `r` (zero-extended)
+static void emit_load_reg(Emitter *e, int r) {
+    HostReg reg = host_regs[r];
+    if (reg.high) {
+        emit_mov_rr(e, RAX, reg.host);
+        emit_shift(e, 5, RAX, 8);
+    } else {
+        emit_movzx8_rr(e, RAX, reg.host);
+    }
+}
+
+// GB register `r` = al (eax zero-extended)
+static void emit_store_reg(Emitter *e, int r) {
+    HostReg reg = host_regs[r];
+    if (reg.high) {
+        emit_alu_imm(e, 4, reg.host, 0xFF);
+        emit_shift(e, 4, RAX, 8);
+        emit_op_rr(e, 0x09, false, RAX, reg.host); // or host, eax
+    } else {
+        emit_op_rr(e, 0x88, false, RAX, reg.host); // mov host8, al
+    }
+}
+
+// ---------------------------------------------
+// Block exits
+// ---------------------------------------------
+#define EXIT_KEEP_PC (-1) // PC already set by a handler
+
+// Leave the block: set PC, return [rsp] + `cycles`
+static void emit_exit(Emitter *e, int pc, u32 cycles) {
+    if (pc != EXIT_KEEP_PC) {
+        emit8(e, 0x66); // mov word [rbx + pc], imm16
+        emit8(e, 0xC7);
+        emit8(e, 0x83);
+        emit32(e, CPU_OFF(pc));
+        emit16(e, (u16)pc);
+    }
+    EMIT(e, 0x8B, 0x04, 0x24); // mov eax, [rsp]
+    emit8(e, 0x05);            // add eax, imm32
+    emit32(e, cycles);
+
+    e->exits[e->exit_count++] = emit_jump(e, JMP);
+}
+
+// Leave the block if an IO write asked for it or remapped memory
+static void emit_exit_check(Emitter *e, int pc, u32 cycles) {
+    static const u8 cmp8[]  = {0x80};
+    static const u8 mov64[] = {0x8B};
+
+    emit_op_mem(e, cmp8, 1, false, 7, HOST_CPU, CPU_OFF(run_exit));
+    emit8(e, 0x00);
+    size_t to_exit = emit_jump(e, JNZ);
+
+    emit_op_mem(e, mov64, 1, true, RAX, HOST_CPU, CPU_OFF(gb));
+    emit_op_mem(e, cmp8, 1, false, 7, RAX, (u32)offsetof(GameBoy, blocks.stale));
+    emit8(e, 0x00);
+    size_t to_next = emit_jump(e, JZ);
+
+    patch_jump(e, to_exit);
+    emit_exit(e, pc, cycles);
+    patch_jump(e, to_next);
+}
+
+// Publish the time of the current instruction before calling into C
+// cpu->run_cycles = entry value + handler cycles + inline cycles (clobbers eax)
+static void emit_publish_cycles(Emitter *e) {
+    static const u8 mov32[] = {0x89};
+
+    EMIT(e, 0x8B, 0x04, 0x24);       // mov eax, [rsp]
+    EMIT(e, 0x03, 0x44, 0x24, 0x04); // add eax, [rsp + 4]
+    emit8(e, 0x05);                  // add eax, imm32
+    emit32(e, e->instr_cycles);
+    emit_op_mem(e, mov32, 1, false, RAX, HOST_CPU, CPU_OFF(run_cycles));
+}
+
+// ---------------------------------------------
+// Memory at (HL)
+// Direct load/store through the page map, bus.c slow path otherwise
+// ---------------------------------------------
+
+// rsi = gb, rdx = map[H] (flags set by test rdx, rdx)
+static void emit_map_lookup(Emitter *e, u32 map_offset) {
+    static const u8 mov64[] = {0x8B};
+
+    emit_op_mem(e, mov64, 1, true, RSI, HOST_CPU, CPU_OFF(gb));
+    emit_mov_rr(e, RAX, R15);
+    emit_shift(e, 5, RAX, 8);
+    EMIT(e, 0x48, 0x8B, 0x94, 0xC6); // mov rdx, [rsi + rax * 8 + disp32]
+    emit32(e, map_offset);
+    EMIT(e, 0x48, 0x85, 0xD2); // test rdx, rdx
+}
+
+// eax = [HL]
+static void emit_read_hl(Emitter *e) {
+    emit_map_lookup(e, (u32)offsetof(GameBoy, read_map));
+    size_t to_slow = emit_jump(e, JZ);
+
+    emit_movzx8_rr(e, RCX, R15);
+    EMIT(e, 0x0F, 0xB6, 0x04, 0x0A); // movzx eax, byte [rdx + rcx]
+    size_t to_done = emit_jump(e, JMP);
+
+    patch_jump(e, to_slow);
+    emit_publish_cycles(e);
+    EMIT(e, 0x48, 0x89, 0xF7); // mov rdi, rsi
+    emit_mov_rr(e, RSI, R15);
+    emit_call(e, (uintptr_t)mmu_read_slow);
+    emit_movzx8_rr(e, RAX, RAX);
+
+    patch_jump(e, to_done);
+}
+
+// [HL] = cl, then exit with `pc`/`cycles` if the write needs the dispatcher
+static void emit_write_hl(Emitter *e, int pc, u32 cycles) {
+    emit_map_lookup(e, (u32)offsetof(GameBoy, write_map));
+    size_t to_slow = emit_jump(e, JZ);
+
+    emit_movzx8_rr(e, RAX, R15);
+    EMIT(e, 0x88, 0x0C, 0x02); // mov [rdx + rax], cl
+    size_t to_done = emit_jump(e, JMP);
+
+    patch_jump(e, to_slow);
+    emit_publish_cycles(e);
+    EMIT(e, 0x48, 0x89, 0xF7); // mov rdi, rsi
+    emit_mov_rr(e, RSI, R15);
+    emit_mov_rr(e, RDX, RCX);
+    emit_call(e, (uintptr_t)mmu_write_slow);
+    emit_exit_check(e, pc, cycles);
+
+    patch_jump(e, to_done);
+}
+
+// ---------------------------------------------
+// Flags
+// x86 lahf: AH = S Z 0 A 0 P 1 C, the AF (nibble carry / borrow) matches H
+// ---------------------------------------------
+
+// ADD/ADC/SUB/SBC/CP: F = Z H C (+ N)
+static void emit_flags_arith(Emitter *e, bool sub) {
+    EMIT(e, 0x9F);             // lahf
+    EMIT(e, 0x0F, 0xB6, 0xD4); // movzx edx, ah
+    emit_mov_rr(e, RCX, RDX);
+    emit_alu_imm(e, 4, RCX, 0x50);          // Z, A
+    emit_op_rr(e, 0x01, false, RCX, RCX);   // -> bits 7, 5
+    emit_alu_imm(e, 4, RDX, 0x01);          // C
+    emit_shift(e, 4, RDX, 4);               // -> bit 4
+    emit_op_rr(e, 0x09, false, RDX, RCX);
+    if (sub)
+        emit_alu_imm(e, 1, RCX, FLAG_SUBT);
+    emit_op_rr(e, 0x88, false, RCX, R12); // mov r12b, cl
+}
+
+// AND/OR/XOR: F = Z (+ H for AND)
+static void emit_flags_logic(Emitter *e, bool half) {
+    EMIT(e, 0x9F);             // lahf
+    EMIT(e, 0x0F, 0xB6, 0xCC); // movzx ecx, ah
+    emit_alu_imm(e, 4, RCX, 0x40);
+    emit_op_rr(e, 0x01, false, RCX, RCX);
+    if (half)
+        emit_alu_imm(e, 1, RCX, FLAG_HF_CARRY);
+    emit_op_rr(e, 0x88, false, RCX, R12);
+}
+
+// INC/DEC r8: F = Z H (+ N), C preserved
+static void emit_flags_incdec(Emitter *e, bool dec) {
+    EMIT(e, 0x9F);             // lahf
+    EMIT(e, 0x0F, 0xB6, 0xD4); // movzx edx, ah
+    emit_alu_imm(e, 4, RDX, 0x50);
+    emit_op_rr(e, 0x01, false, RDX, RDX);
+    if (dec)
+        emit_alu_imm(e, 1, RDX, FLAG_SUBT);
+    emit_mov_rr(e, RCX, R12);
+    emit_alu_imm(e, 4, RCX, FLAG_CARRY);
+    emit_op_rr(e, 0x09, false, RDX, RCX);
+    emit_op_rr(e, 0x88, false, RCX, R12);
+}
+
+// A = A <op> cl (op = opcode bits 3-5: ADD ADC SUB SBC AND XOR OR CP)
+static void emit_alu(Emitter *e, int op) {
+    static const u8 alu8[8] = {0x00, 0x10, 0x28, 0x18, 0x20, 0x30, 0x08, 0x38}; // <op> al, cl
+
+    emit_load_reg(e, 7);
+    if (op == 1 || op == 3)
+        EMIT(e, 0x41, 0x0F, 0xBA, 0xE4, 0x04); // bt r12d, 4: CF = GB carry
+    emit8(e, alu8[op]);
+    emit8(e, 0xC8);
+
+    if (op <= 3 || op == 7)
+        emit_flags_arith(e, op >= 2);
+    else
+        emit_flags_logic(e, op == 4);
+
+    if (op != 7) {
+        emit_movzx8_rr(e, RAX, RAX);
+        emit_store_reg(e, 7);
+    }
+}
+
+// ============================================================================
+// NOTE: Translation
+// ============================================================================
+
+// Cycles of an instruction the translator emits inline, 0 = call the handler
+static u8 jit_native_cycles(u8 opcode) {
+    if (opcode == 0x00)
+        return 4; // NOP
+    if (opcode >= 0x40 && opcode < 0x80 && opcode != 0x76)
+        return ((opcode & 0x07) == 6 || (opcode & 0x38) == 0x30) ? 8 : 4; // LD r, r'
+    if (opcode >= 0x80 && opcode < 0xC0)
+        return ((opcode & 0x07) == 6) ? 8 : 4; // ALU A, r
+
+    if (opcode < 0x40) {
+        switch (opcode & 0xC7) {
+            case 0x06:
+                return (opcode == 0x36) ? 12 : 8; // LD r, n
+            case 0x04:
+            case 0x05:
+                return (opcode == 0x34 || opcode == 0x35) ? 0 : 4; // INC/DEC r
+        }
+        switch (opcode & 0xCF) {
+            case 0x01:
+                return 12; // LD rr, nn
+            case 0x03:
+            case 0x0B:
+                return 8; // INC/DEC rr
+        }
+        return 0;
+    }
+
+    return ((opcode & 0xC7) == 0xC6) ? 8 : 0; // ALU A, n
+}
+
+// Emit an inline instruction. `imm` points at its immediates, `pc`/`cycles`
+// describe the state after it (used by exits from the (HL) write slow path)
+static void emit_native(Emitter *e, u8 opcode, const u8 *imm, u16 pc, u32 cycles) {
+    int dst = (opcode >> 3) & 0x07;
+    int src = opcode & 0x07;
+
+    if (opcode == 0x00)
+        return;
+
+    // LD r, r' / LD r, (HL) / LD (HL), r
+    if (opcode >= 0x40 && opcode < 0x80) {
+        if (src == 6) {
+            emit_read_hl(e);
+            emit_store_reg(e, dst);
+        } else if (dst == 6) {
+            emit_load_reg(e, src);
+            emit_mov_rr(e, RCX, RAX);
+            emit_write_hl(e, pc, cycles);
+        } else if (dst != src) {
+            emit_load_reg(e, src);
+            emit_store_reg(e, dst);
+        }
+        return;
+    }
+
+    // ALU A, r / ALU A, (HL)
+    if (opcode >= 0x80 && opcode < 0xC0) {
+        if (src == 6)
+            emit_read_hl(e);
+        else
+            emit_load_reg(e, src);
+        emit_mov_rr(e, RCX, RAX);
+        emit_alu(e, dst);
+        return;
+    }
+
+    // ALU A, n
+    if (opcode >= 0xC0) {
+        emit_mov_imm(e, RCX, imm[0]);
+        emit_alu(e, dst);
+        return;
+    }
+
+    switch (opcode & 0xC7) {
+        case 0x06: // LD r, n / LD (HL), n
+            if (dst == 6) {
+                emit_mov_imm(e, RCX, imm[0]);
+                emit_write_hl(e, pc, cycles);
+            } else {
+                emit_mov_imm(e, RAX, imm[0]);
+                emit_store_reg(e, dst);
+            }
+            return;
+        case 0x04: // INC r
+        case 0x05: // DEC r
+            emit_load_reg(e, dst);
+            EMIT(e, 0xFE); // inc/dec al
+            emit8(e, (opcode & 0x01) ? 0xC8 : 0xC0);
+            emit_flags_incdec(e, opcode & 0x01);
+            emit_movzx8_rr(e, RAX, RAX);
+            emit_store_reg(e, dst);
+            return;
+    }
+
+    int pair = host_pairs[(opcode >> 4) & 0x03];
+    switch (opcode & 0xCF) {
+        case 0x01: // LD rr, nn
+            emit_mov_imm(e, pair, MAKE_U16(imm[1], imm[0]));
+            return;
+        case 0x03: // INC rr (16-bit, upper half stays zero)
+        case 0x0B: // DEC rr
+            emit8(e, 0x66);
+            emit_rex(e, false, 0, pair);
+            emit8(e, 0xFF);
+            emit8(e, ((opcode & 0x08) ? 0xC8 : 0xC0) | (pair & 7));
+            return;
+    }
+}
+
+// JR / JR cc / JP / JP cc ending the block: exit to the target or to `next`
+// Returns false for any other opcode
+static bool emit_branch(Emitter *e, u8 opcode, const u8 *imm, u16 next, u32 cycles) {
+    u16  target;
+    u8   taken, not_taken;
+    bool conditional;
+
+    switch (opcode) {
+        case 0x18:
+        case 0x20:
+        case 0x28:
+        case 0x30:
+        case 0x38:
+            target      = next + (i8)imm[0];
+            taken       = 12;
+            not_taken   = 8;
+            conditional = (opcode != 0x18);
+            break;
+        case 0xC2:
+        case 0xC3:
+        case 0xCA:
+        case 0xD2:
+        case 0xDA:
+            target      = MAKE_U16(imm[1], imm[0]);
+            taken       = 16;
+            not_taken   = 12;
+            conditional = (opcode != 0xC3);
+            break;
+        default:
+            return false;
+    }
+
+    if (!conditional) {
+        emit_exit(e, target, cycles + taken);
+        return true;
+    }
+
+    // cc = NZ, Z, NC, C
+    int cc = (opcode >> 3) & 0x03;
+    emit_rex(e, false, 0, R12); // test r12d, flag
+    emit8(e, 0xF7);
+    emit8(e, 0xC0 | (R12 & 7));
+    emit32(e, (cc < 2) ? FLAG_ZERO : FLAG_CARRY);
+
+    size_t to_next = emit_jump(e, (cc & 1) ? JZ : JNZ);
+    emit_exit(e, target, cycles + taken);
+    patch_jump(e, to_next);
+    emit_exit(e, next, cycles + not_taken);
+    return true;
+}
+
+// Call the interpreter handler for the instruction at `pc`
+static void emit_callout(Emitter *e, InstrFunc handler, u16 pc) {
+    emit_publish_cycles(e);
+    emit_store_state(e);
+    emit8(e, 0x66); // mov word [rbx + pc], imm16 (past the opcode)
+    emit8(e, 0xC7);
+    emit8(e, 0x83);
+    emit32(e, CPU_OFF(pc));
+    emit16(e, (u16)(pc + 1));
+
+    EMIT(e, 0x48, 0x89, 0xDF); // mov rdi, rbx
+    emit_call(e, (uintptr_t)handler);
+    emit_movzx8_rr(e, RAX, RAX);
+    EMIT(e, 0x01, 0x04, 0x24); // add [rsp], eax
+    emit_load_state(e);
+}
+
+static void emit_prologue(Emitter *e) {
+    static const u8 load32[] = {0x8B};
+
+    EMIT(e, 0x53, 0x55, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x41, 0x57); // push rbx .. r15
+    EMIT(e, 0x48, 0x83, 0xEC, 0x08);                                     // sub rsp, 8
+    EMIT(e, 0x48, 0x89, 0xFB);                                           // mov rbx, rdi
+    EMIT(e, 0xC7, 0x04, 0x24, 0x00, 0x00, 0x00, 0x00);                   // mov dword [rsp], 0
+
+    emit_op_mem(e, load32, 1, false, RAX, HOST_CPU, CPU_OFF(run_cycles));
+    EMIT(e, 0x89, 0x44, 0x24, 0x04); // mov [rsp + 4], eax
+    emit_load_state(e);
+}
+
+// Every exit jumps here with the cycles in eax
+static void emit_epilogue(Emitter *e) {
+    for (int i = 0; i < e->exit_count; i++)
+        patch_jump(e, e->exits[i]);
+
+    emit_store_state(e);
+    EMIT(e, 0x48, 0x83, 0xC4, 0x08);                                     // add rsp, 8
+    EMIT(e, 0x41, 0x5F, 0x41, 0x5E, 0x41, 0x5D, 0x41, 0x5C, 0x5D, 0x5B); // pop r15 .. rbx
+    EMIT(e, 0xC3);                                                       // ret
+}
+
+CpuNativeFunc cpu_jit_compile(CpuBlock *block) {
+    if (block->pc >= 0x8000 || !jit_buffer_init())
+        return NULL; // RAM code stays on the interpreter
+
+    if (jit_used + JIT_BLOCK_MAX > JIT_BUFFER_SIZE) {
+        jit_used = 0;
+        if (++cpu_jit_epoch == CPU_AOT_EPOCH)
+            cpu_jit_epoch++;
+    }
+
+    Emitter e = {.code = jit_buffer + jit_used};
+    emit_prologue(&e);
+
+    const u8 *code   = block->ptr;
+    u16       pos    = 0;
+    u32       cycles = 0; // Cycles of inline instructions so far
+    bool      ended  = false;
+
+    for (u8 i = 0; i < block->count; i++) {
+        u8  opcode = code[pos];
+        u8  native = jit_native_cycles(opcode);
+        u16 pc     = block->pc + pos;
+        u16 next   = pc + cpu_instr_length(opcode);
+
+        e.instr_cycles = cycles;
+        if (native != 0) {
+            cycles += native;
+            emit_native(&e, opcode, code + pos + 1, next, cycles);
+        } else if (emit_branch(&e, opcode, code + pos + 1, next, cycles)) {
+            ended = true;
+        } else {
+            emit_callout(&e, block->instrs[i], pc);
+            if (cpu_instr_ends_block(opcode)) {
+                emit_exit(&e, EXIT_KEEP_PC, cycles);
+                ended = true;
+            } else {
+                emit_exit_check(&e, EXIT_KEEP_PC, cycles);
+            }
+        }
+        pos = next - block->pc;
+    }
+
+    if (!ended)
+        emit_exit(&e, block->pc + pos, cycles);
+    emit_epilogue(&e);
+
+    jit_used            = (jit_used + e.len + 15) & ~(size_t)15;
+    block->native       = (CpuNativeFunc)(uintptr_t)e.code;
+    block->native_epoch = cpu_jit_epoch;
+    return block->native;
+}
+
+#else
+
+bool cpu_jit_available(void) {
+    return false;
+}
+
+CpuNativeFunc cpu_jit_compile(CpuBlock *block) {
+    (void)block;
+    return NULL; // Built without CPU_JIT: interpret
+}
+
+#endif // CPU_JIT
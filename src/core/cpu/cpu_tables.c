@@ -1,303 +1,20 @@
 // src/core/cpu/cpu_tables.c
 #include <core/cpu/cpu.h>
+#include <core/cpu/cpu_block.h>
 #include <core/cpu/cpu_exec.h>
+#include <core/cpu/cpu_jit.h>
+#include <core/cpu/cpu_opcodes.h>
 #include <core/bus.h>
 #include <gbemu.h>
 #include <stdio.h>
 
 // ---------------------------------------------
 // Instruction table (256 entries)
-// https://www.pastraiser.com/cpu/gameboy/gameboy_opcodes.html
 // ---------------------------------------------
-static const InstrFunc instr_table[256] = {
-    // 0x0_
-    [0x00] = instr_nop,
-    [0x01] = instr_ld_bc_nn,
-    [0x02] = instr_ld_mem_bc_a,
-    [0x03] = instr_inc_bc,
-    [0x04] = instr_inc_b,
-    [0x05] = instr_dec_b,
-    [0x06] = instr_ld_b_n,
-    [0x07] = instr_rlca,
-    [0x08] = instr_ld_mem_a16_sp,
-    [0x09] = instr_add_hl_bc,
-    [0x0A] = instr_ld_a_mem_bc,
-    [0x0B] = instr_dec_bc,
-    [0x0C] = instr_inc_c,
-    [0x0D] = instr_dec_c,
-    [0x0E] = instr_ld_c_n,
-    [0x0F] = instr_rrca,
-
-    // 0x1_
-    [0x10] = instr_stop,
-    [0x11] = instr_ld_de_nn,
-    [0x12] = instr_ld_mem_de_a,
-    [0x13] = instr_inc_de,
-    [0x14] = instr_inc_d,
-    [0x15] = instr_dec_d,
-    [0x16] = instr_ld_d_n,
-    [0x17] = instr_rla,
-    [0x18] = instr_jr_e8,
-    [0x19] = instr_add_hl_de,
-    [0x1A] = instr_ld_a_mem_de,
-    [0x1B] = instr_dec_de,
-    [0x1C] = instr_inc_e,
-    [0x1D] = instr_dec_e,
-    [0x1E] = instr_ld_e_n,
-    [0x1F] = instr_rra,
-
-    // 0x2_
-    [0x20] = instr_jr_nz_e8,
-    [0x21] = instr_ld_hl_nn,
-    [0x22] = instr_ld_mem_hli_a,
-    [0x23] = instr_inc_hl,
-    [0x24] = instr_inc_h,
-    [0x25] = instr_dec_h,
-    [0x26] = instr_ld_h_n,
-    [0x27] = instr_daa,
-    [0x28] = instr_jr_z_e8,
-    [0x29] = instr_add_hl_hl,
-    [0x2A] = instr_ld_a_mem_hli,
-    [0x2B] = instr_dec_hl,
-    [0x2C] = instr_inc_l,
-    [0x2D] = instr_dec_l,
-    [0x2E] = instr_ld_l_n,
-    [0x2F] = instr_cpl,
-
-    // 0x3_
-    [0x30] = instr_jr_nc_e8,
-    [0x31] = instr_ld_sp_nn,
-    [0x32] = instr_ld_mem_hld_a,
-    [0x33] = instr_inc_sp,
-    [0x34] = instr_inc_mem_hl,
-    [0x35] = instr_dec_mem_hl,
-    [0x36] = instr_ld_mem_hl_n,
-    [0x37] = instr_scf,
-    [0x38] = instr_jr_c_e8,
-    [0x39] = instr_add_hl_sp,
-    [0x3A] = instr_ld_a_mem_hld,
-    [0x3B] = instr_dec_sp,
-    [0x3C] = instr_inc_a,
-    [0x3D] = instr_dec_a,
-    [0x3E] = instr_ld_a_n,
-    [0x3F] = instr_ccf,
-
-    // 0x4_
-    [0x40] = instr_ld_b_b,
-    [0x41] = instr_ld_b_c,
-    [0x42] = instr_ld_b_d,
-    [0x43] = instr_ld_b_e,
-    [0x44] = instr_ld_b_h,
-    [0x45] = instr_ld_b_l,
-    [0x46] = instr_ld_b_mem_hl,
-    [0x47] = instr_ld_b_a,
-    [0x48] = instr_ld_c_b,
-    [0x49] = instr_ld_c_c,
-    [0x4A] = instr_ld_c_d,
-    [0x4B] = instr_ld_c_e,
-    [0x4C] = instr_ld_c_h,
-    [0x4D] = instr_ld_c_l,
-    [0x4E] = instr_ld_c_mem_hl,
-    [0x4F] = instr_ld_c_a,
-
-    // 0x5_
-    [0x50] = instr_ld_d_b,
-    [0x51] = instr_ld_d_c,
-    [0x52] = instr_ld_d_d,
-    [0x53] = instr_ld_d_e,
-    [0x54] = instr_ld_d_h,
-    [0x55] = instr_ld_d_l,
-    [0x56] = instr_ld_d_mem_hl,
-    [0x57] = instr_ld_d_a,
-    [0x58] = instr_ld_e_b,
-    [0x59] = instr_ld_e_c,
-    [0x5A] = instr_ld_e_d,
-    [0x5B] = instr_ld_e_e,
-    [0x5C] = instr_ld_e_h,
-    [0x5D] = instr_ld_e_l,
-    [0x5E] = instr_ld_e_mem_hl,
-    [0x5F] = instr_ld_e_a,
-
-    // 0x6_
-    [0x60] = instr_ld_h_b,
-    [0x61] = instr_ld_h_c,
-    [0x62] = instr_ld_h_d,
-    [0x63] = instr_ld_h_e,
-    [0x64] = instr_ld_h_h,
-    [0x65] = instr_ld_h_l,
-    [0x66] = instr_ld_h_mem_hl,
-    [0x67] = instr_ld_h_a,
-    [0x68] = instr_ld_l_b,
-    [0x69] = instr_ld_l_c,
-    [0x6A] = instr_ld_l_d,
-    [0x6B] = instr_ld_l_e,
-    [0x6C] = instr_ld_l_h,
-    [0x6D] = instr_ld_l_l,
-    [0x6E] = instr_ld_l_mem_hl,
-    [0x6F] = instr_ld_l_a,
-
-    // 0x7_
-    [0x70] = instr_ld_mem_hl_b,
-    [0x71] = instr_ld_mem_hl_c,
-    [0x72] = instr_ld_mem_hl_d,
-    [0x73] = instr_ld_mem_hl_e,
-    [0x74] = instr_ld_mem_hl_h,
-    [0x75] = instr_ld_mem_hl_l,
-    [0x76] = instr_halt,
-    [0x77] = instr_ld_mem_hl_a,
-    [0x78] = instr_ld_a_b,
-    [0x79] = instr_ld_a_c,
-    [0x7A] = instr_ld_a_d,
-    [0x7B] = instr_ld_a_e,
-    [0x7C] = instr_ld_a_h,
-    [0x7D] = instr_ld_a_l,
-    [0x7E] = instr_ld_a_mem_hl,
-    [0x7F] = instr_ld_a_a,
-
-    // 0x8_
-    [0x80] = instr_add_a_b,
-    [0x81] = instr_add_a_c,
-    [0x82] = instr_add_a_d,
-    [0x83] = instr_add_a_e,
-    [0x84] = instr_add_a_h,
-    [0x85] = instr_add_a_l,
-    [0x86] = instr_add_a_mem_hl,
-    [0x87] = instr_add_a_a,
-    [0x88] = instr_adc_a_b,
-    [0x89] = instr_adc_a_c,
-    [0x8A] = instr_adc_a_d,
-    [0x8B] = instr_adc_a_e,
-    [0x8C] = instr_adc_a_h,
-    [0x8D] = instr_adc_a_l,
-    [0x8E] = instr_adc_a_mem_hl,
-    [0x8F] = instr_adc_a_a,
-
-    // 0x9_
-    [0x90] = instr_sub_a_b,
-    [0x91] = instr_sub_a_c,
-    [0x92] = instr_sub_a_d,
-    [0x93] = instr_sub_a_e,
-    [0x94] = instr_sub_a_h,
-    [0x95] = instr_sub_a_l,
-    [0x96] = instr_sub_a_mem_hl,
-    [0x97] = instr_sub_a_a,
-    [0x98] = instr_sbc_a_b,
-    [0x99] = instr_sbc_a_c,
-    [0x9A] = instr_sbc_a_d,
-    [0x9B] = instr_sbc_a_e,
-    [0x9C] = instr_sbc_a_h,
-    [0x9D] = instr_sbc_a_l,
-    [0x9E] = instr_sbc_a_mem_hl,
-    [0x9F] = instr_sbc_a_a,
-
-    // 0xA_
-    [0xA0] = instr_and_a_b,
-    [0xA1] = instr_and_a_c,
-    [0xA2] = instr_and_a_d,
-    [0xA3] = instr_and_a_e,
-    [0xA4] = instr_and_a_h,
-    [0xA5] = instr_and_a_l,
-    [0xA6] = instr_and_a_mem_hl,
-    [0xA7] = instr_and_a_a,
-    [0xA8] = instr_xor_a_b,
-    [0xA9] = instr_xor_a_c,
-    [0xAA] = instr_xor_a_d,
-    [0xAB] = instr_xor_a_e,
-    [0xAC] = instr_xor_a_h,
-    [0xAD] = instr_xor_a_l,
-    [0xAE] = instr_xor_a_mem_hl,
-    [0xAF] = instr_xor_a_a,
-
-    // 0xB_
-    [0xB0] = instr_or_a_b,
-    [0xB1] = instr_or_a_c,
-    [0xB2] = instr_or_a_d,
-    [0xB3] = instr_or_a_e,
-    [0xB4] = instr_or_a_h,
-    [0xB5] = instr_or_a_l,
-    [0xB6] = instr_or_a_mem_hl,
-    [0xB7] = instr_or_a_a,
-    [0xB8] = instr_cp_a_b,
-    [0xB9] = instr_cp_a_c,
-    [0xBA] = instr_cp_a_d,
-    [0xBB] = instr_cp_a_e,
-    [0xBC] = instr_cp_a_h,
-    [0xBD] = instr_cp_a_l,
-    [0xBE] = instr_cp_a_mem_hl,
-    [0xBF] = instr_cp_a_a,
-
-    // 0xC_
-    [0xC0] = instr_ret_nz,
-    [0xC1] = instr_pop_bc,
-    [0xC2] = instr_jp_nz_a16,
-    [0xC3] = instr_jp_a16,
-    [0xC4] = instr_call_nz_a16,
-    [0xC5] = instr_push_bc,
-    [0xC6] = instr_add_a_n,
-    [0xC7] = instr_rst_00,
-    [0xC8] = instr_ret_z,
-    [0xC9] = instr_ret,
-    [0xCA] = instr_jp_z_a16,
-    [0xCB] = NULL, // TODO: instr_prefix_cb
-    [0xCC] = instr_call_z_a16,
-    [0xCD] = instr_call_a16,
-    [0xCE] = instr_adc_a_n,
-    [0xCF] = instr_rst_08,
-
-    // 0xD_
-    [0xD0] = instr_ret_nc,
-    [0xD1] = instr_pop_de,
-    [0xD2] = instr_jp_nc_a16,
-    [0xD3] = NULL,
-    [0xD4] = instr_call_nc_a16,
-    [0xD5] = instr_push_de,
-    [0xD6] = instr_sub_a_n,
-    [0xD7] = instr_rst_10,
-    [0xD8] = instr_ret_c,
-    [0xD9] = instr_reti,
-    [0xDA] = instr_jp_c_a16,
-    [0xDB] = NULL,
-    [0xDC] = instr_call_c_a16,
-    [0xDD] = NULL,
-    [0xDE] = instr_sbc_a_n,
-    [0xDF] = instr_rst_18,
-
-    // 0xE_
-    [0xE0] = instr_ldh_mem_a8_a,
-    [0xE1] = instr_pop_hl,
-    [0xE2] = instr_ldh_mem_c_a,
-    [0xE3] = NULL,
-    [0xE4] = NULL,
-    [0xE5] = instr_push_hl,
-    [0xE6] = instr_and_a_n,
-    [0xE7] = instr_rst_20,
-    [0xE8] = instr_add_sp_e8,
-    [0xE9] = instr_jp_hl,
-    [0xEA] = instr_ld_mem_a16_a,
-    [0xEB] = NULL,
-    [0xEC] = NULL,
-    [0xED] = NULL,
-    [0xEE] = instr_xor_a_n,
-    [0xEF] = instr_rst_28,
-
-    // 0xF_
-    [0xF0] = instr_ldh_a_mem_a8,
-    [0xF1] = instr_pop_af,
-    [0xF2] = instr_ldh_a_mem_c,
-    [0xF3] = instr_di,
-    [0xF4] = NULL,
-    [0xF5] = instr_push_af,
-    [0xF6] = instr_or_a_n,
-    [0xF7] = instr_rst_30,
-    [0xF8] = instr_ld_hl_sp_e8,
-    [0xF9] = instr_ld_sp_hl,
-    [0xFA] = instr_ld_a_mem_a16,
-    [0xFB] = instr_ei,
-    [0xFC] = NULL,
-    [0xFD] = NULL,
-    [0xFE] = instr_cp_a_n,
-    [0xFF] = instr_rst_38,
-};
+#define TABLE_OP(code, handler) [code] = handler,
+#define TABLE_NO_OP(code)       [code] = NULL,
+
+static const InstrFunc instr_table[256] = {OPCODE_MAP(TABLE_OP, TABLE_NO_OP)};
 
 // ---------------------------------------------
 // Execute an instruction
@@ -311,3 +28,243 @@ u8 cpu_execute(CPU *cpu, u8 opcode) {
     }
     return instr_table[opcode](cpu);
 }
+
+InstrFunc cpu_instr_handler(u8 opcode) {
+    return instr_table[opcode];
+}
+
+// ============================================================================
+// NOTE: Dispatch Engines
+// Run instructions back-to-back until at least `budget` cycles have elapsed
+// (or cpu->run_exit is raised) and return the number of cycles executed.
+// ============================================================================
+
+// Threaded code needs either clang's `musttail` or GNU computed goto
+#if defined(__has_attribute)
+#if __has_attribute(musttail)
+#define CPU_HAVE_MUSTTAIL 1
+#endif
+#endif
+
+#if !defined(CPU_HAVE_MUSTTAIL) && defined(__GNUC__)
+#define CPU_HAVE_COMPUTED_GOTO 1
+#endif
+
+// Per-instruction prologue shared by every engine (mirrors cpu_step)
+// A single irq_check load covers the EI delay and interrupt dispatch.
+// Publishes the cycles so far, so IO handlers can tell the current time
+#define DISPATCH_PROLOGUE(cpu, cycles, budget)                                                     \
+    if ((cycles) >= (budget) || (cpu)->run_exit)                                                   \
+        return (cycles);                                                                           \
+    if ((cpu)->irq_check)                                                                          \
+        (cycles) += cpu_interrupt(cpu);                                                            \
+    (cpu)->run_cycles = (cycles);
+
+// ---------------------------------------------
+// Table dispatch (portable fallback)
+// Fetch, then one indirect call through instr_table per opcode
+// ---------------------------------------------
+u32 cpu_dispatch_table(CPU *cpu, u32 budget) {
+    u32 cycles = 0;
+
+    for (;;) {
+        DISPATCH_PROLOGUE(cpu, cycles, budget)
+
+        u8 opcode = mmu_fetch8(cpu);
+        cycles += cpu_execute(cpu, opcode);
+    }
+}
+
+#if defined(CPU_HAVE_MUSTTAIL)
+// ---------------------------------------------
+// Tail-call threaded dispatch (clang)
+// Every opcode gets a trampoline that runs its handler and then tail-calls
+// the next opcode's trampoline, so the cycle counter and budget stay in
+// argument registers and no frame is ever pushed between instructions.
+// ---------------------------------------------
+typedef u32 (*TailFunc)(CPU *cpu, u32 cycles, u32 budget);
+
+#define TAIL_DECL(code, handler) static u32 tail_##code(CPU *cpu, u32 cycles, u32 budget);
+#define TAIL_DECL_NO_OP(code)    TAIL_DECL(code, NULL)
+OPCODE_MAP(TAIL_DECL, TAIL_DECL_NO_OP)
+
+#define TAIL_ENTRY(code, handler) [code] = tail_##code,
+#define TAIL_ENTRY_NO_OP(code)    TAIL_ENTRY(code, NULL)
+static const TailFunc tail_table[256] = {OPCODE_MAP(TAIL_ENTRY, TAIL_ENTRY_NO_OP)};
+
+#define TAIL_NEXT(cpu, cycles, budget)                                                             \
+    DISPATCH_PROLOGUE(cpu, cycles, budget)                                                         \
+    __attribute__((musttail)) return tail_table[mmu_fetch8(cpu)](cpu, cycles, budget);
+
+#define TAIL_OP(code, handler)                                                                     \
+    static u32 tail_##code(CPU *cpu, u32 cycles, u32 budget) {                                     \
+        cycles += handler(cpu);                                                                    \
+        TAIL_NEXT(cpu, cycles, budget)                                                             \
+    }
+#define TAIL_NO_OP(code)                                                                           \
+    static u32 tail_##code(CPU *cpu, u32 cycles, u32 budget) {                                     \
+        cycles += cpu_execute(cpu, code);                                                          \
+        TAIL_NEXT(cpu, cycles, budget)                                                             \
+    }
+OPCODE_MAP(TAIL_OP, TAIL_NO_OP)
+
+u32 cpu_dispatch_threaded(CPU *cpu, u32 budget) {
+    u32 cycles = 0;
+
+    DISPATCH_PROLOGUE(cpu, cycles, budget)
+    return tail_table[mmu_fetch8(cpu)](cpu, cycles, budget);
+}
+
+#elif defined(CPU_HAVE_COMPUTED_GOTO)
+// ---------------------------------------------
+// Computed-goto threaded dispatch (GCC / clang without musttail)
+// Every opcode body ends in its own indirect jump to the next body, which
+// gives the branch predictor one history slot per opcode instead of a
+// single shared call site.
+// ---------------------------------------------
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic" // &&label and goto *ptr are GNU extensions
+
+u32 cpu_dispatch_threaded(CPU *cpu, u32 budget) {
+#define GOTO_LABEL(code, handler) [code] = &&op_##code,
+#define GOTO_LABEL_NO_OP(code)    GOTO_LABEL(code, NULL)
+    static const void *const labels[256] = {OPCODE_MAP(GOTO_LABEL, GOTO_LABEL_NO_OP)};
+
+    u32                      cycles      = 0;
+
+#define GOTO_NEXT()                                                                                \
+    DISPATCH_PROLOGUE(cpu, cycles, budget)                                                         \
+    goto *labels[mmu_fetch8(cpu)];
+
+#define GOTO_OP(code, handler)                                                                     \
+    op_##code : cycles += handler(cpu);                                                            \
+    GOTO_NEXT()
+#define GOTO_NO_OP(code)                                                                           \
+    op_##code : cycles += cpu_execute(cpu, code);                                                  \
+    GOTO_NEXT()
+
+    GOTO_NEXT()
+    OPCODE_MAP(GOTO_OP, GOTO_NO_OP)
+}
+
+#pragma GCC diagnostic pop
+
+#else
+// ---------------------------------------------
+// No threaded-code support: use the table engine
+// ---------------------------------------------
+u32 cpu_dispatch_threaded(CPU *cpu, u32 budget) {
+    return cpu_dispatch_table(cpu, budget);
+}
+#endif
+
+// ---------------------------------------------
+// Block dispatch
+// Look up (or decode) the basic block at PC once, then run its handlers
+// back-to-back without fetching or decoding opcodes. Budget & exit checks
+// still happen between instructions; a write to the block's own memory or a
+// memory map change (cache->stale) ends the block early.
+// ---------------------------------------------
+static inline u32 block_run(CPU *cpu, const CpuBlock *block, u32 cycles, u32 budget) {
+    CpuBlockCache *cache = &cpu->gb->blocks;
+
+    cache->stale         = false;
+    for (u8 i = 0;;) {
+        cpu->pc++; // Skip the opcode, handlers fetch their own immediates
+        cpu->run_cycles = cycles;
+        cycles += block->instrs[i](cpu);
+
+        if (++i == block->count || cycles >= budget || cpu->run_exit || cache->stale)
+            return cycles;
+    }
+}
+
+u32 cpu_dispatch_block(CPU *cpu, u32 budget) {
+    u32 cycles = 0;
+
+    for (;;) {
+        DISPATCH_PROLOGUE(cpu, cycles, budget)
+
+        const CpuBlock *block = cpu_block_lookup(cpu);
+        if (block == NULL) {
+            // No window or illegal opcode: interpret one instruction
+            u8 opcode = mmu_fetch8(cpu);
+            cycles += cpu_execute(cpu, opcode);
+            continue;
+        }
+
+        // Busy-wait candidates: note A/F to tell whether the loop is idle
+        u16 af    = block->idle ? cpu_read_af(cpu) : 0;
+        u32 start = cycles;
+
+        cycles    = block_run(cpu, block, cycles, budget);
+        if (block->idle)
+            cycles = cpu_block_idle(cpu, block, af, start, cycles, budget);
+    }
+}
+
+// ---------------------------------------------
+// JIT dispatch
+// Block dispatch, except that ROM blocks that ran CPU_JIT_THRESHOLD times
+// are translated and from then on run as native code. Translated blocks
+// always run to their end: the budget is only checked between blocks.
+// ---------------------------------------------
+u32 cpu_dispatch_jit(CPU *cpu, u32 budget) {
+    u32 cycles = 0;
+
+    for (;;) {
+        DISPATCH_PROLOGUE(cpu, cycles, budget)
+
+        CpuBlock *block = cpu_block_lookup(cpu);
+        if (block == NULL) {
+            u8 opcode = mmu_fetch8(cpu);
+            cycles += cpu_execute(cpu, opcode);
+            continue;
+        }
+
+        CpuNativeFunc native = cpu_jit_native(block);
+        if (native == NULL && block->pc < 0x8000 && ++block->heat == CPU_JIT_THRESHOLD)
+            native = cpu_jit_compile(block);
+
+        u16 af    = block->idle ? cpu_read_af(cpu) : 0;
+        u32 start = cycles;
+
+        if (native != NULL)
+            cycles += cpu_jit_run(cpu, native);
+        else
+            cycles = block_run(cpu, block, cycles, budget);
+
+        if (block->idle)
+            cycles = cpu_block_idle(cpu, block, af, start, cycles, budget);
+    }
+}
+
+// ---------------------------------------------
+// Run with the engine selected in cpu->dispatch
+// ---------------------------------------------
+u32 cpu_dispatch(CPU *cpu, u32 budget) {
+    if (cpu->dispatch == CPU_DISPATCH_THREADED)
+        return cpu_dispatch_threaded(cpu, budget);
+    if (cpu->dispatch == CPU_DISPATCH_BLOCK)
+        return cpu_dispatch_block(cpu, budget);
+    if (cpu->dispatch == CPU_DISPATCH_JIT)
+        return cpu_dispatch_jit(cpu, budget);
+    return cpu_dispatch_table(cpu, budget);
+}
+
+// Human-readable engine name (for benchmarks & debug output)
+const char *cpu_dispatch_name(CpuDispatch dispatch) {
+    if (dispatch == CPU_DISPATCH_TABLE)
+        return "table";
+    if (dispatch == CPU_DISPATCH_BLOCK)
+        return "block cache";
+    if (dispatch == CPU_DISPATCH_JIT)
+        return cpu_jit_available() ? "jit (x86-64)" : "jit (unavailable, using blocks)";
+#if defined(CPU_HAVE_MUSTTAIL)
+    return "threaded (musttail)";
+#elif defined(CPU_HAVE_COMPUTED_GOTO)
+    return "threaded (computed goto)";
+#else
+    return "threaded (unavailable, using table)";
+#endif
+}
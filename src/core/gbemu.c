@@ -1,6 +1,7 @@
 // src/core/gbemu.c
 #include <gbemu.h>
 #include <core/bus.h>
+#include <core/cpu/cpu_aot.h>
 #include <string.h>
 #include <stdio.h>
 
@@ -15,7 +16,6 @@ void gb_init(GameBoy *gb) {
     gb->io.sb       = 0x00;
     gb->io.sc       = 0x7E;
 
-    gb->io.div      = 0xAB;
     gb->io.tima     = 0x00;
     gb->io.tma      = 0x00;
     gb->io.tac      = 0xF8;
@@ -36,6 +36,15 @@ void gb_init(GameBoy *gb) {
     gb->io.wx       = 0x00;
 
     gb->io.boot     = 0x00;
+    cpu_irq_update(&gb->cpu);
+
+    // Nothing pending, components register their handlers
+    memset(gb->events.index, EVENT_NOT_QUEUED, sizeof(gb->events.index));
+    gb_set_event_handler(gb, EVENT_SERIAL, io_serial_complete);
+    gb_set_event_handler(gb, EVENT_DMA, io_dma_complete);
+    gb_set_event_handler(gb, EVENT_SAVE, mmu_save_flush);
+    timer_init(gb);
+    ppu_init(gb);
 }
 
 // Load a cartridge into GameBoy
@@ -52,7 +61,14 @@ void gb_load_rom(GameBoy *gb, const char *path) {
     cart_print_header(&gb->cart.header);
     printf("\n");
 
+    mmu_map_invalidate(gb, 0x00, 0xFF); // New ROM/RAM buffers
+    cpu_block_flush(&gb->blocks);
     cpu_reset(&gb->cpu);
+
+    // Built with generated code for this ROM (see cpu_aot.h): run it
+    gb->blocks.aot = cpu_aot_find(&gb->cart);
+    if (gb->blocks.aot != NULL)
+        gb->cpu.dispatch = CPU_DISPATCH_JIT;
     gb->running = true;
 }
 
@@ -61,8 +77,26 @@ void gb_step(GameBoy *gb) {
     if (!gb->running)
         return;
 
-    u8 cycles = cpu_step(&gb->cpu);
-    gb->cycles += cycles;
+    // A 1-cycle budget runs exactly one instruction
+    cpu_run(&gb->cpu, 1);
+    gb_run_events(gb);
+}
+
+// Run for at least `cycles`
+// Each cpu_run() call stops at the earliest event deadline (or earlier, when
+// something needs attention), then the due events fire
+void gb_run(GameBoy *gb, u64 cycles) {
+    u64 end = gb->cycles + cycles;
+
+    while (gb->running && gb->cycles < end) {
+        u64 deadline = gb_next_event(gb);
+        if (deadline > end)
+            deadline = end;
+
+        u64 budget = (deadline > gb->cycles) ? deadline - gb->cycles : 1;
+        cpu_run(&gb->cpu, (budget > UINT32_MAX) ? UINT32_MAX : (u32)budget);
+        gb_run_events(gb);
+    }
 }
 
 // Run the emulator for the duration of one video frame
@@ -72,11 +106,116 @@ void gb_run_frame(GameBoy *gb) {
 
     // GameBoy runs at ~4.19 MHz
     // 1 frame @ 60 Hz = 70224 cycles
-    u32 frame_cycles = 0;
+    gb_run(gb, 70224);
+
+    // Nothing touched the LCD registers since the last access: catch up
+    ppu_sync(gb, gb->cycles);
+}
+
+void gb_request_interrupt(GameBoy *gb, Interrupt interrupt) {
+    gb->io.if_reg = SET_BIT(gb->io.if_reg, interrupt);
+    cpu_irq_update(&gb->cpu);
+}
+
+// ============================================================================
+// NOTE: Event Scheduler
+// Binary min-heap of event types ordered by (deadline, type), so events due
+// on the same cycle always fire in the same order. index[] tracks where each
+// type sits in the heap, which makes rescheduling/cancelling O(log n).
+// ============================================================================
+static bool event_before(const Scheduler *s, u8 a, u8 b) {
+    return (s->when[a] != s->when[b]) ? s->when[a] < s->when[b] : a < b;
+}
+
+static void heap_swap(Scheduler *s, u8 i, u8 j) {
+    u8 a        = s->heap[i];
+    u8 b        = s->heap[j];
+    s->heap[i]  = b;
+    s->heap[j]  = a;
+    s->index[b] = i;
+    s->index[a] = j;
+}
+
+static void heap_sift_up(Scheduler *s, u8 i) {
+    while (i > 0) {
+        u8 parent = (i - 1) / 2;
+        if (!event_before(s, s->heap[i], s->heap[parent]))
+            break;
+        heap_swap(s, i, parent);
+        i = parent;
+    }
+}
+
+static void heap_sift_down(Scheduler *s, u8 i) {
+    for (;;) {
+        u8 first = i;
+        u8 left  = 2 * i + 1;
+        u8 right = 2 * i + 2;
+
+        if (left < s->count && event_before(s, s->heap[left], s->heap[first]))
+            first = left;
+        if (right < s->count && event_before(s, s->heap[right], s->heap[first]))
+            first = right;
+        if (first == i)
+            return;
+
+        heap_swap(s, i, first);
+        i = first;
+    }
+}
+
+// Take the event at heap position `i` out of the heap
+static void heap_remove(Scheduler *s, u8 i) {
+    u8 type        = s->heap[i];
+    u8 last        = --s->count;
+    s->index[type] = EVENT_NOT_QUEUED;
+
+    if (i == last)
+        return;
+
+    // Move the last event into the hole, then restore the heap order
+    u8 moved        = s->heap[last];
+    s->heap[i]      = moved;
+    s->index[moved] = i;
+    heap_sift_up(s, i);
+    heap_sift_down(s, s->index[moved]);
+}
+
+void gb_set_event_handler(GameBoy *gb, EventType type, EventHandler handler) {
+    gb->events.handlers[type] = handler;
+}
+
+void gb_schedule_event(GameBoy *gb, EventType type, u64 when) {
+    Scheduler *s        = &gb->events;
+    u64        earliest = gb_next_event(gb);
+
+    if (s->index[type] != EVENT_NOT_QUEUED)
+        heap_remove(s, s->index[type]);
+
+    s->when[type]     = when;
+    s->heap[s->count] = type;
+    s->index[type]    = s->count;
+    heap_sift_up(s, s->count++);
+
+    // Called from an IO write: stop the running cpu_run() at the new deadline
+    if (when < earliest)
+        cpu_request_exit(&gb->cpu);
+}
+
+void gb_cancel_event(GameBoy *gb, EventType type) {
+    if (gb->events.index[type] != EVENT_NOT_QUEUED)
+        heap_remove(&gb->events, gb->events.index[type]);
+}
+
+void gb_run_events(GameBoy *gb) {
+    Scheduler *s = &gb->events;
+
+    while (s->count > 0 && s->when[s->heap[0]] <= gb->cycles) {
+        u8  type = s->heap[0];
+        u64 when = s->when[type];
 
-    while (frame_cycles < 70224) {
-        u8 cycles = cpu_step(&gb->cpu);
-        frame_cycles += cycles;
-        gb->cycles += cycles;
+        heap_remove(s, 0);
+        if (s->handlers[type] != NULL)
+            s->handlers[type](gb, when); // May schedule it again
     }
 }
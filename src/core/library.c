@@ -0,0 +1,418 @@
+// src/core/library.c
+#include <core/library.h>
+#include <core/cartridge.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define LIBRARY_CHUNK     0x10000 // pread() size of the checksum pass
+#define LIBRARY_FIELD_MAX 4096    // Longest CSV field library_load() keeps
+#define LIBRARY_COLUMNS   11
+
+// ---------------------------------------------
+// CRC-32 (IEEE 802.3: reflected, polynomial 0xEDB88320)
+// ---------------------------------------------
+static u32            crc32_table[256];
+static pthread_once_t crc32_once = PTHREAD_ONCE_INIT;
+
+static void crc32_init(void) {
+    for (u32 i = 0; i < 256; i++) {
+        u32 crc = i;
+        for (int bit = 0; bit < 8; bit++)
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+        crc32_table[i] = crc;
+    }
+}
+
+static u32 crc32_update(u32 crc, const u8 *data, size_t len) {
+    for (size_t i = 0; i < len; i++)
+        crc = crc32_table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+// ---------------------------------------------
+// Entries
+// ---------------------------------------------
+static LibraryEntry *library_add(Library *lib) {
+    if (lib->count == lib->capacity) {
+        size_t        capacity = lib->capacity ? lib->capacity * 2 : 64;
+        LibraryEntry *entries  = realloc(lib->entries, capacity * sizeof(LibraryEntry));
+        if (entries == NULL)
+            return NULL;
+        lib->entries  = entries;
+        lib->capacity = capacity;
+    }
+
+    LibraryEntry *entry = &lib->entries[lib->count++];
+    memset(entry, 0, sizeof(*entry));
+    return entry;
+}
+
+static int entry_compare(const void *a, const void *b) {
+    return strcmp(((const LibraryEntry *)a)->path, ((const LibraryEntry *)b)->path);
+}
+
+// Drop the entries that couldn't be probed
+static void library_compact(Library *lib) {
+    size_t kept = 0;
+
+    for (size_t i = 0; i < lib->count; i++) {
+        if (lib->entries[i].valid) {
+            lib->entries[kept++] = lib->entries[i];
+            continue;
+        }
+        fprintf(stderr, "Skipping %s: unreadable or too small\n", lib->entries[i].path);
+        free(lib->entries[i].path);
+    }
+    lib->count = kept;
+}
+
+// ---------------------------------------------
+// Directory walk
+// Symlinks to ROMs are followed, symlinks to directories are not (no loops)
+// ---------------------------------------------
+static bool library_is_rom(const char *name) {
+    const char *ext = strrchr(name, '.');
+    return ext != NULL &&
+           (strcasecmp(ext, ".gb") == 0 || strcasecmp(ext, ".gbc") == 0 ||
+            strcasecmp(ext, ".sgb") == 0);
+}
+
+static void library_walk(Library *lib, const char *dir) {
+    DIR *handle = opendir(dir);
+    if (handle == NULL)
+        return;
+
+    size_t         dir_len = strlen(dir);
+    const char    *sep     = (dir_len > 0 && dir[dir_len - 1] == '/') ? "" : "/";
+    struct dirent *ent;
+
+    while ((ent = readdir(handle)) != NULL) {
+        if (strcmp(ent->d_name, ".") == 0 || strcmp(ent->d_name, "..") == 0)
+            continue;
+
+        size_t len  = dir_len + strlen(ent->d_name) + 2;
+        char  *path = malloc(len);
+        if (path == NULL)
+            break;
+        snprintf(path, len, "%s%s%s", dir, sep, ent->d_name);
+
+        struct stat st;
+        if (lstat(path, &st) == 0 && S_ISDIR(st.st_mode)) {
+            library_walk(lib, path);
+            free(path);
+            continue;
+        }
+        if (!library_is_rom(ent->d_name) || stat(path, &st) != 0 || !S_ISREG(st.st_mode)) {
+            free(path);
+            continue;
+        }
+
+        LibraryEntry *entry = library_add(lib);
+        if (entry == NULL) {
+            free(path);
+            break;
+        }
+        entry->path  = path;
+        entry->size  = (u64)st.st_size;
+        entry->mtime = (i64)st.st_mtime;
+    }
+    closedir(handle);
+}
+
+// ---------------------------------------------
+// Probe one file: header, then a single pass for the checksums
+// ---------------------------------------------
+static void library_probe(LibraryEntry *entry) {
+    RawRomHeader raw;
+    CartHeader   header;
+
+    int fd = open(entry->path, O_RDONLY);
+    if (fd < 0)
+        return;
+
+    int status = cart_probe_fd(fd, &raw, &header);
+    u8 *chunk  = malloc(LIBRARY_CHUNK);
+    if (status > 0 || chunk == NULL) {
+        free(chunk);
+        close(fd);
+        return;
+    }
+
+    // CRC-32 of everything, global checksum of everything but itself
+    u32     crc    = 0xFFFFFFFF;
+    u16     sum    = 0;
+    u64     offset = 0;
+    ssize_t got;
+    while ((got = pread(fd, chunk, LIBRARY_CHUNK, (off_t)offset)) > 0) {
+        crc = crc32_update(crc, chunk, (size_t)got);
+        for (ssize_t i = 0; i < got; i++) {
+            if (offset + i != 0x014E && offset + i != 0x014F)
+                sum += chunk[i];
+        }
+        offset += (u64)got;
+    }
+    free(chunk);
+    close(fd);
+    if (got < 0)
+        return;
+
+    // Titles are ASCII, anything else would garble the index
+    for (int i = 0; header.title[i] != '\0'; i++) {
+        char c          = header.title[i];
+        entry->title[i] = (c >= 0x20 && c < 0x7F) ? c : '?';
+    }
+    entry->cart_type     = header.cart_type;
+    entry->rom_size_code = header.rom_size_code;
+    entry->ram_size_code = header.ram_size_code;
+    entry->cgb           = header.cgb_supported;
+    entry->header_ok     = (status == 0);
+    entry->global_ok     = (sum == MAKE_U16(raw.global_ck_hi, raw.global_ck_lo));
+    entry->crc32         = ~crc;
+    entry->valid         = true;
+}
+
+// ---------------------------------------------
+// Thread pool: workers take the next entry until none are left
+// ---------------------------------------------
+typedef struct {
+    Library        *lib;
+    size_t          next;
+    pthread_mutex_t lock;
+} ScanPool;
+
+static void *library_worker(void *arg) {
+    ScanPool *pool = arg;
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        size_t i = pool->next++;
+        pthread_mutex_unlock(&pool->lock);
+
+        if (i >= pool->lib->count)
+            return NULL;
+        if (!pool->lib->entries[i].valid) // Not from the cache
+            library_probe(&pool->lib->entries[i]);
+    }
+}
+
+// ============================================================================
+// NOTE: Library API
+// ============================================================================
+int library_scan(Library *lib, const char *dir, const Library *cache, int threads) {
+    DIR *root = opendir(dir);
+    if (root == NULL)
+        return -1;
+    closedir(root);
+
+    pthread_once(&crc32_once, crc32_init);
+    memset(lib, 0, sizeof(*lib));
+    library_walk(lib, dir);
+    qsort(lib->entries, lib->count, sizeof(LibraryEntry), entry_compare);
+
+    // Unchanged files keep their cached entry
+    for (size_t i = 0; i < lib->count; i++) {
+        LibraryEntry       *entry = &lib->entries[i];
+        const LibraryEntry *hit   = NULL;
+
+        if (cache != NULL && cache->count > 0)
+            hit = bsearch(entry, cache->entries, cache->count, sizeof(LibraryEntry),
+                          entry_compare);
+        if (hit != NULL && hit->size == entry->size && hit->mtime == entry->mtime) {
+            char *path  = entry->path;
+            *entry      = *hit;
+            entry->path = path;
+        } else {
+            lib->probed++;
+        }
+    }
+
+    if (threads <= 0)
+        threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if ((size_t)threads > lib->probed)
+        threads = (int)lib->probed;
+
+    // This thread is one of the workers
+    ScanPool   pool    = {.lib = lib, .next = 0};
+    pthread_t *workers = (threads > 1) ? malloc((size_t)(threads - 1) * sizeof(pthread_t)) : NULL;
+    int        started = 0;
+
+    pthread_mutex_init(&pool.lock, NULL);
+    while (workers != NULL && started < threads - 1 &&
+           pthread_create(&workers[started], NULL, library_worker, &pool) == 0)
+        started++;
+    library_worker(&pool);
+    for (int i = 0; i < started; i++)
+        pthread_join(workers[i], NULL);
+    pthread_mutex_destroy(&pool.lock);
+    free(workers);
+
+    library_compact(lib);
+    return 0;
+}
+
+// ---------------------------------------------
+// CSV
+// ---------------------------------------------
+static void csv_string(FILE *out, const char *s) {
+    fputc('"', out);
+    for (; *s != '\0'; s++) {
+        if (*s == '"')
+            fputc('"', out);
+        fputc(*s, out);
+    }
+    fputc('"', out);
+}
+
+// Read one field into `buf`, returns what ended it: ',', '\n' or EOF
+static int csv_field(FILE *in, char *buf, size_t size) {
+    size_t len    = 0;
+    bool   quoted = false;
+    int    c      = fgetc(in);
+
+    if (c == '"') {
+        quoted = true;
+        c      = fgetc(in);
+    }
+
+    while (c != EOF) {
+        if (quoted) {
+            if (c == '"') {
+                c = fgetc(in);
+                if (c != '"') {
+                    quoted = false; // Closing quote, look at `c` again
+                    continue;
+                }
+            }
+        } else if (c == ',' || c == '\n') {
+            break;
+        } else if (c == '\r') {
+            c = fgetc(in);
+            continue;
+        }
+
+        if (len + 1 < size)
+            buf[len++] = (char)c;
+        c = fgetc(in);
+    }
+
+    buf[len] = '\0';
+    return c;
+}
+
+int library_load(Library *lib, const char *path) {
+    FILE *in = fopen(path, "r");
+    if (in == NULL)
+        return -1;
+
+    char (*fields)[LIBRARY_FIELD_MAX] = malloc(LIBRARY_COLUMNS * sizeof(*fields));
+    bool header                       = true;
+    int  end                          = 0;
+
+    memset(lib, 0, sizeof(*lib));
+    while (fields != NULL && end != EOF) {
+        int count = 0;
+        do {
+            end = csv_field(in, fields[count < LIBRARY_COLUMNS ? count : 0], LIBRARY_FIELD_MAX);
+            count++;
+        } while (end == ',');
+
+        // Column names, blank or malformed lines
+        if (header || count != LIBRARY_COLUMNS) {
+            header = false;
+            continue;
+        }
+
+        LibraryEntry *entry = library_add(lib);
+        if (entry == NULL)
+            break;
+        entry->path          = strdup(fields[0]);
+        entry->size          = strtoull(fields[1], NULL, 10);
+        entry->mtime         = strtoll(fields[2], NULL, 10);
+        snprintf(entry->title, sizeof(entry->title), "%s", fields[3]);
+        entry->cart_type     = (u8)strtoul(fields[4], NULL, 0);
+        entry->rom_size_code = (u8)strtoul(fields[5], NULL, 0);
+        entry->ram_size_code = (u8)strtoul(fields[6], NULL, 0);
+        entry->cgb           = strcmp(fields[7], "1") == 0;
+        entry->header_ok     = strcmp(fields[8], "ok") == 0;
+        entry->global_ok     = strcmp(fields[9], "ok") == 0;
+        entry->crc32         = (u32)strtoul(fields[10], NULL, 16);
+        entry->valid         = (entry->path != NULL);
+        if (!entry->valid)
+            lib->count--;
+    }
+
+    free(fields);
+    fclose(in);
+    qsort(lib->entries, lib->count, sizeof(LibraryEntry), entry_compare);
+    return 0;
+}
+
+// ---------------------------------------------
+// JSON
+// ---------------------------------------------
+static void json_string(FILE *out, const char *s) {
+    fputc('"', out);
+    for (; *s != '\0'; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\')
+            fprintf(out, "\\%c", c);
+        else if (c < 0x20)
+            fprintf(out, "\\u%04X", c);
+        else
+            fputc(c, out);
+    }
+    fputc('"', out);
+}
+
+void library_write(const Library *lib, FILE *out, LibraryFormat format) {
+    if (format == LIBRARY_CSV) {
+        fprintf(out, "path,size,mtime,title,type,rom_size,ram_size,cgb,header_checksum,"
+                     "global_checksum,crc32\n");
+    } else {
+        fprintf(out, "[\n");
+    }
+
+    for (size_t i = 0; i < lib->count; i++) {
+        const LibraryEntry *entry = &lib->entries[i];
+
+        if (format == LIBRARY_CSV) {
+            csv_string(out, entry->path);
+            fprintf(out, ",%llu,%lld,", (unsigned long long)entry->size, (long long)entry->mtime);
+            csv_string(out, entry->title);
+            fprintf(out, ",0x%02X,0x%02X,0x%02X,%d,%s,%s,%08X\n", entry->cart_type,
+                    entry->rom_size_code, entry->ram_size_code, entry->cgb,
+                    entry->header_ok ? "ok" : "bad", entry->global_ok ? "ok" : "bad",
+                    entry->crc32);
+            continue;
+        }
+
+        fprintf(out, "  {\"path\": ");
+        json_string(out, entry->path);
+        fprintf(out, ", \"size\": %llu, \"mtime\": %lld, \"title\": ",
+                (unsigned long long)entry->size, (long long)entry->mtime);
+        json_string(out, entry->title);
+        fprintf(out,
+                ", \"type\": %u, \"rom_size\": %u, \"ram_size\": %u, \"cgb\": %s, "
+                "\"header_checksum\": %s, \"global_checksum\": %s, \"crc32\": \"%08X\"}%s\n",
+                entry->cart_type, entry->rom_size_code, entry->ram_size_code,
+                entry->cgb ? "true" : "false", entry->header_ok ? "true" : "false",
+                entry->global_ok ? "true" : "false", entry->crc32,
+                (i + 1 < lib->count) ? "," : "");
+    }
+
+    if (format == LIBRARY_JSON)
+        fprintf(out, "]\n");
+}
+
+void library_free(Library *lib) {
+    for (size_t i = 0; i < lib->count; i++)
+        free(lib->entries[i].path);
+    free(lib->entries);
+    memset(lib, 0, sizeof(*lib));
+}
@@ -0,0 +1,393 @@
+// src/core/mbc.c
+#include <core/mbc.h>
+#include <core/cartridge.h>
+#include <string.h>
+#include <time.h>
+
+// ---------------------------------------------
+// Helpers
+// ---------------------------------------------
+
+// Bank bits the chips actually wire up: the smallest all-ones mask covering `banks`
+static u32 mbc_bank_mask(size_t banks) {
+    u32 mask = 0;
+    while (mask + 1 < banks)
+        mask = (mask << 1) | 1;
+    return mask;
+}
+
+// Host pointer to ROM bank `bank`, NULL if the ROM doesn't hold all of it
+static const u8 *mbc_rom_bank(const Cartridge *cart, u32 bank) {
+    size_t banks = cart->rom_size / MBC_ROM_BANK_SIZE;
+
+    bank &= mbc_bank_mask(banks);
+    if (cart->rom == NULL || bank >= banks)
+        return NULL;
+    return cart->rom + (size_t)bank * MBC_ROM_BANK_SIZE;
+}
+
+// Host pointer to RAM bank `bank` (RAMs up to one bank are mirrored through ram_mask)
+static u8 *mbc_ram_bank(const Cartridge *cart, u32 bank) {
+    size_t banks = cart->ram_size / MBC_RAM_BANK_SIZE;
+
+    if (cart->ram == NULL)
+        return NULL;
+    return cart->ram + (size_t)(bank & mbc_bank_mask(banks)) * MBC_RAM_BANK_SIZE;
+}
+
+// 0x0A in the low nibble enables the RAM, anything else disables it
+static bool mbc_ram_enable(u8 value) {
+    return MASK_BITS(value, 0x0F) == 0x0A;
+}
+
+// ---------------------------------------------
+// Recompute the bank pointers from the registers
+// Returns the MBC_MAP_* regions whose pointer changed
+// ---------------------------------------------
+static u8 mbc_update(Cartridge *cart) {
+    Mbc *mbc      = &cart->mbc;
+    u32  bank0    = 0;
+    u32  bank     = mbc->rom_bank;
+    u32  ram_bank = 0;
+    bool ram      = mbc->ram_enabled;
+
+    switch (mbc->type) {
+        case MBC_1:
+            // bank2 extends the ROM bank (1 MiB+ carts), in mode 1 it also
+            // selects the RAM bank and the bank at 0x0000
+            bank |= (u32)mbc->bank2 << 5;
+            if (mbc->mode) {
+                bank0    = (u32)mbc->bank2 << 5;
+                ram_bank = mbc->bank2;
+            }
+            break;
+        case MBC_3:
+            ram      = ram && mbc->bank2 < 0x08; // 0x08 - 0x0C select an RTC register
+            ram_bank = mbc->bank2;
+            break;
+        case MBC_5:
+            ram_bank = mbc->bank2;
+            break;
+        default:
+            break;
+    }
+
+    const u8 *rom0    = mbc_rom_bank(cart, bank0);
+    const u8 *romn    = mbc_rom_bank(cart, bank);
+    u8       *ramp    = ram ? mbc_ram_bank(cart, ram_bank) : NULL;
+    u8        changed = 0;
+
+    if (rom0 != mbc->rom_bank0_ptr)
+        changed |= MBC_MAP_ROM0;
+    if (romn != mbc->rom_bank_ptr)
+        changed |= MBC_MAP_ROMN;
+    if (ramp != mbc->ram_bank_ptr)
+        changed |= MBC_MAP_RAM;
+
+    mbc->rom_bank0_ptr = rom0;
+    mbc->rom_bank_ptr  = romn;
+    mbc->ram_bank_ptr  = ramp;
+
+    if (changed & (MBC_MAP_ROM0 | MBC_MAP_ROMN))
+        mbc->rom_switches++;
+    if (changed & MBC_MAP_RAM)
+        mbc->ram_switches++;
+    return changed;
+}
+
+// ---------------------------------------------
+// MBC3 RTC
+// ---------------------------------------------
+static u64 rtc_clock(const MbcRtc *rtc, u64 now) {
+    if (!rtc->host)
+        return now;
+
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (u64)ts.tv_sec * MBC_RTC_HOST_RATE + (u64)ts.tv_nsec / 1000;
+}
+
+static u64 rtc_rate(const MbcRtc *rtc) {
+    return rtc->host ? MBC_RTC_HOST_RATE : MBC_RTC_CYCLE_RATE;
+}
+
+// One second. Values written out of range count up to their bit width and
+// wrap to 0 without carrying
+static void rtc_tick(MbcRtc *rtc) {
+    rtc->sec = (rtc->sec + 1) & 0x3F;
+    if (rtc->sec != 60)
+        return;
+    rtc->sec = 0;
+    rtc->min = (rtc->min + 1) & 0x3F;
+    if (rtc->min != 60)
+        return;
+    rtc->min  = 0;
+    rtc->hour = (rtc->hour + 1) & 0x1F;
+    if (rtc->hour != 24)
+        return;
+    rtc->hour = 0;
+    if (++rtc->days == 512) {
+        rtc->days  = 0;
+        rtc->carry = true;
+    }
+}
+
+static void rtc_advance(MbcRtc *rtc, u64 secs) {
+    while (secs > 0 && (rtc->sec > 59 || rtc->min > 59 || rtc->hour > 23)) {
+        rtc_tick(rtc);
+        secs--;
+    }
+    if (secs == 0)
+        return;
+
+    u64 total = secs + rtc->sec + 60 * (rtc->min + 60 * (rtc->hour + 24 * (u64)rtc->days));
+    rtc->sec  = (u8)(total % 60);
+    total    /= 60;
+    rtc->min  = (u8)(total % 60);
+    total    /= 60;
+    rtc->hour = (u8)(total % 24);
+    total    /= 24;
+    if (total >= 512)
+        rtc->carry = true;
+    rtc->days = (u16)(total % 512);
+}
+
+// Bring the live counter up to `now` (whole seconds, the remainder stays in stamp)
+static void rtc_sync(MbcRtc *rtc, u64 now) {
+    u64 clock = rtc_clock(rtc, now);
+
+    if (rtc->halt || clock < rtc->stamp) {
+        rtc->stamp = clock;
+        return;
+    }
+
+    u64 secs    = (clock - rtc->stamp) / rtc_rate(rtc);
+    rtc->stamp += secs * rtc_rate(rtc);
+    rtc_advance(rtc, secs);
+}
+
+// Live counter as registers 0x08 - 0x0C
+static void rtc_registers(const MbcRtc *rtc, u8 out[5]) {
+    out[0] = rtc->sec;
+    out[1] = rtc->min;
+    out[2] = rtc->hour;
+    out[3] = GET_LOW_BYTE(rtc->days);
+    out[4] = (u8)((rtc->days >> 8) | (rtc->halt << 6) | (rtc->carry << 7));
+}
+
+static void rtc_set_register(MbcRtc *rtc, u8 reg, u8 value) {
+    switch (reg) {
+        case 0:
+            rtc->sec = MASK_BITS(value, 0x3F);
+            break;
+        case 1:
+            rtc->min = MASK_BITS(value, 0x3F);
+            break;
+        case 2:
+            rtc->hour = MASK_BITS(value, 0x1F);
+            break;
+        case 3:
+            rtc->days = (rtc->days & 0x100) | value;
+            break;
+        default:
+            rtc->days  = (u16)((rtc->days & 0xFF) | (CHECK_BIT(value, 0) << 8));
+            rtc->halt  = CHECK_BIT(value, 6);
+            rtc->carry = CHECK_BIT(value, 7);
+            break;
+    }
+}
+
+static void rtc_latch(MbcRtc *rtc, u8 value, u64 now) {
+    if (rtc->latch_last == 0x00 && value == 0x01) {
+        rtc_sync(rtc, now);
+        rtc_registers(rtc, rtc->latched);
+    }
+    rtc->latch_last = value;
+}
+
+static u32 rtc_load32(const u8 *p) {
+    return (u32)p[0] | ((u32)p[1] << 8) | ((u32)p[2] << 16) | ((u32)p[3] << 24);
+}
+
+static void rtc_store32(u8 *p, u32 value) {
+    for (int i = 0; i < 4; i++)
+        p[i] = (u8)(value >> (8 * i));
+}
+
+// ---------------------------------------------
+// Register writes per controller
+// ---------------------------------------------
+static void mbc1_write(Mbc *mbc, u16 addr, u8 value) {
+    if (addr < 0x2000) {
+        mbc->ram_enabled = mbc_ram_enable(value);
+    } else if (addr < 0x4000) {
+        mbc->rom_bank = MASK_BITS(value, 0x1F);
+        if (mbc->rom_bank == 0)
+            mbc->rom_bank = 1; // Bank 0 selects bank 1 (also 0x20 / 0x40 / 0x60)
+    } else if (addr < 0x6000) {
+        mbc->bank2 = MASK_BITS(value, 0x03);
+    } else {
+        mbc->mode = CHECK_BIT(value, 0);
+    }
+}
+
+static void mbc2_write(Mbc *mbc, u16 addr, u8 value) {
+    if (addr >= 0x4000)
+        return;
+
+    // Address bit 8 picks the register
+    if (CHECK_BIT(addr, 8)) {
+        mbc->rom_bank = MASK_BITS(value, 0x0F);
+        if (mbc->rom_bank == 0)
+            mbc->rom_bank = 1;
+    } else {
+        mbc->ram_enabled = mbc_ram_enable(value);
+    }
+}
+
+static void mbc3_write(Mbc *mbc, u16 addr, u8 value, u64 now) {
+    if (addr < 0x2000) {
+        mbc->ram_enabled = mbc_ram_enable(value);
+    } else if (addr < 0x4000) {
+        mbc->rom_bank = MASK_BITS(value, 0x7F);
+        if (mbc->rom_bank == 0)
+            mbc->rom_bank = 1;
+    } else if (addr < 0x6000) {
+        mbc->bank2 = value;
+    } else {
+        rtc_latch(&mbc->rtc, value, now);
+    }
+}
+
+static void mbc5_write(Mbc *mbc, u16 addr, u8 value) {
+    if (addr < 0x2000) {
+        mbc->ram_enabled = mbc_ram_enable(value);
+    } else if (addr < 0x3000) {
+        mbc->rom_bank = (mbc->rom_bank & 0x100) | value; // Bank 0 is allowed
+    } else if (addr < 0x4000) {
+        mbc->rom_bank = (u16)((mbc->rom_bank & 0xFF) | (CHECK_BIT(value, 0) << 8));
+    } else if (addr < 0x6000) {
+        mbc->bank2 = MASK_BITS(value, 0x0F); // Bit 3 drives the rumble motor on rumble carts
+    }
+}
+
+// ============================================================================
+// NOTE: MBC API
+// ============================================================================
+MbcType mbc_type(u8 cart_type) {
+    if (cart_type >= 0x01 && cart_type <= 0x03)
+        return MBC_1;
+    if (cart_type == 0x05 || cart_type == 0x06)
+        return MBC_2;
+    if (cart_type >= 0x0F && cart_type <= 0x13)
+        return MBC_3;
+    if (cart_type >= 0x19 && cart_type <= 0x1E)
+        return MBC_5;
+    return MBC_NONE;
+}
+
+void mbc_init(Cartridge *cart) {
+    Mbc *mbc = &cart->mbc;
+
+    memset(mbc, 0, sizeof(*mbc));
+    mbc->type      = mbc_type(cart->header.cart_type);
+    mbc->rom_bank  = 1;
+    mbc->rtc.host  = cart->rtc_host;
+    mbc->rtc.stamp = rtc_clock(&mbc->rtc, 0);
+
+    mbc->ram_mask = MBC_RAM_BANK_SIZE - 1;
+    if (mbc->type == MBC_2)
+        mbc->ram_mask = MBC2_RAM_SIZE - 1;
+    else if (cart->ram_size > 0 && cart->ram_size < MBC_RAM_BANK_SIZE)
+        mbc->ram_mask = (u16)(cart->ram_size - 1);
+
+    if (mbc->type != MBC_NONE)
+        mbc_update(cart);
+    mbc->rom_switches = 0;
+    mbc->ram_switches = 0;
+}
+
+u8 mbc_write(Cartridge *cart, u16 addr, u8 value, u64 now) {
+    Mbc *mbc = &cart->mbc;
+
+    switch (mbc->type) {
+        case MBC_1:
+            mbc1_write(mbc, addr, value);
+            break;
+        case MBC_2:
+            mbc2_write(mbc, addr, value);
+            break;
+        case MBC_3:
+            mbc3_write(mbc, addr, value, now);
+            break;
+        case MBC_5:
+            mbc5_write(mbc, addr, value);
+            break;
+        default:
+            return 0; // No controller, writes to ROM are ignored
+    }
+    return mbc_update(cart);
+}
+
+u8 mbc_read_ram(const Cartridge *cart, u16 addr) {
+    const Mbc *mbc = &cart->mbc;
+    (void)addr;
+
+    if (mbc->type == MBC_3 && mbc->ram_enabled && mbc->bank2 >= 0x08 && mbc->bank2 <= 0x0C)
+        return mbc->rtc.latched[mbc->bank2 - 0x08];
+    return 0xFF;
+}
+
+void mbc_write_ram(Cartridge *cart, u16 addr, u8 value, u64 now) {
+    Mbc *mbc = &cart->mbc;
+
+    // RTC registers: the live counter catches up first, writing the seconds
+    // restarts the current second. The latched copy shows the write too
+    if (mbc->type == MBC_3 && mbc->ram_enabled && mbc->bank2 >= 0x08 && mbc->bank2 <= 0x0C) {
+        u8 reg = mbc->bank2 - 0x08;
+        u8 live[5];
+
+        rtc_sync(&mbc->rtc, now);
+        rtc_set_register(&mbc->rtc, reg, value);
+        if (reg == 0)
+            mbc->rtc.stamp = rtc_clock(&mbc->rtc, now);
+        rtc_registers(&mbc->rtc, live);
+        mbc->rtc.latched[reg] = live[reg];
+    } else if (mbc->type == MBC_2 && mbc->ram_bank_ptr != NULL)
+        mbc->ram_bank_ptr[(addr - 0xA000) & mbc->ram_mask] = value | 0xF0; // Upper nibble reads 1s
+}
+
+// ---------------------------------------------
+// .sav footer: S, M, H, DL, DH live, the same latched (u32 LE each), then
+// the Unix time they were stored at (u64 LE)
+// ---------------------------------------------
+void mbc_rtc_load(Cartridge *cart, const u8 *footer) {
+    MbcRtc *rtc = &cart->mbc.rtc;
+
+    for (u8 reg = 0; reg < 5; reg++) {
+        rtc_set_register(rtc, reg, (u8)rtc_load32(footer + 4 * reg));
+        rtc->latched[reg] = (u8)rtc_load32(footer + 20 + 4 * reg);
+    }
+
+    // Host time: the clock kept running while the emulator wasn't
+    u64 saved = (u64)rtc_load32(footer + 40) | ((u64)rtc_load32(footer + 44) << 32);
+    u64 wall  = (u64)time(NULL);
+    rtc->stamp = rtc_clock(rtc, 0);
+    if (rtc->host && !rtc->halt && wall > saved)
+        rtc_advance(rtc, wall - saved);
+}
+
+void mbc_rtc_store(Cartridge *cart, u8 *footer, u64 now) {
+    MbcRtc *rtc = &cart->mbc.rtc;
+    u8      live[5];
+    u64     wall = (u64)time(NULL);
+
+    rtc_sync(rtc, now);
+    rtc_registers(rtc, live);
+    for (u8 reg = 0; reg < 5; reg++) {
+        rtc_store32(footer + 4 * reg, live[reg]);
+        rtc_store32(footer + 20 + 4 * reg, rtc->latched[reg]);
+    }
+    rtc_store32(footer + 40, (u32)wall);
+    rtc_store32(footer + 44, (u32)(wall >> 32));
+}
@@ -0,0 +1,248 @@
+// src/core/ppu.c
+#include <core/ppu.h>
+#include <gbemu.h>
+
+// ---------------------------------------------
+// Helpers
+// ---------------------------------------------
+
+static bool ppu_enabled(const GameBoy *gb) {
+    return CHECK_BIT(gb->io.lcdc, 7);
+}
+
+// Cycles into the frame at `time` (LCD on)
+static u64 ppu_position(const GameBoy *gb, u64 time) {
+    if (time < gb->ppu.frame_start)
+        return 0;
+    return (time - gb->ppu.frame_start) % PPU_FRAME_CYCLES;
+}
+
+static PpuMode ppu_mode(u64 pos) {
+    u64 dot = pos % PPU_LINE_CYCLES;
+
+    if (pos / PPU_LINE_CYCLES >= PPU_VBLANK_LINE)
+        return PPU_MODE_VBLANK;
+    if (dot < PPU_OAM_CYCLES)
+        return PPU_MODE_OAM;
+    if (dot < PPU_OAM_CYCLES + PPU_DRAW_CYCLES)
+        return PPU_MODE_DRAW;
+    return PPU_MODE_HBLANK;
+}
+
+// LY and the STAT mode / coincidence bits at `time`
+static void ppu_latch(GameBoy *gb, u64 time) {
+    PpuMode mode = PPU_MODE_HBLANK;
+
+    gb->io.ly = 0;
+    if (ppu_enabled(gb)) {
+        u64 pos   = ppu_position(gb, time);
+        gb->io.ly = (u8)(pos / PPU_LINE_CYCLES);
+        mode      = ppu_mode(pos);
+    }
+
+    u8 stat     = MASK_BITS(gb->io.stat, 0x78);
+    gb->io.stat = stat | ((gb->io.ly == gb->io.lyc) << 2) | mode;
+}
+
+// Is any enabled STAT source active at `time`?
+static bool ppu_stat_line(const GameBoy *gb, u64 time) {
+    u64 pos  = ppu_position(gb, time);
+    u8  stat = gb->io.stat;
+
+    if (CHECK_BIT(stat, 6) && pos / PPU_LINE_CYCLES == gb->io.lyc)
+        return true;
+
+    switch (ppu_mode(pos)) {
+        case PPU_MODE_HBLANK:
+            return CHECK_BIT(stat, 3);
+        case PPU_MODE_VBLANK:
+            return CHECK_BIT(stat, 4);
+        case PPU_MODE_OAM:
+            return CHECK_BIT(stat, 5);
+        default:
+            return false;
+    }
+}
+
+// Re-evaluate the STAT line at `time`, INT_LCD on its rising edge
+static void ppu_update_stat(GameBoy *gb, u64 time) {
+    bool line = ppu_enabled(gb) && ppu_stat_line(gb, time);
+
+    if (line && !gb->ppu.stat_line)
+        gb_request_interrupt(gb, INT_LCD);
+    gb->ppu.stat_line = line;
+}
+
+// First VBlank start after `time` (LCD on)
+static u64 ppu_next_vblank(const GameBoy *gb, u64 time) {
+    u64 pos    = ppu_position(gb, time);
+    u64 vblank = (u64)PPU_VBLANK_LINE * PPU_LINE_CYCLES;
+
+    return time - pos + ((pos < vblank) ? vblank : PPU_FRAME_CYCLES + vblank);
+}
+
+// Re-decode row `row` of tile `tile` from its two bit planes (bit 7 = leftmost pixel)
+static void ppu_decode_row(GameBoy *gb, u16 tile, u8 row) {
+    const u8 *planes = &gb->vram[tile * 16 + row * 2];
+    u8       *pixels = &gb->ppu.tiles[tile][row * 8];
+
+    for (int x = 0; x < 8; x++) {
+        u8 bit    = 7 - x;
+        pixels[x] = (u8)(((planes[0] >> bit) & 1) | (((planes[1] >> bit) & 1) << 1));
+    }
+}
+
+// Draw the visible lines whose mode 3 ended in (ppu.time, now]
+static void ppu_render_until(GameBoy *gb, u64 now) {
+    if (!ppu_enabled(gb) || now <= gb->ppu.time)
+        return;
+
+    u64 from = (gb->ppu.time > gb->ppu.frame_start) ? gb->ppu.time : gb->ppu.frame_start;
+    u64 pos  = ppu_position(gb, from);
+    u64 line = pos / PPU_LINE_CYCLES;
+    u64 end  = from - pos % PPU_LINE_CYCLES + PPU_OAM_CYCLES + PPU_DRAW_CYCLES;
+    if (end <= from) {
+        end += PPU_LINE_CYCLES; // Drawn by the previous sync
+        line++;
+    }
+
+    // Frames behind: only the last one would be seen
+    if (end <= now && now - end >= PPU_FRAME_CYCLES) {
+        end += (now - end) / PPU_FRAME_CYCLES * PPU_FRAME_CYCLES;
+        gb->ppu.log_count = 0; // Its line is not drawn
+    }
+
+    for (; end <= now; end += PPU_LINE_CYCLES, line++) {
+        line %= PPU_LINES;
+        if (line < PPU_HEIGHT) {
+            gb->ppu.renderer->render_line(gb, (u8)line);
+            if (gb->ppu.log_line == line)
+                gb->ppu.log_count = 0;
+        }
+        if (line == PPU_HEIGHT - 1)
+            gb->ppu.frames++;
+    }
+}
+
+// Queue EVENT_PPU at the next VBlank, or at the next boundary while a STAT
+// source is enabled. Nothing with the LCD off
+static void ppu_schedule(GameBoy *gb, u64 time) {
+    if (!ppu_enabled(gb)) {
+        gb_cancel_event(gb, EVENT_PPU);
+        return;
+    }
+
+    if (MASK_BITS(gb->io.stat, 0x78) != 0)
+        gb_schedule_event(gb, EVENT_PPU, ppu_next_change(gb, 0xFF41, time));
+    else
+        gb_schedule_event(gb, EVENT_PPU, ppu_next_vblank(gb, time));
+}
+
+// ============================================================================
+// NOTE: PPU API
+// ============================================================================
+void ppu_init(GameBoy *gb) {
+    gb->ppu.frame_start = 0;
+    gb->ppu.time        = 0;
+    gb->ppu.stat_line   = false;
+    gb->ppu.renderer    = &ppu_renderer_auto;
+    gb->ppu.log_count   = 0;
+    gb_set_event_handler(gb, EVENT_PPU, ppu_event);
+
+    ppu_latch(gb, 0);
+    ppu_update_stat(gb, 0);
+    ppu_schedule(gb, 0);
+}
+
+void ppu_sync(GameBoy *gb, u64 now) {
+    if (now < gb->ppu.time)
+        return; // Already past it (event handlers run behind the CPU)
+
+    ppu_render_until(gb, now);
+    gb->ppu.time = now;
+    ppu_latch(gb, now);
+}
+
+void ppu_write(GameBoy *gb, u16 addr, u8 value) {
+    u64 now = gb->ppu.time; // Synced by io_write()
+
+    switch (addr) {
+        case 0xFF40: {
+            bool was_enabled = ppu_enabled(gb);
+            gb->io.lcdc      = value;
+            if (!was_enabled && ppu_enabled(gb)) {
+                gb->ppu.frame_start = now; // Starts over at LY 0
+                gb->ppu.log_count   = 0;
+            }
+            break;
+        }
+        case 0xFF41:
+            gb->io.stat = REPLACE_BITS(gb->io.stat, value, 0x78); // Bits 3-6 writable
+            break;
+        default:
+            gb->io.lyc = value;
+            break;
+    }
+
+    ppu_latch(gb, now);
+    ppu_update_stat(gb, now);
+    ppu_schedule(gb, now);
+}
+
+void ppu_log_write(GameBoy *gb, u16 addr, u8 value) {
+    PPU *ppu = &gb->ppu;
+    u64  pos = ppu_position(gb, ppu->time); // Synced by io_write()
+
+    // STAT, LY, LYC and DMA don't change what is drawn
+    if (addr == 0xFF41 || (addr >= 0xFF44 && addr <= 0xFF46))
+        return;
+    if (!ppu_enabled(gb) || ppu_mode(pos) != PPU_MODE_DRAW)
+        return;
+
+    u8 ly = (u8)(pos / PPU_LINE_CYCLES);
+    if (ppu->log_count == 0 || ppu->log_line != ly) {
+        ppu->log_regs  = (PpuRegs){gb->io.lcdc, gb->io.scy,  gb->io.scx, gb->io.bgp,
+                                   gb->io.obp0, gb->io.obp1, gb->io.wy,  gb->io.wx};
+        ppu->log_line  = ly;
+        ppu->log_count = 0;
+    }
+    if (ppu->log_count < PPU_LOG_WRITES)
+        ppu->log[ppu->log_count++] = (PpuWrite){(u16)(pos % PPU_LINE_CYCLES), (u8)addr, value};
+}
+
+void ppu_vram_write(GameBoy *gb, u16 addr, u8 value) {
+    u16 offset = addr - 0x8000;
+
+    ppu_sync(gb, gb_now(gb)); // Lines drawn so far saw the old value
+    gb->vram[offset] = value;
+
+    if (offset < PPU_TILES * 16)
+        ppu_decode_row(gb, offset / 16, (offset % 16) / 2);
+}
+
+u64 ppu_next_change(const GameBoy *gb, u16 addr, u64 time) {
+    if (!ppu_enabled(gb))
+        return EVENT_NEVER;
+
+    u64 pos        = ppu_position(gb, time);
+    u64 dot        = pos % PPU_LINE_CYCLES;
+    u64 line_start = time - dot;
+
+    // STAT also changes with the mode inside visible lines
+    if (addr == 0xFF41 && pos / PPU_LINE_CYCLES < PPU_VBLANK_LINE) {
+        if (dot < PPU_OAM_CYCLES)
+            return line_start + PPU_OAM_CYCLES;
+        if (dot < PPU_OAM_CYCLES + PPU_DRAW_CYCLES)
+            return line_start + PPU_OAM_CYCLES + PPU_DRAW_CYCLES;
+    }
+    return line_start + PPU_LINE_CYCLES;
+}
+
+void ppu_event(GameBoy *gb, u64 when) {
+    ppu_sync(gb, when);
+
+    if (ppu_position(gb, when) == (u64)PPU_VBLANK_LINE * PPU_LINE_CYCLES)
+        gb_request_interrupt(gb, INT_VBLANK);
+    ppu_update_stat(gb, when);
+    ppu_schedule(gb, when);
+}
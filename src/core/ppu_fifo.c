@@ -0,0 +1,257 @@
+// src/core/ppu_fifo.c
+#include <core/ppu.h>
+#include <gbemu.h>
+#include <string.h>
+
+#define FIFO_FETCH_DOTS  6  // Tile number, data low, data high: 2 dots each
+#define FIFO_FIRST_FETCH 7  // Dots lost to the first fetch of the line, which is thrown away
+#define FIFO_OBJ_DOTS    6  // Sprite fetch, BG fetcher & pixel output paused
+
+// Pixel FIFO state for one line
+// https://gbdev.io/pandocs/pixel_fifo.html
+typedef struct {
+    GameBoy *gb;
+    PpuRegs  regs; // As of the current dot
+    u8       ly;
+    int      lx;   // Next pixel to output, negative while SCX & 7 pixels are dropped
+
+    // Logged writes still to apply
+    const PpuWrite *write;
+    const PpuWrite *write_end;
+
+    // BG / window fetcher and FIFO (palette indices)
+    int       fetch_step; // Dots into the current fetch, negative during the first one
+    u8        fetch_x;    // Tile column, relative to SCX / the window's left edge
+    const u8 *fetched;    // Row of the tile cache read by the fetch
+    bool      window;     // Fetching window tiles
+    bool      window_drawn;
+    u8        bg[8];
+    int       bg_head;
+    int       bg_count;
+
+    // Sprites: the line's OAM scan, the one being fetched, the sprite FIFO
+    // (slot 0 = pixel lx; color 0 = no sprite pixel)
+    const u8 *sprites[PPU_LINE_SPRITES];
+    bool      fetched_obj[PPU_LINE_SPRITES];
+    int       sprite_count;
+    int       obj_pending; // Index into sprites, -1 for none
+    int       obj_wait;
+    u8        obj_color[8];
+    u8        obj_attr[8];
+} PpuFifo;
+
+// ---------------------------------------------
+// Helpers
+// ---------------------------------------------
+
+static u8 fifo_shade(u8 palette, u8 index) {
+    return (palette >> (index * 2)) & 0x03;
+}
+
+// Writes logged up to `dot` take effect
+static void fifo_apply_writes(PpuFifo *f, int dot) {
+    for (; f->write < f->write_end && f->write->dot <= dot; f->write++) {
+        u8 value = f->write->value;
+        switch (f->write->addr) {
+            case 0x40: f->regs.lcdc = value; break;
+            case 0x42: f->regs.scy  = value; break;
+            case 0x43: f->regs.scx  = value; break;
+            case 0x47: f->regs.bgp  = value; break;
+            case 0x48: f->regs.obp0 = value; break;
+            case 0x49: f->regs.obp1 = value; break;
+            case 0x4A: f->regs.wy   = value; break;
+            case 0x4B: f->regs.wx   = value; break;
+            default:   break;
+        }
+    }
+}
+
+// Tile cache row the fetcher reads for its current tile column
+static const u8 *fifo_fetch_row(const PpuFifo *f) {
+    const GameBoy *gb = f->gb;
+    u8             lcdc = f->regs.lcdc;
+    u16            map;
+    u8             x;
+    u8             y;
+
+    if (f->window) {
+        map = CHECK_BIT(lcdc, 6) ? 0x9C00 : 0x9800;
+        x   = f->fetch_x & 31;
+        y   = gb->ppu.window_line;
+    } else {
+        map = CHECK_BIT(lcdc, 3) ? 0x9C00 : 0x9800;
+        x   = (u8)(f->regs.scx / 8 + f->fetch_x) & 31;
+        y   = (u8)(f->ly + f->regs.scy);
+    }
+
+    u8  tile  = gb->vram[map - 0x8000 + (y / 8) * 32 + x];
+    u16 index = (CHECK_BIT(lcdc, 4) || tile >= 0x80) ? tile : 0x100 + tile;
+    return &gb->ppu.tiles[index][(y % 8) * 8];
+}
+
+// One dot of the BG / window fetcher: the tile number on the 2nd dot, the
+// data by the 6th, pushed as soon as the FIFO is empty
+static void fifo_fetch(PpuFifo *f) {
+    if (++f->fetch_step == 2)
+        f->fetched = fifo_fetch_row(f);
+    if (f->fetch_step < FIFO_FETCH_DOTS || f->bg_count != 0)
+        return;
+
+    memcpy(f->bg, f->fetched, 8);
+    f->bg_head    = 0;
+    f->bg_count   = 8;
+    f->fetch_x++;
+    f->fetch_step = 0;
+}
+
+// Sprite pixels go to the FIFO slots still without one: an earlier sprite
+// (smaller X, or same X and earlier in OAM) keeps its pixels
+static void fifo_merge_sprite(PpuFifo *f, const u8 *obj) {
+    u8  height = CHECK_BIT(f->regs.lcdc, 2) ? 16 : 8;
+    u8  attr   = obj[3];
+    u8  row    = (u8)(f->ly - (obj[0] - 16));
+    int left   = obj[1] - 8;
+
+    if (CHECK_BIT(attr, 6))
+        row = height - 1 - row; // Y flip
+    u8 tile = (height == 16) ? (u8)((obj[2] & 0xFE) + row / 8) : obj[2];
+
+    const u8 *pixels = &f->gb->ppu.tiles[tile][(row % 8) * 8];
+    for (int px = 0; px < 8; px++) {
+        int slot = left + px - f->lx;
+        if (slot < 0 || slot >= 8 || f->obj_color[slot] != 0)
+            continue;
+        f->obj_color[slot] = pixels[CHECK_BIT(attr, 5) ? 7 - px : px]; // X flip
+        f->obj_attr[slot]  = attr;
+    }
+}
+
+// Next sprite to fetch: the output reached its left edge, smallest X first
+// (several are due at once at the left edge of the screen), then OAM order
+static int fifo_sprite_due(const PpuFifo *f) {
+    int due = -1;
+
+    if (!CHECK_BIT(f->regs.lcdc, 1) || f->lx < 0)
+        return -1;
+
+    for (int i = 0; i < f->sprite_count; i++) {
+        u8 x = f->sprites[i][1];
+        if (!f->fetched_obj[i] && x <= f->lx + 8 && (due < 0 || x < f->sprites[due][1]))
+            due = i;
+    }
+    return due;
+}
+
+// Pop a pixel from both FIFOs and mix it (palettes as of this dot)
+static void fifo_output(PpuFifo *f) {
+    u8 bg = f->bg[f->bg_head++];
+    f->bg_count--;
+
+    if (f->lx < 0) {
+        f->lx++; // Fine scroll: dropped
+        return;
+    }
+
+    if (!CHECK_BIT(f->regs.lcdc, 0))
+        bg = 0; // BG & window blank
+
+    u8 color = f->obj_color[0];
+    u8 attr  = f->obj_attr[0];
+    u8 shade = fifo_shade(f->regs.bgp, bg);
+    if (color != 0 && CHECK_BIT(f->regs.lcdc, 1) && !(CHECK_BIT(attr, 7) && bg != 0))
+        shade = fifo_shade(CHECK_BIT(attr, 4) ? f->regs.obp1 : f->regs.obp0, color);
+
+    f->gb->ppu.framebuffer[f->ly][f->lx++] = shade;
+    memmove(f->obj_color, f->obj_color + 1, 7);
+    memmove(f->obj_attr, f->obj_attr + 1, 7);
+    f->obj_color[7] = 0;
+}
+
+// The window takes over once the output reaches WX - 7: FIFO cleared,
+// fetcher restarted on the window map
+static void fifo_check_window(PpuFifo *f) {
+    u8  wx    = f->regs.wx;
+    int start = (wx < 7) ? 0 : wx - 7;
+
+    if (f->window || f->lx != start || !CHECK_BIT(f->regs.lcdc, 5) ||
+        !f->gb->ppu.window_active || wx > 166)
+        return;
+
+    f->window       = true;
+    f->window_drawn = true;
+    f->fetch_x      = 0;
+    f->fetch_step   = 0;
+    f->bg_count     = 0;
+}
+
+// ============================================================================
+// NOTE: Pixel FIFO Renderer
+// Mode 3 dot by dot from dot 80: the fetcher fills the BG FIFO a tile at a
+// time, each dot outputs a pixel, sprites pause both while they are fetched.
+// Palettes are read as pixels leave the FIFO and the tile map / SCX as tiles
+// are fetched, so logged mid-line writes land on the pixels they would hit.
+// ============================================================================
+void ppu_fifo_render_line(GameBoy *gb, u8 ly) {
+    PPU    *ppu    = &gb->ppu;
+    PpuFifo f      = {0};
+    bool    logged = ppu->log_count != 0 && ppu->log_line == ly;
+
+    f.gb          = gb;
+    f.ly          = ly;
+    f.regs        = logged ? ppu->log_regs
+                           : (PpuRegs){gb->io.lcdc, gb->io.scy,  gb->io.scx, gb->io.bgp,
+                                       gb->io.obp0, gb->io.obp1, gb->io.wy,  gb->io.wx};
+    f.write       = ppu->log;
+    f.write_end   = ppu->log + (logged ? ppu->log_count : 0);
+    f.fetch_step  = -FIFO_FIRST_FETCH;
+    f.lx          = -(f.regs.scx % 8);
+    f.obj_pending = -1;
+
+    if (ly == 0) {
+        ppu->window_line   = 0;
+        ppu->window_active = false;
+    }
+    if (ly == f.regs.wy)
+        ppu->window_active = true;
+
+    // OAM scan (mode 2): the first 10 sprites covering the line
+    u8 height = CHECK_BIT(f.regs.lcdc, 2) ? 16 : 8;
+    for (int i = 0; i < 40 && f.sprite_count < PPU_LINE_SPRITES; i++) {
+        const u8 *obj = &gb->oam[i * 4];
+        int       top = obj[0] - 16;
+        if (ly >= top && ly < top + height)
+            f.sprites[f.sprite_count++] = obj;
+    }
+
+    int dot = PPU_OAM_CYCLES;
+    for (; f.lx < PPU_WIDTH; dot++) {
+        fifo_apply_writes(&f, dot);
+        fifo_check_window(&f);
+
+        if (f.obj_pending < 0)
+            f.obj_pending = fifo_sprite_due(&f);
+
+        // A sprite waits for the current BG fetch, then takes 6 dots
+        if (f.obj_pending >= 0) {
+            if (f.obj_wait == 0 && (f.fetch_step < FIFO_FETCH_DOTS - 1 || f.bg_count == 0)) {
+                fifo_fetch(&f);
+                continue;
+            }
+            if (++f.obj_wait == FIFO_OBJ_DOTS) {
+                fifo_merge_sprite(&f, f.sprites[f.obj_pending]);
+                f.fetched_obj[f.obj_pending] = true;
+                f.obj_pending                = -1;
+                f.obj_wait                   = 0;
+            }
+            continue;
+        }
+
+        fifo_fetch(&f);
+        if (f.bg_count != 0)
+            fifo_output(&f);
+    }
+
+    if (f.window_drawn)
+        ppu->window_line++;
+    ppu->draw_cycles = (u16)(dot - PPU_OAM_CYCLES);
+}
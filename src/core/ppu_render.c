@@ -0,0 +1,175 @@
+// src/core/ppu_render.c
+#include <core/ppu.h>
+#include <gbemu.h>
+#include <string.h>
+
+// ---------------------------------------------
+// Helpers
+// ---------------------------------------------
+
+// Shade of palette index `index` in palette register `palette`
+static u8 ppu_shade(u8 palette, u8 index) {
+    return (palette >> (index * 2)) & 0x03;
+}
+
+// Tile cache index of BG / window tile number `tile`
+// LCDC bit 4 set: 0x8000 + tile * 16, clear: 0x9000 + (s8)tile * 16
+static u16 ppu_bg_tile(const GameBoy *gb, u8 tile) {
+    if (CHECK_BIT(gb->io.lcdc, 4) || tile >= 0x80)
+        return tile;
+    return 0x100 + tile;
+}
+
+// Palette indices of `count` pixels of tile map `map` (0x9800 / 0x9C00),
+// pixel row `y`, from pixel column `x` (both wrap at 256)
+static void ppu_map_row(const GameBoy *gb, u8 *out, u16 map, u8 y, u8 x, int count) {
+    const u8 *row   = &gb->vram[map - 0x8000 + (y / 8) * 32];
+    u8        fine  = (y % 8) * 8;
+    int       drawn = 0;
+
+    while (drawn < count) {
+        const u8 *pixels = &gb->ppu.tiles[ppu_bg_tile(gb, row[x / 8])][fine];
+        int       run    = 8 - x % 8;
+        if (run > count - drawn)
+            run = count - drawn;
+
+        memcpy(out + drawn, pixels + x % 8, (size_t)run);
+        drawn += run;
+        x     += (u8)run;
+    }
+}
+
+// ---------------------------------------------
+// Sprites
+// ---------------------------------------------
+
+// Draw the sprites of line `ly` over `out`, `bg` holds the BG / window
+// palette indices (sprites with the BG priority flag only show over 0)
+static void ppu_render_sprites(GameBoy *gb, u8 ly, const u8 *bg, u8 *out) {
+    u8        height = CHECK_BIT(gb->io.lcdc, 2) ? 16 : 8;
+    const u8 *picked[PPU_LINE_SPRITES];
+    int       count = 0;
+
+    // OAM scan: the first 10 sprites covering the line, whatever their X
+    for (int i = 0; i < 40 && count < PPU_LINE_SPRITES; i++) {
+        const u8 *obj = &gb->oam[i * 4];
+        int       top = obj[0] - 16;
+        if (ly >= top && ly < top + height)
+            picked[count++] = obj;
+    }
+
+    // Priority: smaller X first, OAM order between equal X (stable sort)
+    for (int i = 1; i < count; i++) {
+        const u8 *obj = picked[i];
+        int       j   = i;
+        for (; j > 0 && picked[j - 1][1] > obj[1]; j--)
+            picked[j] = picked[j - 1];
+        picked[j] = obj;
+    }
+
+    // Lowest priority first, the winning sprite's opaque pixels end on top
+    for (int i = count - 1; i >= 0; i--) {
+        const u8 *obj  = picked[i];
+        u8        attr = obj[3];
+        u8        row  = (u8)(ly - (obj[0] - 16));
+        u8        pal  = CHECK_BIT(attr, 4) ? gb->io.obp1 : gb->io.obp0;
+        int       left = obj[1] - 8;
+
+        if (CHECK_BIT(attr, 6))
+            row = height - 1 - row; // Y flip
+        u8 tile = (height == 16) ? (u8)((obj[2] & 0xFE) + row / 8) : obj[2];
+
+        const u8 *pixels = &gb->ppu.tiles[tile][(row % 8) * 8];
+        for (int px = 0; px < 8; px++) {
+            int x = left + px;
+            if (x < 0 || x >= PPU_WIDTH)
+                continue;
+
+            u8 index = pixels[CHECK_BIT(attr, 5) ? 7 - px : px]; // X flip
+            if (index == 0)
+                continue; // Transparent
+
+            if (CHECK_BIT(attr, 7) && bg[x] != 0)
+                out[x] = ppu_shade(gb->io.bgp, bg[x]); // Behind BG colors 1-3
+            else
+                out[x] = ppu_shade(pal, index);
+        }
+    }
+}
+
+// ============================================================================
+// NOTE: Scanline Renderer
+// A whole line at once from the tile cache: tile-sized runs of the BG and
+// window maps, then the line's sprites. No per-dot state: writes made
+// during mode 3 apply to the whole line (see ppu_fifo.c for the exact one).
+// ============================================================================
+void ppu_render_line(GameBoy *gb, u8 ly) {
+    PPU *ppu  = &gb->ppu;
+    u8   lcdc = gb->io.lcdc;
+    u8  *out  = ppu->framebuffer[ly];
+    u8   bg[PPU_WIDTH];
+
+    // The window starts on the first line LY == WY, in every frame
+    if (ly == 0) {
+        ppu->window_line   = 0;
+        ppu->window_active = false;
+    }
+    if (ly == gb->io.wy)
+        ppu->window_active = true;
+
+    // LCDC bit 0 clear: BG & window blank (white)
+    if (!CHECK_BIT(lcdc, 0)) {
+        memset(bg, 0, sizeof(bg));
+        memset(out, 0, PPU_WIDTH);
+    } else {
+        u16 map = CHECK_BIT(lcdc, 3) ? 0x9C00 : 0x9800;
+        ppu_map_row(gb, bg, map, (u8)(ly + gb->io.scy), gb->io.scx, PPU_WIDTH);
+
+        // Window from X = WX - 7, its own map and line counter
+        if (CHECK_BIT(lcdc, 5) && ppu->window_active && gb->io.wx <= 166) {
+            int wx    = gb->io.wx - 7;
+            int start = (wx < 0) ? 0 : wx;
+            u16 wmap  = CHECK_BIT(lcdc, 6) ? 0x9C00 : 0x9800;
+
+            ppu_map_row(gb, bg + start, wmap, ppu->window_line, (u8)(start - wx),
+                        PPU_WIDTH - start);
+            ppu->window_line++;
+        }
+
+        for (int x = 0; x < PPU_WIDTH; x++)
+            out[x] = ppu_shade(gb->io.bgp, bg[x]);
+    }
+
+    if (CHECK_BIT(lcdc, 1))
+        ppu_render_sprites(gb, ly, bg, out);
+}
+
+// ============================================================================
+// NOTE: Renderers
+// ============================================================================
+
+// The scanline renderer unless the line had writes during its mode 3
+static void ppu_render_auto(GameBoy *gb, u8 ly) {
+    if (gb->ppu.log_count != 0 && gb->ppu.log_line == ly)
+        ppu_fifo_render_line(gb, ly);
+    else
+        ppu_render_line(gb, ly);
+}
+
+const PpuRenderer ppu_renderer_scanline = {"scanline", ppu_render_line};
+const PpuRenderer ppu_renderer_fifo     = {"fifo", ppu_fifo_render_line};
+const PpuRenderer ppu_renderer_auto     = {"auto", ppu_render_auto};
+
+const PpuRenderer *ppu_renderer_find(const char *name) {
+    static const PpuRenderer *const renderers[] = {
+        &ppu_renderer_scanline,
+        &ppu_renderer_fifo,
+        &ppu_renderer_auto,
+    };
+
+    for (size_t i = 0; i < sizeof(renderers) / sizeof(renderers[0]); i++) {
+        if (strcmp(renderers[i]->name, name) == 0)
+            return renderers[i];
+    }
+    return NULL;
+}
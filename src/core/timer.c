@@ -0,0 +1,189 @@
+// src/core/timer.c
+#include <core/timer.h>
+#include <gbemu.h>
+
+// ---------------------------------------------
+// Helpers
+// ---------------------------------------------
+
+// System counter bit whose falling edge clocks TIMA, per TAC clock select
+// (4096 Hz, 262144 Hz, 65536 Hz, 16384 Hz)
+static const u8 tac_bit[4] = {9, 3, 5, 7};
+
+static bool timer_enabled(const GameBoy *gb) {
+    return CHECK_BIT(gb->io.tac, 2);
+}
+
+// Cycles between two TIMA increments
+static u64 timer_period(const GameBoy *gb) {
+    return (u64)2 << tac_bit[gb->io.tac & 0x03];
+}
+
+// System counter at `time`, without wrapping (only its low 16 bits exist)
+static u64 timer_counter(const GameBoy *gb, u64 time) {
+    return time - gb->timer.div_base;
+}
+
+// Time of the `n`-th TIMA increment after `time` (n >= 1)
+static u64 timer_edge(const GameBoy *gb, u64 time, u64 n) {
+    u64 period = timer_period(gb);
+    u64 edge   = (timer_counter(gb, time) / period + n) * period;
+    return edge + gb->timer.div_base;
+}
+
+// TIMA overflowed at `time`: reads 0 until TMA is reloaded
+static void timer_start_reload(GameBoy *gb, u64 time) {
+    gb->io.tima      = 0x00;
+    gb->timer.time   = time;
+    gb->timer.reload = time + TIMER_RELOAD;
+}
+
+// One TIMA increment at `time` outside the regular edges (DIV / TAC glitch)
+static void timer_tick(GameBoy *gb, u64 time) {
+    if (gb->io.tima == 0xFF)
+        timer_start_reload(gb, time);
+    else
+        gb->io.tima++;
+}
+
+// ---------------------------------------------
+// Bring TIMA up to `now`, reloading TMA and raising the interrupt for
+// every overflow on the way
+// ---------------------------------------------
+void timer_sync(GameBoy *gb, u64 now) {
+    Timer *timer = &gb->timer;
+
+    while (timer->time < now) {
+        if (timer->reload != EVENT_NEVER) {
+            // No edge falls inside the reload delay (the shortest period is 16)
+            if (now < timer->reload) {
+                timer->time = now;
+                return;
+            }
+            gb->io.tima   = gb->io.tma;
+            timer->time   = timer->reload;
+            timer->reload = EVENT_NEVER;
+            gb_request_interrupt(gb, INT_TIMER);
+            continue;
+        }
+
+        if (!timer_enabled(gb)) {
+            timer->time = now;
+            return;
+        }
+
+        u64 period = timer_period(gb);
+        u64 ticks  = timer_counter(gb, now) / period - timer_counter(gb, timer->time) / period;
+        u64 room   = 0x100 - gb->io.tima;
+
+        if (ticks < room) {
+            gb->io.tima += (u8)ticks;
+            timer->time  = now;
+            return;
+        }
+        timer_start_reload(gb, timer_edge(gb, timer->time, room));
+    }
+}
+
+// Queue EVENT_TIMER at the next reload, nothing while the timer is stopped
+static void timer_schedule(GameBoy *gb) {
+    Timer *timer = &gb->timer;
+
+    if (timer->reload != EVENT_NEVER)
+        gb_schedule_event(gb, EVENT_TIMER, timer->reload);
+    else if (timer_enabled(gb))
+        gb_schedule_event(gb, EVENT_TIMER,
+                          timer_edge(gb, timer->time, 0x100 - gb->io.tima) + TIMER_RELOAD);
+    else
+        gb_cancel_event(gb, EVENT_TIMER);
+}
+
+// Is the signal TIMA counts the falling edges of high at `time`?
+static bool timer_signal(const GameBoy *gb, u64 time) {
+    u64 half = timer_period(gb) / 2;
+    return timer_enabled(gb) && (timer_counter(gb, time) & half);
+}
+
+// ============================================================================
+// NOTE: Timer API
+// ============================================================================
+void timer_init(GameBoy *gb) {
+    gb->timer.div_base = 0 - (u64)TIMER_DIV_RESET;
+    gb->timer.time     = 0;
+    gb->timer.reload   = EVENT_NEVER;
+    gb_set_event_handler(gb, EVENT_TIMER, timer_overflow);
+}
+
+u8 timer_read(GameBoy *gb, u16 addr) {
+    switch (addr) {
+        case 0xFF04:
+            return (u8)(timer_counter(gb, gb->timer.time) >> 8);
+        case 0xFF05:
+            return gb->io.tima;
+        case 0xFF06:
+            return gb->io.tma;
+        default:
+            return gb->io.tac | 0xF8;
+    }
+}
+
+void timer_write(GameBoy *gb, u16 addr, u8 value) {
+    u64 now = gb->timer.time; // Synced by io_write()
+
+    switch (addr) {
+        case 0xFF04:
+            timer_reset_div(gb);
+            return;
+
+        case 0xFF05:
+            // A write during the reload delay cancels the reload & interrupt
+            gb->io.tima      = value;
+            gb->timer.reload = EVENT_NEVER;
+            break;
+
+        case 0xFF06:
+            gb->io.tma = value; // Also what a pending reload loads
+            break;
+
+        default: {
+            // Switching the selected bit / disabling while the signal is high
+            // is a falling edge too
+            bool before = timer_signal(gb, now);
+            gb->io.tac  = MASK_BITS(value, 0x07);
+            if (before && !timer_signal(gb, now))
+                timer_tick(gb, now);
+            break;
+        }
+    }
+    timer_schedule(gb);
+}
+
+void timer_reset_div(GameBoy *gb) {
+    u64 now = gb_now(gb);
+
+    timer_sync(gb, now);
+
+    // Clearing the counter drops the selected bit if it was set
+    if (timer_signal(gb, now))
+        timer_tick(gb, now);
+
+    gb->timer.div_base = now;
+    timer_schedule(gb);
+}
+
+u64 timer_next_change(const GameBoy *gb, u16 addr, u64 time) {
+    // DIV: the next multiple of 256 of the system counter
+    if (addr == 0xFF04)
+        return (timer_counter(gb, time) / 0x100 + 1) * 0x100 + gb->timer.div_base;
+
+    // TIMA: the next edge or the pending reload
+    u64 next = timer_enabled(gb) ? timer_edge(gb, time, 1) : EVENT_NEVER;
+    if (gb->timer.reload < next)
+        next = gb->timer.reload;
+    return next;
+}
+
+void timer_overflow(GameBoy *gb, u64 when) {
+    timer_sync(gb, when);
+    timer_schedule(gb);
+}
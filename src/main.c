@@ -2,24 +2,34 @@
 #include <core/cartridge.h>
 #include <core/bus.h>
 #include <core/cpu/cpu.h>
+#include <core/library.h>
+#include <core/ppu.h>
 #include <gbemu.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#define RUN_DEBUG_INTERVAL 1000
+#define RUN_SLICE_CYCLES 4000   // Cycles per gb_run() call in run mode (~1000 instructions)
+#define RUN_MAX_CYCLES   400000 // Run mode timeout (~100000 instructions)
 
 // Print the usage information
 static void print_usage(const char *program_name) {
     printf("Usage: %s [options] <path_to_rom>\n", program_name);
+    printf("       %s -l <dir> [-j] [-c <cache.csv>] [-t <threads>]\n", program_name);
     printf("\n");
     printf("Modes (mutually exclusive):\n");
-    printf("  -i               Info mode (default): load ROM, print header info, then exit\n");
+    printf("  -i               Info mode (default): read the ROM header, print it, then exit\n");
     printf("  -s <num>         Step mode: execute exactly <num> CPU instructions\n");
     printf("  -r               Run mode: execute instructions until timeout or HALT\n");
+    printf("  -l <dir>         Library mode: index the ROMs under <dir> to stdout (CSV)\n");
     printf("\n");
     printf("Other options:\n");
     printf("  -d               Debug mode (verbose CPU state output)\n");
+    printf("  -w               MBC3 clock follows the host time (default: emulated cycles)\n");
+    printf("  -p <renderer>    PPU renderer: scanline, fifo (dot-accurate) or auto (default)\n");
+    printf("  -j               Library mode: write the index as JSON\n");
+    printf("  -c <cache.csv>   Library mode: reuse & update a CSV index (incremental rescan)\n");
+    printf("  -t <threads>     Library mode: probe threads (default: one per CPU)\n");
     printf("  -h               Show this help message\n");
 }
 
@@ -46,17 +56,17 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
-    // Print banner
-    printf("=================================\n");
-    printf("          BareDMG\n");
-    printf("    Game Boy Emulator (DMG-01)\n");
-    printf("=================================\n\n");
-
     const char *rom_path       = NULL;
+    const char *library_dir    = NULL;
+    const char *cache_path     = NULL;
+    bool        library_json   = false;
+    int         threads        = 0;
     bool        mode_specified = false;
     bool        run_mode       = false;
     bool        debug_mode     = false;
     bool        info_mode      = false;
+    bool        rtc_host       = false;
+    const char *renderer       = NULL;
     int         step_count     = 0;
 
     // Parse arguments
@@ -105,6 +115,38 @@ int main(int argc, char *argv[]) {
                 debug_mode = true;
             }
 
+            else if (strcmp(argv[i], "-l") == 0 || strcmp(argv[i], "-c") == 0 ||
+                     strcmp(argv[i], "-t") == 0) {
+                if (i + 1 >= argc) {
+                    fprintf(stderr, "Error: %s requires an argument\n", argv[i]);
+                    return 1;
+                }
+                if (argv[i][1] == 'l') {
+                    library_dir    = argv[++i];
+                    mode_specified = true;
+                } else if (argv[i][1] == 'c') {
+                    cache_path = argv[++i];
+                } else {
+                    threads = atoi(argv[++i]);
+                }
+            }
+
+            else if (strcmp(argv[i], "-w") == 0) {
+                rtc_host = true;
+            }
+
+            else if (strcmp(argv[i], "-p") == 0) {
+                if (i + 1 >= argc || !ppu_renderer_find(argv[i + 1])) {
+                    fprintf(stderr, "Error: -p requires scanline, fifo or auto\n");
+                    return 1;
+                }
+                renderer = argv[++i];
+            }
+
+            else if (strcmp(argv[i], "-j") == 0) {
+                library_json = true;
+            }
+
             else {
                 fprintf(stderr, "Unknown option: %s\n", argv[i]);
                 print_usage(argv[0]);
@@ -122,6 +164,46 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    // Library mode: stdout only carries the index
+    if (library_dir) {
+        if (run_mode || step_count > 0 || info_mode || rom_path) {
+            fprintf(stderr, "Error: -l takes a directory, not a ROM or another mode\n");
+            return 1;
+        }
+
+        Library cache  = {0};
+        Library lib;
+        bool    cached = cache_path && library_load(&cache, cache_path) == 0;
+
+        if (library_scan(&lib, library_dir, cached ? &cache : NULL, threads) != 0) {
+            fprintf(stderr, "Error: Cannot open directory %s\n", library_dir);
+            library_free(&cache);
+            return 1;
+        }
+        library_write(&lib, stdout, library_json ? LIBRARY_JSON : LIBRARY_CSV);
+        fprintf(stderr, "Indexed %zu ROMs (%zu probed, %zu cached)\n", lib.count, lib.probed,
+                lib.count - lib.probed);
+
+        // Rewrite the cache with the new index
+        FILE *out = cache_path ? fopen(cache_path, "w") : NULL;
+        if (out) {
+            library_write(&lib, out, LIBRARY_CSV);
+            fclose(out);
+        } else if (cache_path) {
+            fprintf(stderr, "Warning: Cannot write cache %s\n", cache_path);
+        }
+
+        library_free(&lib);
+        library_free(&cache);
+        return 0;
+    }
+
+    // Print banner
+    printf("=================================\n");
+    printf("          BareDMG\n");
+    printf("    Game Boy Emulator (DMG-01)\n");
+    printf("=================================\n\n");
+
     // Check if the ROM file was provided
     if (!rom_path) {
         fprintf(stderr, "Error: No ROM file specified\n\n");
@@ -139,9 +221,28 @@ int main(int argc, char *argv[]) {
         printf("Note: debug mode (-d) has no effect in info mode\n\n");
     }
 
+    // Info mode: only the header is read, the ROM isn't mapped
+    if (info_mode) {
+        RawRomHeader raw;
+        CartHeader   header;
+
+        int status = cart_probe(rom_path, &raw, &header);
+        if (status > 0) {
+            fprintf(stderr, "Failed to read ROM header (%s)\n",
+                    status == 2 ? "file too small" : "cannot read file");
+            return 1;
+        }
+        cart_print_header(&header);
+        printf("\nCartridge header checksum: %s\n", status == 0 ? "OK" : "FAILED");
+        return (status == 0) ? 0 : 1;
+    }
+
     // Initialize Game Boy and load ROM
     GameBoy gb;
     gb_init(&gb);
+    gb.cart.rtc_host = rtc_host;
+    if (renderer)
+        gb.ppu.renderer = ppu_renderer_find(renderer);
     gb_load_rom(&gb, rom_path);
 
     if (!gb.running) {
@@ -151,12 +252,6 @@ int main(int argc, char *argv[]) {
 
     printf("ROM Loaded Successfully!\n");
 
-    // Info mode: Exit after loading & printing cartridge info
-    if (info_mode) {
-        cart_unload(&gb.cart);
-        return 0;
-    }
-
     // Step mode
     if (step_count > 0) {
         printf("\nExecuting %d instructions...\n\n", step_count);
@@ -171,7 +266,7 @@ int main(int argc, char *argv[]) {
                        "SP=%04X F=%02X\n",
                        i, pc_before, opcode, gb.cpu.regs.a, gb.cpu.regs.b, gb.cpu.regs.c,
                        gb.cpu.regs.d, gb.cpu.regs.e, gb.cpu.regs.h, gb.cpu.regs.l, gb.cpu.sp,
-                       gb.cpu.regs.f);
+                       GET_LOW_BYTE(cpu_read_af(&gb.cpu)));
             }
 
             gb_step(&gb);
@@ -195,23 +290,47 @@ int main(int argc, char *argv[]) {
     // Run mode
     else if (run_mode) {
         printf("Running emulator (press Ctrl+C to stop)...\n");
-        printf("NOTE: No PPU/APU yet, this will just execute instructions.\n\n");
+        printf("NOTE: No APU yet, sound registers are stored but not played.\n\n");
 
-        for (int i = 0; i < 100000 && gb.running && !gb.cpu.halted; i++) {
-            gb_step(&gb);
+        // Stop at a HALT nothing is scheduled to wake up from
+        while (gb.cycles < RUN_MAX_CYCLES && gb.running &&
+               !(gb.cpu.halted && gb_next_event(&gb) == EVENT_NEVER)) {
+            gb_run(&gb, RUN_SLICE_CYCLES);
 
-            // Verbose output per interval if debug mode
-            if (debug_mode && (i % RUN_DEBUG_INTERVAL == 0)) {
-                printf("[RUN %06d] PC=0x%04X SP=0x%04X AF=%04X BC=%04X DE=%04X HL=%04X\n", i,
-                       gb.cpu.pc, gb.cpu.sp, cpu_read_af(&gb.cpu), cpu_read_bc(&gb.cpu),
-                       cpu_read_de(&gb.cpu), cpu_read_hl(&gb.cpu));
+            // Verbose output per slice if debug mode
+            if (debug_mode) {
+                printf("[RUN %08llu] PC=0x%04X SP=0x%04X AF=%04X BC=%04X DE=%04X HL=%04X\n",
+                       (unsigned long long)gb.cycles, gb.cpu.pc, gb.cpu.sp, cpu_read_af(&gb.cpu),
+                       cpu_read_bc(&gb.cpu), cpu_read_de(&gb.cpu), cpu_read_hl(&gb.cpu));
             }
         }
 
         printf("\nEmulation finished.\n");
         print_cpu_state(&gb);
+
+        // Lines still to draw since the last LCD / VRAM access
+        ppu_sync(&gb, gb.cycles);
+        printf("  Frames drawn: %llu\n", (unsigned long long)gb.ppu.frames);
+
+        // Busy-wait loops fast-forwarded by the block engines (see cpu_block.h)
+        printf("  Idle loops: %llu skipped, %llu cycles (%.1f%%)\n",
+               (unsigned long long)gb.blocks.idle_skips,
+               (unsigned long long)gb.blocks.idle_cycles,
+               gb.cycles ? 100.0 * (double)gb.blocks.idle_cycles / (double)gb.cycles : 0.0);
+
+        // Bank-select writes that remapped ROM / RAM (see mbc.h), per 70224-cycle frame
+        double frames = (double)gb.cycles / 70224.0;
+        printf("  Bank switches: %llu ROM, %llu RAM (%.1f / %.1f per frame)\n",
+               (unsigned long long)gb.cart.mbc.rom_switches,
+               (unsigned long long)gb.cart.mbc.ram_switches,
+               frames > 0 ? (double)gb.cart.mbc.rom_switches / frames : 0.0,
+               frames > 0 ? (double)gb.cart.mbc.ram_switches / frames : 0.0);
+        if (gb.cart.save)
+            printf("  Save file: %llu flushes\n", (unsigned long long)gb.cart.save_syncs);
     }
 
+    // Store the clock as of now with the save
+    cart_flush_save(&gb.cart, gb.cycles);
     cart_unload(&gb.cart);
     puts("\nExiting...\n");
     return 0;
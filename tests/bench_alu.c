@@ -0,0 +1,93 @@
+// tests/bench_alu.c
+// Microbenchmark for the 8-bit ALU kernels (eager flags).
+// Build both paths in Release mode to compare them:
+//   cmake -DCMAKE_BUILD_TYPE=Release -DCPU_ALU_TABLES=ON  .. && make bench_alu && ./tests/bench_alu
+//   cmake -DCMAKE_BUILD_TYPE=Release -DCPU_ALU_TABLES=OFF .. && make bench_alu && ./tests/bench_alu
+#include <core/cpu/cpu.h>
+#include <core/cpu/cpu_alu.h>
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_PASSES 200 // Passes over all 65536 (a, b) pairs per kernel
+
+#ifdef CPU_ALU_TABLES
+#define ALU_PATH "tables"
+#else
+#define ALU_PATH "arithmetic"
+#endif
+
+typedef u8 (*BenchKernel)(CPU *cpu, u8 a, u8 b);
+
+static u8 bench_add(CPU *cpu, u8 a, u8 b) {
+    return alu_add(cpu, a, b, 0);
+}
+
+static u8 bench_adc(CPU *cpu, u8 a, u8 b) {
+    return alu_add(cpu, a, b, cpu_flag_c(cpu));
+}
+
+static u8 bench_sub(CPU *cpu, u8 a, u8 b) {
+    return alu_sub(cpu, a, b, 0);
+}
+
+static u8 bench_sbc(CPU *cpu, u8 a, u8 b) {
+    return alu_sub(cpu, a, b, cpu_flag_c(cpu));
+}
+
+static u8 bench_inc(CPU *cpu, u8 a, u8 b) {
+    return alu_inc(cpu, a ^ b);
+}
+
+static u8 bench_dec(CPU *cpu, u8 a, u8 b) {
+    return alu_dec(cpu, a ^ b);
+}
+
+static u8 bench_daa(CPU *cpu, u8 a, u8 b) {
+    cpu_flags_write(cpu, b & 0x70);
+    return alu_daa(cpu, a);
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Force the kernel to be inlined into its own loop
+static inline __attribute__((always_inline)) void bench_kernel(const char *name,
+                                                                BenchKernel kernel) {
+    CPU         cpu = {0};
+    volatile u8 sink;
+    u8          acc = 0;
+
+    double      start = now_seconds();
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        for (int a = 0; a < 256; a++) {
+            for (int b = 0; b < 256; b++) {
+                acc += kernel(&cpu, a, b);
+                acc ^= cpu.regs.f;
+            }
+        }
+    }
+    double elapsed = now_seconds() - start;
+    sink           = acc;
+    (void)sink;
+
+    double ops     = (double)BENCH_PASSES * 65536.0;
+    printf("%-6s %6.2f ns/op  (%7.1f M ops/s)\n", name, elapsed / ops * 1e9, ops / elapsed / 1e6);
+}
+
+int main(void) {
+    cpu_alu_init();
+
+    printf("ALU benchmark (%s): %d passes per kernel\n\n", ALU_PATH, BENCH_PASSES);
+    bench_kernel("ADD", bench_add);
+    bench_kernel("ADC", bench_adc);
+    bench_kernel("SUB", bench_sub);
+    bench_kernel("SBC", bench_sbc);
+    bench_kernel("INC", bench_inc);
+    bench_kernel("DEC", bench_dec);
+    bench_kernel("DAA", bench_daa);
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+// tests/bench_dispatch.c
+// Instructions-per-second benchmark for the CPU dispatch engines.
+// Build in Release mode for meaningful numbers:
+//   cmake -DCMAKE_BUILD_TYPE=Release .. && make bench_dispatch && ./tests/bench_dispatch
+#include <gbemu.h>
+#include <core/cpu/cpu.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_FRAMES       600   // 10 emulated seconds per engine
+#define BENCH_FRAME_CYCLES 70224 // Cycles per frame @ 59.7 Hz
+
+// ---------------------------------------------
+// Benchmark program
+// A register/memory mix similar to typical game inner loops
+// ---------------------------------------------
+static const u8 bench_program[] = {
+    0x21, 0x00, 0xC0, // 0x0100: LD HL, 0xC000
+    0x06, 0x03,       // 0x0103: LD B, 0x03
+    0x1E, 0x5A,       // 0x0105: LD E, 0x5A
+                      // loop:
+    0x3C,             // 0x0107: INC A
+    0x80,             // 0x0108: ADD A, B
+    0x4F,             // 0x0109: LD C, A
+    0x15,             // 0x010A: DEC D
+    0xAB,             // 0x010B: XOR E
+    0x77,             // 0x010C: LD (HL), A
+    0x7E,             // 0x010D: LD A, (HL)
+    0xFE, 0x10,       // 0x010E: CP 0x10
+    0x20, 0xF5,       // 0x0110: JR NZ, loop
+    0x18, 0xF3,       // 0x0112: JR loop
+};
+
+// Instructions & cycles for one pass through the loop when JR NZ is taken
+#define LOOP_INSTRS 9
+#define LOOP_CYCLES 56
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void bench_engine(GameBoy *gb, CpuDispatch dispatch) {
+    gb_init(gb);
+    gb->cart.rom      = calloc(1, 0x8000);
+    gb->cart.rom_size = 0x8000;
+    memcpy(gb->cart.rom + 0x0100, bench_program, sizeof(bench_program));
+    gb->running      = true;
+    gb->cpu.dispatch = dispatch;
+
+    // cpu_run(), not cpu_dispatch(): it clears the exit request gb_init()
+    // leaves behind (scheduling EVENT_PPU) and writes gb->cycles back
+    double start = now_seconds();
+    for (int frame = 0; frame < BENCH_FRAMES; frame++) {
+        if (cpu_run(&gb->cpu, BENCH_FRAME_CYCLES) == 0) {
+            fprintf(stderr, "%s: no progress in frame %d\n", cpu_dispatch_name(dispatch), frame);
+            exit(1);
+        }
+    }
+    double elapsed = now_seconds() - start;
+    u64    cycles  = gb->cycles;
+
+    // Nearly every executed instruction is inside the loop
+    double instrs  = (double)cycles / LOOP_CYCLES * LOOP_INSTRS;
+
+    printf("%-32s %8.2f M instr/s  (%6.1fx real time)\n", cpu_dispatch_name(dispatch),
+           instrs / elapsed / 1e6, (double)cycles / 4194304.0 / elapsed);
+
+    if (dispatch == CPU_DISPATCH_BLOCK || dispatch == CPU_DISPATCH_JIT) {
+        const CpuBlockCache *cache   = &gb->blocks;
+        u64                  lookups = cache->hits + cache->misses;
+        printf("%-32s %8.4f %% hits (%llu lookups, %llu invalidations)\n", "",
+               lookups ? 100.0 * (double)cache->hits / (double)lookups : 0.0,
+               (unsigned long long)lookups, (unsigned long long)cache->invalidations);
+    }
+
+    free(gb->cart.rom);
+    gb->cart.rom = NULL;
+}
+
+int main(void) {
+    static GameBoy gb;
+
+    printf("Dispatch benchmark: %d frames per engine\n\n", BENCH_FRAMES);
+    bench_engine(&gb, CPU_DISPATCH_TABLE);
+    bench_engine(&gb, CPU_DISPATCH_THREADED);
+    bench_engine(&gb, CPU_DISPATCH_BLOCK);
+    bench_engine(&gb, CPU_DISPATCH_JIT);
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+// tests/bench_ppu.c
+// Frames-per-second benchmark for the PPU renderers.
+// Build in Release mode for meaningful numbers:
+//   cmake -DCMAKE_BUILD_TYPE=Release .. && make bench_ppu && ./tests/bench_ppu
+#include <gbemu.h>
+#include <core/bus.h>
+#include <core/ppu.h>
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_FRAMES 3000 // Per renderer
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// A busy frame: scrolled BG, the window on the lower half, 10 sprites on
+// every line
+static void bench_scene(GameBoy *gb) {
+    gb_init(gb);
+
+    for (u16 addr = 0x8000; addr < 0x8800; addr++)
+        mmu_write(gb, addr, (u8)(addr * 29));
+    for (u16 addr = 0x9800; addr < 0xA000; addr++)
+        mmu_write(gb, addr, (u8)(addr * 7 % 128));
+    for (int i = 0; i < 40; i++) {
+        mmu_write(gb, 0xFE00 + i * 4, (u8)(16 + (i / 10) * 36));   // Y
+        mmu_write(gb, 0xFE00 + i * 4 + 1, (u8)(8 + (i % 10) * 16)); // X
+        mmu_write(gb, 0xFE00 + i * 4 + 2, (u8)i);
+        mmu_write(gb, 0xFE00 + i * 4 + 3, (u8)((i & 3) << 5));
+    }
+
+    mmu_write(gb, 0xFF40, 0xF7); // BG, window, 8x16 sprites
+    mmu_write(gb, 0xFF42, 5);
+    mmu_write(gb, 0xFF43, 3);
+    mmu_write(gb, 0xFF47, 0xE4);
+    mmu_write(gb, 0xFF48, 0xD2);
+    mmu_write(gb, 0xFF49, 0x1B);
+    mmu_write(gb, 0xFF4A, 72);
+    mmu_write(gb, 0xFF4B, 87);
+}
+
+// Frames per second of `renderer`
+static double bench_renderer(const PpuRenderer *renderer) {
+    static GameBoy gb;
+
+    bench_scene(&gb);
+    gb.ppu.renderer = renderer;
+
+    double start = now_seconds();
+    for (int i = 1; i <= BENCH_FRAMES; i++) {
+        gb.cycles = (u64)i * PPU_FRAME_CYCLES;
+        ppu_sync(&gb, gb.cycles);
+    }
+    double elapsed = now_seconds() - start;
+
+    printf("%-10s %10.0f frames/s  (%6.2f us/frame, %llu frames)\n", renderer->name,
+           BENCH_FRAMES / elapsed, elapsed * 1e6 / BENCH_FRAMES,
+           (unsigned long long)gb.ppu.frames);
+    return BENCH_FRAMES / elapsed;
+}
+
+int main(void) {
+    printf("PPU benchmark: %d frames per renderer\n\n", BENCH_FRAMES);
+
+    double scanline = bench_renderer(&ppu_renderer_scanline);
+    double fifo     = bench_renderer(&ppu_renderer_fifo);
+    bench_renderer(&ppu_renderer_auto);
+
+    printf("\nScanline / FIFO: %.1fx\n", scanline / fifo);
+    return 0;
+}
@@ -0,0 +1,220 @@
+// tests/test_alu.c
+// Exhaustive checks of the 8-bit ALU kernels against a straightforward
+// reference model, for whichever path (tables or arithmetic) was built.
+#include <check.h>
+#include <core/cpu/cpu.h>
+#include <core/cpu/cpu_alu.h>
+#include <stdlib.h>
+
+// ---------------------------------------------
+// Reference model
+// ---------------------------------------------
+static u8 ref_add_flags(int a, int b, int carry) {
+    u8 f = ((u8)(a + b + carry) == 0) ? FLAG_ZERO : 0;
+    if ((a & 0x0F) + (b & 0x0F) + carry > 0x0F)
+        f |= FLAG_HF_CARRY;
+    if (a + b + carry > 0xFF)
+        f |= FLAG_CARRY;
+    return f;
+}
+
+static u8 ref_sub_flags(int a, int b, int carry) {
+    u8 f = FLAG_SUBT | (((u8)(a - b - carry) == 0) ? FLAG_ZERO : 0);
+    if ((a & 0x0F) < (b & 0x0F) + carry)
+        f |= FLAG_HF_CARRY;
+    if (a < b + carry)
+        f |= FLAG_CARRY;
+    return f;
+}
+
+// https://gbdev.io/pandocs/CPU_Instruction_Set.html (DAA)
+static u8 ref_daa(u8 a, u8 f_in, u8 *f_out) {
+    bool n = (f_in & FLAG_SUBT) != 0;
+    bool h = (f_in & FLAG_HF_CARRY) != 0;
+    bool c = (f_in & FLAG_CARRY) != 0;
+
+    if (!n) {
+        if (c || a > 0x99) {
+            a += 0x60;
+            c  = true;
+        }
+        if (h || (a & 0x0F) > 0x09)
+            a += 0x06;
+    } else {
+        if (c)
+            a -= 0x60;
+        if (h)
+            a -= 0x06;
+    }
+
+    *f_out = (a == 0 ? FLAG_ZERO : 0) | (n ? FLAG_SUBT : 0) | (c ? FLAG_CARRY : 0);
+    return a;
+}
+
+// Fresh CPU with the given flags, eager or lazy
+static void reset_cpu(CPU *cpu, bool lazy, u8 f) {
+    cpu->lazy_flags = lazy;
+    cpu_flags_write(cpu, f);
+}
+
+// ============================================================================
+// ADD / ADC / SUB / SBC / CP
+// ============================================================================
+
+START_TEST(test_alu_add_exhaustive) {
+    CPU cpu = {0};
+    cpu_alu_init();
+
+    for (int lazy = 0; lazy < 2; lazy++)
+        for (int carry = 0; carry < 2; carry++)
+            for (int a = 0; a < 256; a++)
+                for (int b = 0; b < 256; b++) {
+                    reset_cpu(&cpu, lazy, 0);
+                    u8 result = alu_add(&cpu, a, b, carry);
+
+                    ck_assert_uint_eq(result, (u8)(a + b + carry));
+                    ck_assert_uint_eq(cpu_flags_value(&cpu), ref_add_flags(a, b, carry));
+                    ck_assert_uint_eq(cpu_flag_c(&cpu), (a + b + carry) > 0xFF);
+                    ck_assert_uint_eq(cpu_flag_z(&cpu), result == 0);
+                }
+}
+END_TEST
+
+START_TEST(test_alu_sub_exhaustive) {
+    CPU cpu = {0};
+    cpu_alu_init();
+
+    for (int lazy = 0; lazy < 2; lazy++)
+        for (int carry = 0; carry < 2; carry++)
+            for (int a = 0; a < 256; a++)
+                for (int b = 0; b < 256; b++) {
+                    reset_cpu(&cpu, lazy, 0);
+                    u8 result = alu_sub(&cpu, a, b, carry);
+
+                    ck_assert_uint_eq(result, (u8)(a - b - carry));
+                    ck_assert_uint_eq(cpu_flags_value(&cpu), ref_sub_flags(a, b, carry));
+                    ck_assert_uint_eq(cpu_flag_c(&cpu), a < b + carry);
+                    ck_assert_uint_eq(cpu_flag_z(&cpu), result == 0);
+                }
+}
+END_TEST
+
+// ============================================================================
+// AND / OR / XOR
+// ============================================================================
+
+START_TEST(test_alu_logic_exhaustive) {
+    CPU cpu = {0};
+    cpu_alu_init();
+
+    for (int lazy = 0; lazy < 2; lazy++)
+        for (int a = 0; a < 256; a++)
+            for (int b = 0; b < 256; b++) {
+                reset_cpu(&cpu, lazy, FLAG_CARRY);
+                ck_assert_uint_eq(alu_and(&cpu, a, b), a & b);
+                ck_assert_uint_eq(cpu_flags_value(&cpu),
+                                  ((a & b) == 0 ? FLAG_ZERO : 0) | FLAG_HF_CARRY);
+
+                reset_cpu(&cpu, lazy, FLAG_CARRY);
+                ck_assert_uint_eq(alu_or(&cpu, a, b), a | b);
+                ck_assert_uint_eq(cpu_flags_value(&cpu), (a | b) == 0 ? FLAG_ZERO : 0);
+
+                reset_cpu(&cpu, lazy, FLAG_CARRY);
+                ck_assert_uint_eq(alu_xor(&cpu, a, b), a ^ b);
+                ck_assert_uint_eq(cpu_flags_value(&cpu), (a ^ b) == 0 ? FLAG_ZERO : 0);
+            }
+}
+END_TEST
+
+// ============================================================================
+// INC / DEC
+// ============================================================================
+
+START_TEST(test_alu_inc_dec_exhaustive) {
+    CPU cpu = {0};
+    cpu_alu_init();
+
+    for (int lazy = 0; lazy < 2; lazy++)
+        for (int carry = 0; carry < 2; carry++)
+            for (int value = 0; value < 256; value++) {
+                u8 c_in = carry ? FLAG_CARRY : 0;
+
+                reset_cpu(&cpu, lazy, c_in);
+                ck_assert_uint_eq(alu_inc(&cpu, value), (u8)(value + 1));
+                ck_assert_uint_eq(cpu_flags_value(&cpu),
+                                  ((u8)(value + 1) == 0 ? FLAG_ZERO : 0) |
+                                      ((value & 0x0F) == 0x0F ? FLAG_HF_CARRY : 0) | c_in);
+
+                reset_cpu(&cpu, lazy, c_in);
+                ck_assert_uint_eq(alu_dec(&cpu, value), (u8)(value - 1));
+                ck_assert_uint_eq(cpu_flags_value(&cpu),
+                                  FLAG_SUBT | ((u8)(value - 1) == 0 ? FLAG_ZERO : 0) |
+                                      ((value & 0x0F) == 0 ? FLAG_HF_CARRY : 0) | c_in);
+            }
+}
+END_TEST
+
+// ============================================================================
+// DAA
+// ============================================================================
+
+START_TEST(test_alu_daa_exhaustive) {
+    CPU cpu = {0};
+    cpu_alu_init();
+
+    for (int lazy = 0; lazy < 2; lazy++)
+        for (int flags = 0; flags < 16; flags++)
+            for (int a = 0; a < 256; a++) {
+                u8 f_in = flags << 4; // Z is ignored by DAA
+                u8 f_ref;
+                u8 ref  = ref_daa(a, f_in, &f_ref);
+
+                reset_cpu(&cpu, lazy, f_in);
+                ck_assert_uint_eq(alu_daa(&cpu, a), ref);
+                ck_assert_uint_eq(cpu_flags_value(&cpu), f_ref);
+            }
+}
+END_TEST
+
+// ============================================================================
+// Test Suite Setup
+// ============================================================================
+Suite *alu_suite(void) {
+    Suite *s;
+    TCase *tc_arith;
+    TCase *tc_logic;
+    TCase *tc_bcd;
+
+    s        = suite_create("ALU");
+
+    tc_arith = tcase_create("Arithmetic");
+    tcase_add_test(tc_arith, test_alu_add_exhaustive);
+    tcase_add_test(tc_arith, test_alu_sub_exhaustive);
+    tcase_add_test(tc_arith, test_alu_inc_dec_exhaustive);
+    suite_add_tcase(s, tc_arith);
+
+    tc_logic = tcase_create("Logic");
+    tcase_add_test(tc_logic, test_alu_logic_exhaustive);
+    suite_add_tcase(s, tc_logic);
+
+    tc_bcd = tcase_create("DAA");
+    tcase_add_test(tc_bcd, test_alu_daa_exhaustive);
+    suite_add_tcase(s, tc_bcd);
+
+    return s;
+}
+
+int main(void) {
+    int      number_failed;
+    Suite   *s;
+    SRunner *sr;
+
+    s  = alu_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_NORMAL);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (number_failed == 0) ? 0 : 1;
+}
@@ -2,7 +2,11 @@
 #include <check.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <core/cartridge.h>
+#include <core/bus.h>
+#include <gbemu.h>
 
 // ============================================================================
 // Helper Functions Tests
@@ -293,6 +297,199 @@ START_TEST(test_header_checksum_invalid) {
 }
 END_TEST
 
+// ============================================================================
+// ROM Registry Tests
+// ============================================================================
+
+// Write a ROM of `size` bytes (valid header, byte i = i / 0x4000 past it) to a temp file
+static void write_rom(char *path, size_t size, u8 type, u8 ram_size_code) {
+    u8 *rom = calloc(1, size);
+    for (size_t i = 0x150; i < size; i++)
+        rom[i] = (u8)(i / 0x4000);
+    rom[0x0147] = type;
+    rom[0x0149] = ram_size_code;
+
+    u8 checksum = 0;
+    for (u16 addr = 0x0134; addr <= 0x014C; addr++)
+        checksum = checksum - rom[addr] - 1;
+    rom[0x014D] = checksum;
+
+    int   fd    = mkstemp(path);
+    FILE *file  = fdopen(fd, "wb");
+    ck_assert_ptr_nonnull(file);
+    ck_assert_uint_eq(fwrite(rom, 1, size, file), size);
+    fclose(file);
+    free(rom);
+}
+
+// Cartridges of the same file share one mapping, the last unload unmaps it
+START_TEST(test_load_shared_mapping) {
+    char      path[] = "/tmp/baredmg_romXXXXXX";
+    Cartridge a      = {0};
+    Cartridge b      = {0};
+    size_t    before = cart_rom_mappings();
+
+    write_rom(path, 0x10000, 0x00, 0x00);
+    ck_assert_int_eq(cart_load(&a, path), 0);
+    ck_assert_int_eq(cart_load(&b, path), 0);
+    ck_assert_ptr_eq(a.rom, b.rom);
+    ck_assert_uint_eq(a.rom_size, 0x10000);
+    ck_assert_uint_eq(a.rom[0xC000], 3);
+    ck_assert_uint_eq(cart_rom_mappings(), before + 1);
+
+    cart_unload(&a);
+    ck_assert_ptr_null(a.rom);
+    ck_assert_uint_eq(b.rom[0xC000], 3);
+    ck_assert_uint_eq(cart_rom_mappings(), before + 1);
+
+    cart_unload(&b);
+    ck_assert_uint_eq(cart_rom_mappings(), before);
+    unlink(path);
+}
+END_TEST
+
+// A ROM that isn't a power-of-two number of banks reads 0xFF past its end
+START_TEST(test_load_pads_banks) {
+    char      path[] = "/tmp/baredmg_romXXXXXX";
+    Cartridge cart   = {0};
+
+    write_rom(path, 3 * 0x4000 + 0x123, 0x00, 0x00);
+    ck_assert_int_eq(cart_load(&cart, path), 0);
+    ck_assert_uint_eq(cart.rom_size, 0x10000);
+    ck_assert_uint_eq(cart.rom[0xC122], 3);
+    ck_assert_uint_eq(cart.rom[0xC123], 0xFF);
+    ck_assert_uint_eq(cart.rom[0xFFFF], 0xFF);
+
+    cart_unload(&cart);
+    unlink(path);
+}
+END_TEST
+
+// Missing / truncated files keep their error codes
+START_TEST(test_load_errors) {
+    char      path[] = "/tmp/baredmg_romXXXXXX";
+    Cartridge cart   = {0};
+
+    ck_assert_int_eq(cart_load(&cart, "/nonexistent/rom.gb"), 1);
+
+    int fd = mkstemp(path);
+    ck_assert_int_eq(write(fd, "GB", 2), 2);
+    close(fd);
+    ck_assert_int_eq(cart_load(&cart, path), 2);
+    ck_assert_ptr_null(cart.rom);
+    unlink(path);
+}
+END_TEST
+
+// ============================================================================
+// Battery Save Tests
+// ============================================================================
+
+// .sav path cart_load() uses for `path` (no extension: .sav appended)
+static void sav_path(char *out, size_t size, const char *path) {
+    snprintf(out, size, "%s.sav", path);
+}
+
+// Battery RAM is the .sav file: it survives an unload, carts without a battery get none
+START_TEST(test_battery_save_file) {
+    char        path[] = "/tmp/baredmg_romXXXXXX";
+    char        sav[64];
+    Cartridge   cart   = {0};
+    struct stat st;
+
+    write_rom(path, 0x8000, 0x03, 0x02); // MBC1+RAM+BATTERY, 8 KiB
+    sav_path(sav, sizeof(sav), path);
+    ck_assert_int_eq(cart_load(&cart, path), 0);
+    ck_assert_ptr_nonnull(cart.save);
+    ck_assert_int_eq(stat(sav, &st), 0);
+    ck_assert_int_eq(st.st_size, 0x2000);
+    ck_assert_uint_eq(cart.ram[5], 0x00);
+
+    cart.ram[5]    = 0x42;
+    cart.save_dirty = true;
+    ck_assert(cart_flush_save(&cart, 0));
+    ck_assert(!cart_flush_save(&cart, 0));
+    ck_assert_uint_eq(cart.save_syncs, 1);
+    cart_unload(&cart);
+
+    ck_assert_int_eq(cart_load(&cart, path), 0);
+    ck_assert_uint_eq(cart.ram[5], 0x42);
+    cart_unload(&cart);
+    unlink(sav);
+    unlink(path);
+
+    strcpy(path, "/tmp/baredmg_romXXXXXX");
+    write_rom(path, 0x8000, 0x02, 0x02); // MBC1+RAM
+    sav_path(sav, sizeof(sav), path);
+    ck_assert_int_eq(cart_load(&cart, path), 0);
+    ck_assert_ptr_null(cart.save);
+    ck_assert_ptr_nonnull(cart.ram);
+    ck_assert_int_ne(stat(sav, &st), 0);
+    cart_unload(&cart);
+    unlink(path);
+}
+END_TEST
+
+// MBC3+TIMER+BATTERY has no RAM, its .sav only holds the clock footer
+START_TEST(test_rtc_save_footer) {
+    char      path[] = "/tmp/baredmg_romXXXXXX";
+    char      sav[64];
+    Cartridge cart   = {0};
+
+    write_rom(path, 0x8000, 0x0F, 0x00);
+    sav_path(sav, sizeof(sav), path);
+    ck_assert_int_eq(cart_load(&cart, path), 0);
+    ck_assert_ptr_null(cart.ram);
+    ck_assert_ptr_nonnull(cart.save);
+    ck_assert_uint_eq(cart.save_size, MBC_RTC_SAVE_SIZE);
+
+    cart.mbc.rtc.hour = 3;
+    ck_assert(cart_flush_save(&cart, 0));
+    cart_unload(&cart);
+
+    ck_assert_int_eq(cart_load(&cart, path), 0);
+    ck_assert_uint_eq(cart.mbc.rtc.hour, 3);
+    cart_unload(&cart);
+    unlink(sav);
+    unlink(path);
+}
+END_TEST
+
+// The first RAM write after a flush marks the save dirty and schedules
+// EVENT_SAVE, which flushes and takes the pages off the write map again
+START_TEST(test_save_dirty_tracking) {
+    char           path[] = "/tmp/baredmg_romXXXXXX";
+    char           sav[64];
+    static GameBoy gb;
+
+    write_rom(path, 0x8000, 0x03, 0x02);
+    sav_path(sav, sizeof(sav), path);
+    gb_init(&gb);
+    gb_load_rom(&gb, path);
+    ck_assert(gb.running);
+
+    mmu_write(&gb, 0x0000, 0x0A);
+    ck_assert(!gb.cart.save_dirty);
+    mmu_write(&gb, 0xA010, 0x77);
+    ck_assert(gb.cart.save_dirty);
+    ck_assert_ptr_nonnull(gb.write_map[0xA0]);
+    ck_assert_uint_ne(gb.events.index[EVENT_SAVE], EVENT_NOT_QUEUED);
+
+    gb_run(&gb, 2 * 70224);
+    ck_assert(!gb.cart.save_dirty);
+    ck_assert_uint_eq(gb.cart.save_syncs, 1);
+    ck_assert_ptr_null(gb.write_map[0xA0]);
+    ck_assert_uint_eq(gb.cart.ram[0x10], 0x77);
+
+    mmu_write(&gb, 0xA011, 0x78);
+    ck_assert(gb.cart.save_dirty);
+
+    cart_unload(&gb.cart);
+    unlink(sav);
+    unlink(path);
+}
+END_TEST
+
 // ============================================================================
 // Test Suite Setup
 // ============================================================================
@@ -300,7 +497,7 @@ END_TEST
 Suite *cartridge_suite(void) {
     Suite *s;
     TCase *tc_ram_size, *tc_rom_size, *tc_cart_type, *tc_publisher;
-    TCase *tc_parse, *tc_checksum;
+    TCase *tc_parse, *tc_checksum, *tc_registry, *tc_save;
 
     s           = suite_create("Cartridge");
 
@@ -358,6 +555,20 @@ Suite *cartridge_suite(void) {
     tcase_add_test(tc_checksum, test_header_checksum_invalid);
     suite_add_tcase(s, tc_checksum);
 
+    // ROM registry tests
+    tc_registry = tcase_create("ROM Registry");
+    tcase_add_test(tc_registry, test_load_shared_mapping);
+    tcase_add_test(tc_registry, test_load_pads_banks);
+    tcase_add_test(tc_registry, test_load_errors);
+    suite_add_tcase(s, tc_registry);
+
+    // Battery save tests
+    tc_save = tcase_create("Battery Saves");
+    tcase_add_test(tc_save, test_battery_save_file);
+    tcase_add_test(tc_save, test_rtc_save_footer);
+    tcase_add_test(tc_save, test_save_dirty_tracking);
+    suite_add_tcase(s, tc_save);
+
     return s;
 }
 
@@ -0,0 +1,737 @@
+// tests/test_cpu.c
+#include <check.h>
+#include <gbemu.h>
+#include <core/bus.h>
+#include <core/cpu/cpu.h>
+#include <core/cpu/cpu_aot.h>
+#include <core/cpu/cpu_jit.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// ---------------------------------------------
+// Helpers
+// ---------------------------------------------
+
+// Initialize a GameBoy with `program` at 0x0100 (entry point) in a blank 32 KB ROM
+static void setup_program(GameBoy *gb, const u8 *program, size_t size, bool lazy) {
+    gb_init(gb);
+    gb->cart.rom      = calloc(1, 0x8000);
+    gb->cart.rom_size = 0x8000;
+    memcpy(gb->cart.rom + 0x0100, program, size);
+    gb->running = true;
+    cpu_set_lazy_flags(&gb->cpu, lazy);
+}
+
+static void teardown_program(GameBoy *gb) {
+    free(gb->cart.rom);
+    gb->cart.rom = NULL;
+}
+
+// Execute `count` instructions one at a time
+static void run_instructions(GameBoy *gb, int count) {
+    for (int i = 0; i < count; i++)
+        cpu_run(&gb->cpu, 1);
+}
+
+// Opcodes the random programs must not contain
+// (HALT/STOP stop the run, 0xCB & illegal opcodes are not implemented,
+// 0x02 keeps random LDH/LD stores away from the serial port at 0xFF02)
+static const bool excluded_opcodes[256] = {
+    [0x02] = true, [0x10] = true, [0x76] = true, [0xCB] = true, [0xD3] = true,
+    [0xDB] = true, [0xDD] = true, [0xE3] = true, [0xE4] = true, [0xEB] = true,
+    [0xEC] = true, [0xED] = true, [0xF4] = true, [0xFC] = true, [0xFD] = true,
+};
+
+// Compare everything a program can observe
+static void assert_same_state(GameBoy *eager, GameBoy *lazy) {
+    ck_assert_uint_eq(cpu_read_af(&eager->cpu), cpu_read_af(&lazy->cpu));
+    ck_assert_uint_eq(cpu_read_bc(&eager->cpu), cpu_read_bc(&lazy->cpu));
+    ck_assert_uint_eq(cpu_read_de(&eager->cpu), cpu_read_de(&lazy->cpu));
+    ck_assert_uint_eq(cpu_read_hl(&eager->cpu), cpu_read_hl(&lazy->cpu));
+    ck_assert_uint_eq(eager->cpu.sp, lazy->cpu.sp);
+    ck_assert_uint_eq(eager->cpu.pc, lazy->cpu.pc);
+    ck_assert_uint_eq(eager->cycles, lazy->cycles);
+}
+
+// ============================================================================
+// Lazy Flags Tests
+// ============================================================================
+
+// Conditional jump reads C straight from the pending SUB
+START_TEST(test_lazy_flags_jr_c) {
+    static const u8 program[] = {
+        0x3E, 0x10, // LD A, 0x10
+        0xD6, 0x20, // SUB 0x20     -> C = 1
+        0x38, 0x02, // JR C, +2
+        0x06, 0x11, // LD B, 0x11   (skipped)
+        0x0E, 0x22, // LD C, 0x22
+    };
+    GameBoy gb = {0};
+    setup_program(&gb, program, sizeof(program), true);
+
+    run_instructions(&gb, 4);
+    ck_assert_uint_eq(gb.cpu.regs.a, 0xF0);
+    ck_assert_uint_eq(gb.cpu.regs.b, 0x00);
+    ck_assert_uint_eq(gb.cpu.regs.c, 0x22);
+    ck_assert(cpu_get_flag(&gb.cpu, FLAG_CARRY));
+    ck_assert(cpu_get_flag(&gb.cpu, FLAG_SUBT));
+
+    teardown_program(&gb);
+}
+END_TEST
+
+// INC keeps the carry of the ADD before it, PUSH AF sees the full F
+START_TEST(test_lazy_flags_push_af) {
+    static const u8 program[] = {
+        0x3E, 0xFF, // LD A, 0xFF
+        0xC6, 0x01, // ADD 0x01     -> Z = 1, H = 1, C = 1
+        0x3C,       // INC A        -> Z = 0, H = 0, C preserved
+        0xF5,       // PUSH AF
+        0xC1,       // POP BC
+    };
+    GameBoy gb = {0};
+    setup_program(&gb, program, sizeof(program), true);
+
+    run_instructions(&gb, 5);
+    ck_assert_uint_eq(gb.cpu.regs.b, 0x01);
+    ck_assert_uint_eq(gb.cpu.regs.c, FLAG_CARRY);
+
+    teardown_program(&gb);
+}
+END_TEST
+
+// DAA reads N/H/C left behind by ADD
+START_TEST(test_lazy_flags_daa) {
+    static const u8 program[] = {
+        0x3E, 0x15, // LD A, 0x15
+        0xC6, 0x27, // ADD 0x27
+        0x27,       // DAA          -> A = 0x42 (BCD)
+    };
+    GameBoy gb = {0};
+    setup_program(&gb, program, sizeof(program), true);
+
+    run_instructions(&gb, 3);
+    ck_assert_uint_eq(gb.cpu.regs.a, 0x42);
+    ck_assert_uint_eq(GET_LOW_BYTE(cpu_read_af(&gb.cpu)), 0x00);
+
+    teardown_program(&gb);
+}
+END_TEST
+
+// Switching modes mid-run keeps the flags
+START_TEST(test_lazy_flags_toggle) {
+    static const u8 program[] = {
+        0x3E, 0x01, // LD A, 0x01
+        0xD6, 0x01, // SUB 0x01     -> Z = 1, N = 1
+    };
+    GameBoy gb = {0};
+    setup_program(&gb, program, sizeof(program), true);
+
+    run_instructions(&gb, 2);
+    cpu_set_lazy_flags(&gb.cpu, false);
+    ck_assert_uint_eq(gb.cpu.regs.f, FLAG_ZERO | FLAG_SUBT);
+
+    teardown_program(&gb);
+}
+END_TEST
+
+// Random programs, run side by side in eager and lazy mode
+START_TEST(test_lazy_flags_match_eager) {
+    static GameBoy eager, lazy;
+
+    srand(0x5EED);
+    for (int seed = 0; seed < 64; seed++) {
+        u8 *rom = malloc(0x8000);
+        for (int i = 0; i < 0x8000; i++) {
+            u8 byte;
+            do {
+                byte = (u8)rand();
+            } while (excluded_opcodes[byte]);
+            rom[i] = byte;
+        }
+
+        setup_program(&eager, rom + 0x0100, 0x8000 - 0x0100, false);
+        setup_program(&lazy, rom + 0x0100, 0x8000 - 0x0100, true);
+
+        for (int step = 0; step < 20000; step++) {
+            // Code copied to RAM may still contain excluded opcodes
+            if (excluded_opcodes[mmu_read(&eager, eager.cpu.pc)])
+                break;
+
+            cpu_run(&eager.cpu, 1);
+            cpu_run(&lazy.cpu, 1);
+            assert_same_state(&eager, &lazy);
+        }
+
+        ck_assert_mem_eq(eager.wram, lazy.wram, sizeof(eager.wram));
+        ck_assert_mem_eq(eager.hram, lazy.hram, sizeof(eager.hram));
+        ck_assert_mem_eq(eager.vram, lazy.vram, sizeof(eager.vram));
+
+        teardown_program(&eager);
+        teardown_program(&lazy);
+        free(rom);
+    }
+}
+END_TEST
+
+// ============================================================================
+// Stack Tests
+// ============================================================================
+
+// CALL pushes the return address, RET pops it back from SP
+START_TEST(test_call_ret) {
+    static const u8 program[] = {
+        0x31, 0xFE, 0xFF, // LD SP, 0xFFFE
+        0xCD, 0x08, 0x01, // CALL 0x0108
+        0x06, 0x11,       // LD B, 0x11
+        0xC9,             // 0x0108: RET
+    };
+    GameBoy gb = {0};
+    setup_program(&gb, program, sizeof(program), true);
+
+    run_instructions(&gb, 2);
+    ck_assert_uint_eq(gb.cpu.pc, 0x0108);
+    ck_assert_uint_eq(gb.cpu.sp, 0xFFFC);
+    ck_assert_uint_eq(mmu_read16(&gb, 0xFFFC), 0x0106);
+
+    run_instructions(&gb, 2);
+    ck_assert_uint_eq(gb.cpu.sp, 0xFFFE);
+    ck_assert_uint_eq(gb.cpu.regs.b, 0x11);
+
+    teardown_program(&gb);
+}
+END_TEST
+
+// ============================================================================
+// Interrupt Tests
+// ============================================================================
+
+// Interrupt handler at `vector`: INC C; RETI
+static void put_counting_handler(GameBoy *gb, u16 vector) {
+    gb->cart.rom[vector]     = 0x0C;
+    gb->cart.rom[vector + 1] = 0xD9;
+}
+
+// The instruction after EI runs first, then the handler, with exact cycles
+START_TEST(test_interrupt_dispatch) {
+    static const u8 program[] = {
+        0xFB, // EI               (4 cycles)
+        0x04, // INC B            (4)   -> dispatch (20), INC C (4), RETI (16)
+        0x04, // INC B            (4)
+        0x76, // HALT             (4)
+    };
+    static GameBoy gb;
+
+    for (CpuDispatch engine = CPU_DISPATCH_TABLE; engine <= CPU_DISPATCH_JIT; engine++) {
+        setup_program(&gb, program, sizeof(program), true);
+        put_counting_handler(&gb, 0x0050);
+        gb.cpu.dispatch = engine;
+        mmu_write(&gb, 0xFFFF, 0x04);
+        gb_request_interrupt(&gb, INT_TIMER);
+
+        while (!gb.cpu.halted)
+            cpu_run(&gb.cpu, 1000);
+
+        ck_assert_uint_eq(gb.cpu.regs.b, 0x02);
+        ck_assert_uint_eq(gb.cpu.regs.c, 0x14); // Handler ran once
+        ck_assert_uint_eq(gb.cpu.sp, 0xFFFE);
+        ck_assert_uint_eq(gb.io.if_reg & 0x1F, 0x01); // VBlank (from power-up) is masked
+        ck_assert(gb.cpu.ime);
+        ck_assert_uint_eq(gb.cycles, 4 + 4 + 20 + 4 + 16 + 4 + 4);
+        teardown_program(&gb);
+    }
+}
+END_TEST
+
+// Pending interrupts are serviced in priority order, masked ones are not
+START_TEST(test_interrupt_priority) {
+    static const u8 program[] = {
+        0x21, 0x00, 0xC0, // LD HL, 0xC000
+        0xFB,             // EI
+        0x00,             // NOP
+        0x76,             // HALT
+    };
+    static GameBoy gb;
+
+    for (CpuDispatch engine = CPU_DISPATCH_TABLE; engine <= CPU_DISPATCH_JIT; engine++) {
+        setup_program(&gb, program, sizeof(program), true);
+        gb.cpu.dispatch = engine;
+
+        // Each handler logs its vector: LD A, vector; LD (HL+), A; RETI
+        for (u16 vector = 0x40; vector <= 0x60; vector += 8) {
+            static const u8 handler[] = {0x3E, 0x00, 0x22, 0xD9};
+            memcpy(gb.cart.rom + vector, handler, sizeof(handler));
+            gb.cart.rom[vector + 1] = (u8)vector;
+        }
+
+        mmu_write(&gb, 0xFFFF, 0x05); // VBlank & Timer
+        mmu_write(&gb, 0xFF0F, 0x00);
+        gb_request_interrupt(&gb, INT_JOYPAD);
+        gb_request_interrupt(&gb, INT_TIMER);
+        gb_request_interrupt(&gb, INT_VBLANK);
+
+        gb_run(&gb, 1000);
+        ck_assert(gb.cpu.halted);
+        ck_assert_uint_eq(gb.wram[0], 0x40);
+        ck_assert_uint_eq(gb.wram[1], 0x50);
+        ck_assert_uint_eq(gb.wram[2], 0x00);
+        ck_assert_uint_eq(gb.io.if_reg & 0x1F, 0x10); // Joypad still requested
+        teardown_program(&gb);
+    }
+}
+END_TEST
+
+// A serial interrupt wakes a HALT with IME set and runs its handler
+START_TEST(test_interrupt_wakes_halt) {
+    static const u8 program[] = {
+        0x3E, 0x81, // LD A, 0x81
+        0xE0, 0x02, // LDH (0x02), A (transfer done 4096 cycles later)
+        0xFB,       // EI
+        0x76,       // HALT
+        0x04,       // INC B
+        0x76,       // HALT
+    };
+    static GameBoy gb;
+
+    setup_program(&gb, program, sizeof(program), true);
+    put_counting_handler(&gb, 0x0058);
+    gb.cpu.dispatch = CPU_DISPATCH_BLOCK;
+    mmu_write(&gb, 0xFFFF, 0x08);
+
+    gb_run(&gb, 4000);
+    ck_assert(gb.cpu.halted);
+    ck_assert_uint_eq(gb.cpu.regs.c, 0x13);
+
+    gb_run(&gb, 1000);
+    ck_assert(gb.cpu.halted);
+    ck_assert_uint_eq(gb.cpu.regs.c, 0x14);
+    ck_assert_uint_eq(gb.cpu.regs.b, 0x01);
+    ck_assert_uint_eq(gb.cpu.pc, 0x0108);
+
+    teardown_program(&gb);
+}
+END_TEST
+
+// ============================================================================
+// Block Cache Tests
+// ============================================================================
+
+// A store into the running block takes effect on the next instruction
+START_TEST(test_block_self_modifying) {
+    static const u8 code[] = {
+        0x3E, 0x05,       // 0xC000: LD A, 0x05
+        0x21, 0x07, 0xC0, // 0xC002: LD HL, 0xC007
+        0x36, 0x3C,       // 0xC005: LD (HL), 0x3C  -> INC A
+        0x00,             // 0xC007: NOP
+        0x76,             // 0xC008: HALT
+    };
+    GameBoy gb = {0};
+    setup_program(&gb, NULL, 0, true);
+    gb.cpu.dispatch = CPU_DISPATCH_BLOCK;
+
+    for (size_t i = 0; i < sizeof(code); i++)
+        mmu_write(&gb, 0xC000 + i, code[i]);
+
+    gb.cpu.pc = 0xC000;
+    cpu_run(&gb.cpu, 1000);
+    ck_assert(gb.cpu.halted);
+    ck_assert_uint_eq(gb.cpu.regs.a, 0x06);
+    ck_assert_uint_eq(gb.blocks.invalidations, 1);
+
+    // Running it again decodes the modified block
+    gb.cpu.pc     = 0xC000;
+    gb.cpu.halted = false;
+    cpu_run(&gb.cpu, 1000);
+    ck_assert_uint_eq(gb.cpu.regs.a, 0x06);
+    ck_assert_uint_eq(gb.blocks.invalidations, 2);
+
+    teardown_program(&gb);
+}
+END_TEST
+
+// Random programs, run side by side with the table and block engines
+START_TEST(test_block_match_table) {
+    static GameBoy table, block;
+    u64            hits = 0;
+
+    srand(0xB10C);
+    for (int seed = 0; seed < 32; seed++) {
+        u8 *rom = malloc(0x8000);
+        for (int i = 0; i < 0x8000; i++) {
+            u8 byte;
+            do {
+                byte = (u8)rand();
+            } while (excluded_opcodes[byte]);
+            rom[i] = byte;
+        }
+
+        setup_program(&table, rom + 0x0100, 0x8000 - 0x0100, true);
+        setup_program(&block, rom + 0x0100, 0x8000 - 0x0100, true);
+        table.cpu.dispatch = CPU_DISPATCH_TABLE;
+        block.cpu.dispatch = CPU_DISPATCH_BLOCK;
+
+        for (int chunk = 0; chunk < 200; chunk++) {
+            // Code copied to RAM may still contain excluded opcodes
+            if (excluded_opcodes[mmu_read(&table, table.cpu.pc)])
+                break;
+
+            cpu_run(&table.cpu, 64);
+            cpu_run(&block.cpu, 64);
+            assert_same_state(&table, &block);
+        }
+
+        ck_assert_mem_eq(table.wram, block.wram, sizeof(table.wram));
+        ck_assert_mem_eq(table.hram, block.hram, sizeof(table.hram));
+        ck_assert_mem_eq(table.vram, block.vram, sizeof(table.vram));
+        hits += block.blocks.hits;
+
+        teardown_program(&table);
+        teardown_program(&block);
+        free(rom);
+    }
+
+    // Loops in the random code re-entered cached blocks
+    ck_assert_uint_gt(hits, 0);
+}
+END_TEST
+
+// Busy-wait on LY / DIV: skipped iterations leave exactly the state stepping would
+START_TEST(test_block_idle_loop) {
+    static const u8 ly_loop[] = {
+        0x21, 0x00, 0xC0, // LD HL, 0xC000
+        0xF0, 0x44,       // loop: LDH A, (0x44)
+        0xFE, 0x90,       // CP 0x90
+        0x20, 0xFA,       // JR NZ, loop
+    };
+    static const u8     div_loop[] = {0xF0, 0x04, 0xFE, 0x90, 0x20, 0xFA}; // LDH A, (DIV); CP; JR
+    static const u8    *programs[] = {ly_loop, div_loop};
+    static const size_t sizes[]    = {sizeof(ly_loop), sizeof(div_loop)};
+    static GameBoy      table, idle;
+
+    for (int i = 0; i < 2; i++) {
+        for (CpuDispatch engine = CPU_DISPATCH_BLOCK; engine <= CPU_DISPATCH_JIT; engine++) {
+            setup_program(&table, programs[i], sizes[i], true);
+            setup_program(&idle, programs[i], sizes[i], true);
+            table.cpu.dispatch = CPU_DISPATCH_TABLE;
+            idle.cpu.dispatch  = engine;
+
+            // Budgets that end mid-iteration, too. Translated blocks only stop at
+            // their exits: catch up the table engine there
+            for (u32 budget = 1000; budget < 1100; budget += 7) {
+                cpu_run(&idle.cpu, budget);
+                while (table.cycles < idle.cycles)
+                    cpu_run(&table.cpu, 1);
+                assert_same_state(&table, &idle);
+            }
+
+            // LY / DIV move on their own: only the iterations up to the next change
+            ck_assert_uint_gt(idle.blocks.idle_skips, 0);
+            ck_assert_uint_gt(idle.blocks.idle_cycles, idle.cycles / 2);
+            teardown_program(&table);
+            teardown_program(&idle);
+        }
+    }
+}
+END_TEST
+
+// Loops polling a sound register, or changing A, keep running
+START_TEST(test_block_idle_not_skipped) {
+    static const u8     nr52_loop[] = {0xF0, 0x26, 0xFE, 0x90, 0x20, 0xFA}; // LDH A, (NR52); CP; JR
+    static const u8     inc_loop[]  = {0x3C, 0x20, 0xFD};                   // INC A; JR NZ
+    static const u8    *programs[]  = {nr52_loop, inc_loop};
+    static const size_t sizes[]     = {sizeof(nr52_loop), sizeof(inc_loop)};
+    GameBoy             gb          = {0};
+
+    for (int i = 0; i < 2; i++) {
+        setup_program(&gb, programs[i], sizes[i], true);
+        gb.cpu.dispatch = CPU_DISPATCH_BLOCK;
+
+        cpu_run(&gb.cpu, 10000);
+        ck_assert_uint_eq(gb.blocks.idle_skips, 0);
+        teardown_program(&gb);
+    }
+}
+END_TEST
+
+// ============================================================================
+// JIT Tests
+// ============================================================================
+
+// Append a random instruction the JIT translates (or calls out for) to `code`
+// (HL) accesses get their own LD HL so they stay inside WRAM
+static size_t jit_random_instr(u8 *code) {
+    static const u8 callouts[] = {0x07, 0x0F, 0x17, 0x1F, 0x27, 0x2F, 0x37, 0x3F, 0x09, 0x19,
+                                  0x29, 0x39, 0x20, 0x28, 0x30, 0x38, 0xC2, 0xCA, 0xD2, 0xDA};
+    size_t          len         = 0;
+    u8              opcode;
+
+    switch (rand() % 6) {
+        case 0: // LD r, r' / LD r, (HL) / LD (HL), r
+            do {
+                opcode = 0x40 + rand() % 0x40;
+            } while (opcode == 0x76);
+            break;
+        case 1: // ALU A, r / ALU A, (HL)
+            opcode = 0x80 + rand() % 0x40;
+            break;
+        case 2: // LD r, n / INC r / DEC r
+            opcode = ((rand() % 8) << 3) | (0x04 + rand() % 3);
+            break;
+        case 3: // LD rr, nn / INC rr / DEC rr (not SP)
+            opcode = ((rand() % 3) << 4) | (const u8[]){0x01, 0x03, 0x0B}[rand() % 3];
+            break;
+        case 4: // ALU A, n
+            opcode = 0xC6 | ((rand() % 8) << 3);
+            break;
+        default: // Rotates, flag ops, ADD HL, conditional JR/JP to the next instruction
+            opcode = callouts[rand() % sizeof(callouts)];
+            break;
+    }
+
+    bool uses_hl = (opcode >= 0x40 && opcode < 0xC0 && ((opcode & 0x07) == 0x06 ||
+                                                         (opcode & 0xF8) == 0x70)) ||
+                   opcode == 0x34 || opcode == 0x35 || opcode == 0x36;
+    if (uses_hl) {
+        code[len++] = 0x21; // LD HL, 0xC000-0xCFFF
+        code[len++] = (u8)rand();
+        code[len++] = 0xC0 | (rand() % 0x10);
+    }
+
+    code[len++] = opcode;
+    switch (cpu_instr_length(opcode)) {
+        case 2:
+            code[len++] = ((opcode & 0xE7) == 0x20) ? 0x00 : (u8)rand(); // JR cc, +0
+            break;
+        case 3:
+            code[len++] = (u8)rand();
+            code[len++] = (u8)rand();
+            break;
+    }
+    return len;
+}
+
+// Hot loops of random code, run side by side with the JIT and table engines
+START_TEST(test_jit_match_table) {
+    static GameBoy table, jit;
+    int            translated = 0;
+
+    if (!cpu_jit_available())
+        return;
+
+    srand(0x717);
+    for (int seed = 0; seed < 16; seed++) {
+        u8    *program = calloc(1, 0x4000);
+        size_t pc      = 0;
+
+        for (int loop = 0; loop < 8; loop++) {
+            program[pc++] = 0x3E; // LD A, 64
+            program[pc++] = 64;
+            program[pc++] = 0xE0; // LDH (0x80), A
+            program[pc++] = 0x80;
+
+            size_t start = pc;
+            for (int i = 0; i < 16; i++) {
+                size_t at = pc;
+                pc += jit_random_instr(program + pc);
+                if ((program[at] & 0xE7) == 0xC2) { // JP cc, next instruction
+                    program[at + 1] = (0x0100 + pc) & 0xFF;
+                    program[at + 2] = (0x0100 + pc) >> 8;
+                }
+            }
+
+            program[pc++] = 0xF0; // LDH A, (0x80)
+            program[pc++] = 0x80;
+            program[pc++] = 0x3D; // DEC A
+            program[pc++] = 0xE0; // LDH (0x80), A
+            program[pc++] = 0x80;
+            program[pc++] = 0x20; // JR NZ, start
+            program[pc]   = (u8)(start - (pc + 1));
+            pc++;
+            u16 next      = 0x0100 + pc + 3;
+            program[pc++] = 0xC3; // JP next
+            program[pc++] = next & 0xFF;
+            program[pc++] = next >> 8;
+        }
+        program[pc++] = 0x76; // HALT
+
+        setup_program(&table, program, pc, true);
+        setup_program(&jit, program, pc, true);
+        table.cpu.dispatch = CPU_DISPATCH_TABLE;
+        jit.cpu.dispatch   = CPU_DISPATCH_JIT;
+
+        // Translated blocks only stop at their exits: catch up the table engine there
+        while (!jit.cpu.halted) {
+            cpu_run(&jit.cpu, 1);
+            while (table.cycles < jit.cycles)
+                cpu_run(&table.cpu, 1);
+            assert_same_state(&table, &jit);
+        }
+
+        ck_assert(table.cpu.halted);
+        ck_assert_mem_eq(table.wram, jit.wram, sizeof(table.wram));
+        ck_assert_mem_eq(table.hram, jit.hram, sizeof(table.hram));
+        for (int i = 0; i < CPU_BLOCK_CACHE_SIZE; i++)
+            translated += (cpu_jit_native(&jit.blocks.blocks[i]) != NULL);
+
+        teardown_program(&table);
+        teardown_program(&jit);
+        free(program);
+    }
+
+    // The loop bodies ran as native code
+    ck_assert_int_gt(translated, 0);
+}
+END_TEST
+
+// ============================================================================
+// AOT Tests
+// ============================================================================
+
+// Stand-in for a generated function: LD A, 0x42 at 0x0100, plus a marker in B
+static u32 aot_test_block(CPU *cpu) {
+    cpu->regs.a = 0x42;
+    cpu->regs.b = 0x99;
+    cpu->pc     = 0x0102;
+    return 8;
+}
+
+// Blocks of a registered ROM run their generated function
+START_TEST(test_aot_registered_rom) {
+    static const u8          code[]   = {0x3E, 0x42, 0x76}; // LD A, 0x42; HALT
+    static const CpuAotBlock blocks[] = {{0x0100, aot_test_block}};
+    static CpuAotImage       image    = {.blocks = blocks, .count = 1};
+    GameBoy                  gb       = {0};
+
+    setup_program(&gb, code, sizeof(code), true);
+    image.rom_size = gb.cart.rom_size;
+    image.rom_hash = cpu_aot_rom_hash(gb.cart.rom, gb.cart.rom_size);
+    cpu_aot_register(&image);
+
+    gb.blocks.aot   = cpu_aot_find(&gb.cart);
+    gb.cpu.dispatch = CPU_DISPATCH_JIT;
+    ck_assert_ptr_eq(gb.blocks.aot, &image);
+
+    cpu_run(&gb.cpu, 100);
+    ck_assert(gb.cpu.halted);
+    ck_assert_uint_eq(gb.cpu.regs.a, 0x42);
+    ck_assert_uint_eq(gb.cpu.regs.b, 0x99);
+    ck_assert_uint_eq(gb.cycles, 12);
+
+    // Any other ROM of the same size has no image
+    gb.cart.rom[0x0200] ^= 0xFF;
+    ck_assert_ptr_null(cpu_aot_find(&gb.cart));
+
+    teardown_program(&gb);
+}
+END_TEST
+
+// A ROM file that isn't a whole power of two of banks (36 KiB) matches the
+// image gbaot would generate for it: size & hash of the 0xFF-padded ROM
+START_TEST(test_aot_padded_rom) {
+    static const CpuAotBlock blocks[] = {{0x0100, aot_test_block}};
+    static CpuAotImage       image    = {.blocks = blocks, .count = 1};
+    char                     path[]   = "/tmp/baredmg_aotXXXXXX";
+    size_t                   size     = 0x9000;
+    u8                      *data     = malloc(size);
+    Cartridge                cart     = {0};
+
+    for (size_t i = 0; i < size; i++)
+        data[i] = (u8)(i * 13);
+    data[0x0147] = 0x00; // ROM only
+    data[0x0149] = 0x00; // No RAM
+    u8 checksum  = 0;
+    for (u16 addr = 0x0134; addr <= 0x014C; addr++)
+        checksum = checksum - data[addr] - 1;
+    data[0x014D] = checksum;
+
+    int fd = mkstemp(path);
+    ck_assert_int_ge(fd, 0);
+    ck_assert_int_eq(write(fd, data, size), (ssize_t)size);
+    close(fd);
+
+    // gbaot's load_rom()
+    size_t padded = cart_padded_rom_size(size);
+    u8    *rom    = malloc(padded);
+    memset(rom, 0xFF, padded);
+    memcpy(rom, data, size);
+    image.rom_size = (u32)padded;
+    image.rom_hash = cpu_aot_rom_hash(rom, padded);
+    cpu_aot_register(&image);
+
+    ck_assert_int_eq(cart_load(&cart, path), 0);
+    ck_assert_uint_eq(cart.rom_size, 0x10000);
+    ck_assert_ptr_eq(cpu_aot_find(&cart), &image);
+
+    cart_unload(&cart);
+    unlink(path);
+    free(rom);
+    free(data);
+}
+END_TEST
+
+// ============================================================================
+// Test Suite Setup
+// ============================================================================
+Suite *cpu_suite(void) {
+    Suite *s;
+    TCase *tc_lazy;
+    TCase *tc_stack;
+    TCase *tc_irq;
+    TCase *tc_block;
+    TCase *tc_jit;
+    TCase *tc_aot;
+
+    s       = suite_create("CPU");
+
+    tc_lazy = tcase_create("Lazy Flags");
+    tcase_add_test(tc_lazy, test_lazy_flags_jr_c);
+    tcase_add_test(tc_lazy, test_lazy_flags_push_af);
+    tcase_add_test(tc_lazy, test_lazy_flags_daa);
+    tcase_add_test(tc_lazy, test_lazy_flags_toggle);
+    tcase_add_test(tc_lazy, test_lazy_flags_match_eager);
+    suite_add_tcase(s, tc_lazy);
+
+    tc_stack = tcase_create("Stack");
+    tcase_add_test(tc_stack, test_call_ret);
+    suite_add_tcase(s, tc_stack);
+
+    tc_irq = tcase_create("Interrupts");
+    tcase_add_test(tc_irq, test_interrupt_dispatch);
+    tcase_add_test(tc_irq, test_interrupt_priority);
+    tcase_add_test(tc_irq, test_interrupt_wakes_halt);
+    suite_add_tcase(s, tc_irq);
+
+    tc_block = tcase_create("Block Cache");
+    tcase_add_test(tc_block, test_block_self_modifying);
+    tcase_add_test(tc_block, test_block_match_table);
+    tcase_add_test(tc_block, test_block_idle_loop);
+    tcase_add_test(tc_block, test_block_idle_not_skipped);
+    suite_add_tcase(s, tc_block);
+
+    tc_jit = tcase_create("JIT");
+    tcase_add_test(tc_jit, test_jit_match_table);
+    suite_add_tcase(s, tc_jit);
+
+    tc_aot = tcase_create("AOT");
+    tcase_add_test(tc_aot, test_aot_registered_rom);
+    tcase_add_test(tc_aot, test_aot_padded_rom);
+    suite_add_tcase(s, tc_aot);
+
+    return s;
+}
+
+int main(void) {
+    int      number_failed;
+    Suite   *s;
+    SRunner *sr;
+
+    s  = cpu_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_NORMAL);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (number_failed == 0) ? 0 : 1;
+}
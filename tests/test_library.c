@@ -0,0 +1,214 @@
+// tests/test_library.c
+#include <check.h>
+#include <core/library.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ---------------------------------------------
+// Helpers
+// ---------------------------------------------
+
+// Write a 32 KiB ROM titled `title` with valid header & global checksums
+static void write_rom(const char *dir, const char *name, const char *title) {
+    char path[256];
+    u8  *rom = calloc(1, 0x8000);
+
+    for (size_t i = 0x150; i < 0x8000; i++)
+        rom[i] = (u8)i;
+    memcpy(rom + 0x0134, title, strlen(title));
+    rom[0x0147] = 0x01; // MBC1
+
+    u8 checksum = 0;
+    for (u16 addr = 0x0134; addr <= 0x014C; addr++)
+        checksum = checksum - rom[addr] - 1;
+    rom[0x014D] = checksum;
+
+    u16 sum = 0;
+    for (size_t i = 0; i < 0x8000; i++)
+        sum += rom[i];
+    rom[0x014E] = GET_HIGH_BYTE(sum);
+    rom[0x014F] = GET_LOW_BYTE(sum);
+
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    FILE *file = fopen(path, "wb");
+    ck_assert_ptr_nonnull(file);
+    ck_assert_uint_eq(fwrite(rom, 1, 0x8000, file), 0x8000);
+    fclose(file);
+    free(rom);
+}
+
+static void remove_file(const char *dir, const char *name) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    unlink(path);
+}
+
+// ============================================================================
+// Library Tests
+// ============================================================================
+
+// Only ROM files are indexed (subdirectories too), sorted by path
+START_TEST(test_scan_directory) {
+    char    dir[] = "/tmp/baredmg_libXXXXXX";
+    char    sub[64];
+    Library lib;
+
+    ck_assert_ptr_nonnull(mkdtemp(dir));
+    snprintf(sub, sizeof(sub), "%s/sub", dir);
+    ck_assert_int_eq(mkdir(sub, 0700), 0);
+    write_rom(dir, "b.gb", "BETA");
+    write_rom(sub, "a.GBC", "ALPHA");
+    write_rom(dir, "notes.txt", "TEXT");
+
+    ck_assert_int_eq(library_scan(&lib, dir, NULL, 4), 0);
+    ck_assert_uint_eq(lib.count, 2);
+    ck_assert_uint_eq(lib.probed, 2);
+    ck_assert_str_eq(lib.entries[0].title, "BETA");
+    ck_assert_str_eq(lib.entries[1].title, "ALPHA");
+    ck_assert_uint_eq(lib.entries[1].cart_type, 0x01);
+    ck_assert_uint_eq(lib.entries[1].size, 0x8000);
+    ck_assert(lib.entries[1].header_ok);
+    ck_assert(lib.entries[1].global_ok);
+    ck_assert_uint_ne(lib.entries[0].crc32, lib.entries[1].crc32);
+    library_free(&lib);
+
+    ck_assert_int_eq(library_scan(&lib, "/nonexistent/baredmg", NULL, 1), -1);
+
+    remove_file(sub, "a.GBC");
+    rmdir(sub);
+    remove_file(dir, "b.gb");
+    remove_file(dir, "notes.txt");
+    rmdir(dir);
+}
+END_TEST
+
+// The CSV index reads back identical, a rescan against it opens only changed files
+START_TEST(test_cache_rescan) {
+    char    dir[] = "/tmp/baredmg_libXXXXXX";
+    char    index[128];
+    Library lib;
+    Library cache;
+    Library rescan;
+
+    ck_assert_ptr_nonnull(mkdtemp(dir));
+    write_rom(dir, "one.gb", "ONE \"QUOTED\"");
+    write_rom(dir, "two.gb", "TWO");
+    ck_assert_int_eq(library_scan(&lib, dir, NULL, 0), 0);
+
+    snprintf(index, sizeof(index), "%s/index.csv", dir);
+    FILE *out = fopen(index, "w");
+    ck_assert_ptr_nonnull(out);
+    library_write(&lib, out, LIBRARY_CSV);
+    fclose(out);
+
+    ck_assert_int_eq(library_load(&cache, index), 0);
+    ck_assert_uint_eq(cache.count, 2);
+    for (size_t i = 0; i < 2; i++) {
+        ck_assert_str_eq(cache.entries[i].path, lib.entries[i].path);
+        ck_assert_str_eq(cache.entries[i].title, lib.entries[i].title);
+        ck_assert_uint_eq(cache.entries[i].size, lib.entries[i].size);
+        ck_assert_int_eq(cache.entries[i].mtime, lib.entries[i].mtime);
+        ck_assert_uint_eq(cache.entries[i].crc32, lib.entries[i].crc32);
+        ck_assert_int_eq(cache.entries[i].global_ok, lib.entries[i].global_ok);
+    }
+
+    ck_assert_int_eq(library_scan(&rescan, dir, &cache, 0), 0);
+    ck_assert_uint_eq(rescan.count, 2);
+    ck_assert_uint_eq(rescan.probed, 0);
+    ck_assert_str_eq(rescan.entries[0].title, "ONE \"QUOTED\"");
+    library_free(&rescan);
+
+    // A different size invalidates the cached entry
+    char path[128];
+    snprintf(path, sizeof(path), "%s/two.gb", dir);
+    ck_assert_int_eq(truncate(path, 0x4000), 0);
+    ck_assert_int_eq(library_scan(&rescan, dir, &cache, 0), 0);
+    ck_assert_uint_eq(rescan.probed, 1);
+    ck_assert_uint_eq(rescan.entries[1].size, 0x4000);
+    ck_assert(!rescan.entries[1].global_ok);
+
+    library_free(&rescan);
+    library_free(&cache);
+    library_free(&lib);
+    remove_file(dir, "one.gb");
+    remove_file(dir, "two.gb");
+    remove_file(dir, "index.csv");
+    rmdir(dir);
+}
+END_TEST
+
+// A file with a bad header is indexed and flagged, its CRC-32 matches the
+// bitwise definition. Files too small for a header are left out
+START_TEST(test_bad_header_crc32) {
+    char    dir[] = "/tmp/baredmg_libXXXXXX";
+    char    path[128];
+    u8      data[0x0200];
+    Library lib;
+
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = (u8)(i * 7);
+    ck_assert_ptr_nonnull(mkdtemp(dir));
+    snprintf(path, sizeof(path), "%s/bad.gb", dir);
+
+    FILE *file = fopen(path, "wb");
+    ck_assert_ptr_nonnull(file);
+    ck_assert_uint_eq(fwrite(data, 1, sizeof(data), file), sizeof(data));
+    fclose(file);
+
+    u32 crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < sizeof(data); i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++)
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+    }
+
+    ck_assert_int_eq(library_scan(&lib, dir, NULL, 1), 0);
+    ck_assert_uint_eq(lib.count, 1);
+    ck_assert(!lib.entries[0].header_ok);
+    ck_assert_uint_eq(lib.entries[0].crc32, ~crc);
+    library_free(&lib);
+
+    ck_assert_int_eq(truncate(path, 0x0100), 0);
+    ck_assert_int_eq(library_scan(&lib, dir, NULL, 1), 0);
+    ck_assert_uint_eq(lib.count, 0);
+    library_free(&lib);
+
+    unlink(path);
+    rmdir(dir);
+}
+END_TEST
+
+// ============================================================================
+// Test Suite Setup
+// ============================================================================
+Suite *library_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+
+    s       = suite_create("Library");
+
+    tc_core = tcase_create("Core");
+    tcase_add_test(tc_core, test_scan_directory);
+    tcase_add_test(tc_core, test_cache_rescan);
+    tcase_add_test(tc_core, test_bad_header_crc32);
+    suite_add_tcase(s, tc_core);
+
+    return s;
+}
+
+int main(void) {
+    int      number_failed;
+    Suite   *s;
+    SRunner *sr;
+
+    s  = library_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_NORMAL);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (number_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,380 @@
+// tests/test_mbc.c
+#include <check.h>
+#include <gbemu.h>
+#include <core/bus.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ---------------------------------------------
+// Helpers
+// ---------------------------------------------
+
+// Cartridge of header type `type`: every ROM bank is filled with its number
+// (low byte), with the high byte in its last byte
+static void setup_cart(GameBoy *gb, u8 type, size_t rom_size, size_t ram_size) {
+    gb_init(gb);
+    gb->cart.rom      = malloc(rom_size);
+    gb->cart.rom_size = rom_size;
+    gb->cart.ram      = (ram_size > 0) ? calloc(1, ram_size) : NULL;
+    gb->cart.ram_size = ram_size;
+
+    for (size_t bank = 0; bank < rom_size / 0x4000; bank++) {
+        u8 *data = gb->cart.rom + bank * 0x4000;
+        memset(data, (u8)bank, 0x4000);
+        data[0x3FFF] = (u8)(bank >> 8);
+    }
+
+    gb->cart.header.cart_type = type;
+    mbc_init(&gb->cart);
+    mmu_map_invalidate(gb, 0x00, 0xFF);
+}
+
+static void teardown_cart(GameBoy *gb) {
+    free(gb->cart.rom);
+    free(gb->cart.ram);
+    gb->cart.rom = NULL;
+    gb->cart.ram = NULL;
+}
+
+// Bank mapped at `addr` (0x0000 or 0x4000)
+static u16 bank_at(GameBoy *gb, u16 addr) {
+    return MAKE_U16(mmu_read(gb, addr + 0x3FFF), mmu_read(gb, addr + 0x100));
+}
+
+// ============================================================================
+// ROM Banking Tests
+// ============================================================================
+
+// MBC1: 5-bit bank (0 -> 1), bank2 extends it and maps 0x0000 in mode 1
+START_TEST(test_mbc1_rom_banks) {
+    static GameBoy gb;
+    setup_cart(&gb, 0x01, 2 * 1024 * 1024, 0);
+
+    ck_assert_uint_eq(bank_at(&gb, 0x0000), 0);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 1);
+
+    mmu_write(&gb, 0x2000, 0x05);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 5);
+    mmu_write(&gb, 0x2000, 0x00);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 1);
+    mmu_write(&gb, 0x3FFF, 0x23); // Only 5 bits
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 3);
+
+    mmu_write(&gb, 0x4000, 0x02);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 0x43);
+    ck_assert_uint_eq(bank_at(&gb, 0x0000), 0);
+    mmu_write(&gb, 0x6000, 0x01);
+    ck_assert_uint_eq(bank_at(&gb, 0x0000), 0x40);
+    teardown_cart(&gb);
+}
+END_TEST
+
+// MBC3: 7-bit bank. MBC5: 9-bit bank, bank 0 allowed, 8 MiB
+START_TEST(test_mbc3_mbc5_rom_banks) {
+    static GameBoy gb;
+    setup_cart(&gb, 0x13, 2 * 1024 * 1024, 0);
+    mmu_write(&gb, 0x2000, 0x7F);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 0x7F);
+    mmu_write(&gb, 0x2000, 0x00);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 1);
+    teardown_cart(&gb);
+
+    setup_cart(&gb, 0x19, 8 * 1024 * 1024, 0);
+    mmu_write(&gb, 0x2000, 0x00);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 0);
+    mmu_write(&gb, 0x2000, 0xFF);
+    mmu_write(&gb, 0x3000, 0x01);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 0x1FF);
+    mmu_write(&gb, 0x2000, 0x34);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 0x134);
+    teardown_cart(&gb);
+}
+END_TEST
+
+// Banks past the end of the ROM wrap around, as the missing pins do
+START_TEST(test_rom_bank_wrap) {
+    static GameBoy gb;
+    setup_cart(&gb, 0x19, 256 * 1024, 0);
+
+    mmu_write(&gb, 0x2000, 0x13);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 0x03);
+    teardown_cart(&gb);
+}
+END_TEST
+
+// Bank pointers are only recomputed (and counted) when the mapping changes,
+// the page table and the fetch window follow them
+START_TEST(test_bank_switch_remaps) {
+    static GameBoy gb;
+    setup_cart(&gb, 0x19, 1024 * 1024, 0);
+
+    mmu_write(&gb, 0x2000, 0x07);
+    ck_assert_uint_eq(gb.cart.mbc.rom_switches, 1);
+    ck_assert_ptr_eq(gb.cart.mbc.rom_bank_ptr, gb.cart.rom + 7 * 0x4000);
+    ck_assert_uint_eq(mmu_read(&gb, 0x4000), 7);
+    ck_assert_ptr_eq(gb.read_map[0x40], gb.cart.rom + 7 * 0x4000);
+
+    mmu_write(&gb, 0x2000, 0x07);
+    ck_assert_uint_eq(gb.cart.mbc.rom_switches, 1);
+    ck_assert_ptr_nonnull(gb.read_map[0x40]);
+
+    mmu_fetch_region(&gb, 0x4000, &gb.cpu);
+    mmu_write(&gb, 0x2000, 0x09);
+    ck_assert_uint_eq(gb.cart.mbc.rom_switches, 2);
+    ck_assert_ptr_null(gb.read_map[0x40]);
+    ck_assert_uint_eq(gb.cpu.fetch_len, 0);
+
+    mmu_fetch_region(&gb, 0x4000, &gb.cpu);
+    ck_assert_ptr_eq(gb.cpu.fetch_ptr, gb.cart.rom + 9 * 0x4000);
+    teardown_cart(&gb);
+}
+END_TEST
+
+// ============================================================================
+// RAM Banking Tests
+// ============================================================================
+
+// RAM reads 0xFF until enabled, banks select 8 KiB windows
+START_TEST(test_ram_enable_banks) {
+    static const u8 types[] = {0x03, 0x13, 0x1B}; // MBC1 / MBC3 / MBC5 +RAM+BATTERY
+    static GameBoy  gb;
+
+    for (int i = 0; i < 3; i++) {
+        setup_cart(&gb, types[i], 64 * 1024, 32 * 1024);
+        if (types[i] == 0x03)
+            mmu_write(&gb, 0x6000, 0x01); // MBC1: RAM banking mode
+
+        mmu_write(&gb, 0xA000, 0x11);
+        ck_assert_uint_eq(mmu_read(&gb, 0xA000), 0xFF);
+        ck_assert_uint_eq(gb.cart.ram[0], 0x00);
+
+        mmu_write(&gb, 0x0000, 0x0A);
+        mmu_write(&gb, 0xA000, 0x11);
+        mmu_write(&gb, 0x4000, 0x02);
+        mmu_write(&gb, 0xA000, 0x22);
+        ck_assert_uint_eq(gb.cart.ram[0x0000], 0x11);
+        ck_assert_uint_eq(gb.cart.ram[0x4000], 0x22);
+
+        mmu_write(&gb, 0x4000, 0x00);
+        ck_assert_uint_eq(mmu_read(&gb, 0xA000), 0x11);
+        mmu_write(&gb, 0x0000, 0x00);
+        ck_assert_uint_eq(mmu_read(&gb, 0xA000), 0xFF);
+        ck_assert_uint_eq(gb.cart.mbc.ram_switches, 4);
+        teardown_cart(&gb);
+    }
+}
+END_TEST
+
+// MBC2: 512 nibbles mirrored through 0xA000 - 0xBFFF, address bit 8 picks the register
+START_TEST(test_mbc2) {
+    static GameBoy gb;
+    setup_cart(&gb, 0x06, 256 * 1024, 0x200);
+
+    mmu_write(&gb, 0x2100, 0x05);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 5);
+    mmu_write(&gb, 0x2000, 0x0A); // Bit 8 clear: RAM enable
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 5);
+
+    mmu_write(&gb, 0xA001, 0x3C);
+    ck_assert_uint_eq(mmu_read(&gb, 0xA001), 0xFC);
+    ck_assert_uint_eq(mmu_read(&gb, 0xA201), 0xFC);
+    ck_assert_uint_eq(mmu_read(&gb, 0xBE01), 0xFC);
+    teardown_cart(&gb);
+}
+END_TEST
+
+// MBC3: 0x08 - 0x0C in the RAM bank register select the RTC registers
+START_TEST(test_mbc3_rtc_select) {
+    static GameBoy gb;
+    setup_cart(&gb, 0x10, 64 * 1024, 8 * 1024);
+
+    mmu_write(&gb, 0x0000, 0x0A);
+    mmu_write(&gb, 0xA000, 0x55);
+    mmu_write(&gb, 0x4000, 0x08);
+    mmu_write(&gb, 0xA000, 0x2A);
+    ck_assert_uint_eq(mmu_read(&gb, 0xA000), 0x2A);
+    ck_assert_uint_eq(gb.cart.ram[0], 0x55);
+
+    mmu_write(&gb, 0x4000, 0x00);
+    ck_assert_uint_eq(mmu_read(&gb, 0xA000), 0x55);
+    teardown_cart(&gb);
+}
+END_TEST
+
+// ============================================================================
+// MBC3 RTC Tests
+// ============================================================================
+#define SECOND MBC_RTC_CYCLE_RATE
+
+// Latch the clock at cycle `cycles`
+static void rtc_latch_at(GameBoy *gb, u64 cycles) {
+    gb->cycles = cycles;
+    mmu_write(gb, 0x6000, 0x00);
+    mmu_write(gb, 0x6000, 0x01);
+}
+
+// RTC register 0x08 - 0x0C as last latched
+static u8 rtc_read(GameBoy *gb, u8 reg) {
+    mmu_write(gb, 0x4000, reg);
+    return mmu_read(gb, 0xA000);
+}
+
+static void rtc_write(GameBoy *gb, u8 reg, u8 value) {
+    mmu_write(gb, 0x4000, reg);
+    mmu_write(gb, 0xA000, value);
+}
+
+// The registers only change on a latch (0x00 then 0x01), derived from the cycle count
+START_TEST(test_rtc_latch_from_cycles) {
+    static GameBoy gb;
+    setup_cart(&gb, 0x10, 64 * 1024, 8 * 1024);
+    mmu_write(&gb, 0x0000, 0x0A);
+
+    rtc_latch_at(&gb, 3 * SECOND + 5);
+    ck_assert_uint_eq(rtc_read(&gb, 0x08), 3);
+
+    gb.cycles = (3600 + 61) * (u64)SECOND;
+    ck_assert_uint_eq(rtc_read(&gb, 0x08), 3);
+    mmu_write(&gb, 0x6000, 0x01); // No 0x00 first: no latch
+    ck_assert_uint_eq(rtc_read(&gb, 0x08), 3);
+
+    rtc_latch_at(&gb, gb.cycles);
+    ck_assert_uint_eq(rtc_read(&gb, 0x08), 1);
+    ck_assert_uint_eq(rtc_read(&gb, 0x09), 1);
+    ck_assert_uint_eq(rtc_read(&gb, 0x0A), 1);
+    ck_assert_uint_eq(rtc_read(&gb, 0x0B), 0);
+    teardown_cart(&gb);
+}
+END_TEST
+
+// Halt stops the clock, writing the seconds restarts the current second
+START_TEST(test_rtc_halt) {
+    static GameBoy gb;
+    setup_cart(&gb, 0x10, 64 * 1024, 8 * 1024);
+    mmu_write(&gb, 0x0000, 0x0A);
+
+    gb.cycles = 10 * SECOND;
+    rtc_write(&gb, 0x0C, 0x40);
+    rtc_latch_at(&gb, 100 * SECOND);
+    ck_assert_uint_eq(rtc_read(&gb, 0x08), 10);
+    ck_assert_uint_eq(rtc_read(&gb, 0x0C), 0x40);
+
+    rtc_write(&gb, 0x0C, 0x00);
+    rtc_latch_at(&gb, 102 * SECOND + SECOND / 2);
+    ck_assert_uint_eq(rtc_read(&gb, 0x08), 12);
+
+    rtc_write(&gb, 0x08, 0x00);
+    rtc_latch_at(&gb, 103 * SECOND + SECOND / 4);
+    ck_assert_uint_eq(rtc_read(&gb, 0x08), 0);
+    rtc_latch_at(&gb, 103 * SECOND + SECOND / 2);
+    ck_assert_uint_eq(rtc_read(&gb, 0x08), 1);
+    teardown_cart(&gb);
+}
+END_TEST
+
+// Day 511 rolls over to 0 and sets the sticky carry, out-of-range seconds wrap at 64
+START_TEST(test_rtc_day_carry) {
+    static GameBoy gb;
+    setup_cart(&gb, 0x10, 64 * 1024, 8 * 1024);
+    mmu_write(&gb, 0x0000, 0x0A);
+
+    rtc_write(&gb, 0x08, 59);
+    rtc_write(&gb, 0x09, 59);
+    rtc_write(&gb, 0x0A, 23);
+    rtc_write(&gb, 0x0B, 0xFF);
+    rtc_write(&gb, 0x0C, 0x01);
+    rtc_latch_at(&gb, 2 * SECOND);
+    ck_assert_uint_eq(rtc_read(&gb, 0x08), 1);
+    ck_assert_uint_eq(rtc_read(&gb, 0x0A), 0);
+    ck_assert_uint_eq(rtc_read(&gb, 0x0B), 0);
+    ck_assert_uint_eq(rtc_read(&gb, 0x0C), 0x80);
+
+    rtc_latch_at(&gb, 90000 * (u64)SECOND);
+    ck_assert_uint_eq(rtc_read(&gb, 0x0B), 1);
+    ck_assert_uint_eq(rtc_read(&gb, 0x0C), 0x80);
+    rtc_write(&gb, 0x0C, 0x00);
+    ck_assert_uint_eq(rtc_read(&gb, 0x0C), 0x00);
+
+    rtc_write(&gb, 0x08, 62);
+    rtc_write(&gb, 0x09, 0);
+    rtc_latch_at(&gb, gb.cycles + 2 * SECOND);
+    ck_assert_uint_eq(rtc_read(&gb, 0x08), 0);
+    ck_assert_uint_eq(rtc_read(&gb, 0x09), 0);
+    teardown_cart(&gb);
+}
+END_TEST
+
+// The .sav footer restores live & latched registers (cycle clock: no time passes)
+START_TEST(test_rtc_save_restore) {
+    static GameBoy gb;
+    u8             footer[MBC_RTC_SAVE_SIZE];
+
+    setup_cart(&gb, 0x10, 64 * 1024, 8 * 1024);
+    mmu_write(&gb, 0x0000, 0x0A);
+    rtc_write(&gb, 0x0A, 5);
+    rtc_latch_at(&gb, 7 * SECOND);
+    mbc_rtc_store(&gb.cart, footer, 9 * SECOND);
+    ck_assert_uint_eq(footer[0], 9);
+    ck_assert_uint_eq(footer[20], 7);
+    teardown_cart(&gb);
+
+    setup_cart(&gb, 0x10, 64 * 1024, 8 * 1024);
+    mbc_rtc_load(&gb.cart, footer);
+    mmu_write(&gb, 0x0000, 0x0A);
+    ck_assert_uint_eq(rtc_read(&gb, 0x08), 7);
+    ck_assert_uint_eq(rtc_read(&gb, 0x0A), 5);
+    rtc_latch_at(&gb, SECOND);
+    ck_assert_uint_eq(rtc_read(&gb, 0x08), 10);
+    ck_assert_uint_eq(rtc_read(&gb, 0x0A), 5);
+    teardown_cart(&gb);
+}
+END_TEST
+
+// ============================================================================
+// Test Suite Setup
+// ============================================================================
+Suite *mbc_suite(void) {
+    Suite *s;
+    TCase *tc_rom;
+    TCase *tc_ram;
+    TCase *tc_rtc;
+
+    s      = suite_create("MBC");
+
+    tc_rom = tcase_create("ROM Banking");
+    tcase_add_test(tc_rom, test_mbc1_rom_banks);
+    tcase_add_test(tc_rom, test_mbc3_mbc5_rom_banks);
+    tcase_add_test(tc_rom, test_rom_bank_wrap);
+    tcase_add_test(tc_rom, test_bank_switch_remaps);
+    suite_add_tcase(s, tc_rom);
+
+    tc_ram = tcase_create("RAM Banking");
+    tcase_add_test(tc_ram, test_ram_enable_banks);
+    tcase_add_test(tc_ram, test_mbc2);
+    tcase_add_test(tc_ram, test_mbc3_rtc_select);
+    suite_add_tcase(s, tc_ram);
+
+    tc_rtc = tcase_create("MBC3 RTC");
+    tcase_add_test(tc_rtc, test_rtc_latch_from_cycles);
+    tcase_add_test(tc_rtc, test_rtc_halt);
+    tcase_add_test(tc_rtc, test_rtc_day_carry);
+    tcase_add_test(tc_rtc, test_rtc_save_restore);
+    suite_add_tcase(s, tc_rtc);
+
+    return s;
+}
+
+int main(void) {
+    int      number_failed;
+    Suite   *s;
+    SRunner *sr;
+
+    s  = mbc_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_NORMAL);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (number_failed == 0) ? 0 : 1;
+}
@@ -3,6 +3,7 @@
 #include <gbemu.h>
 #include <core/bus.h>
 #include <stdlib.h>
+#include <string.h>
 
 // ============================================================================
 // WRAM Tests
@@ -136,13 +137,287 @@ START_TEST(test_ie_register) {
 }
 END_TEST
 
+// ============================================================================
+// Page Table Tests
+// ============================================================================
+
+START_TEST(test_map_plain_pages) {
+    GameBoy gb = {0};
+    gb_init(&gb);
+
+    // First access goes through the slow path and maps the page
+    mmu_write(&gb, 0xC123, 0x5A);
+    ck_assert_ptr_nonnull(gb.write_map[0xC1]);
+    ck_assert_uint_eq(mmu_read(&gb, 0xE123), 0x5A); // Echo
+    ck_assert_ptr_nonnull(gb.read_map[0xE1]);
+
+    // IO, OAM & HRAM pages always use the slow path
+    mmu_write(&gb, 0xFE00, 0x11);
+    mmu_write(&gb, 0xFF80, 0x22);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFE00), 0x11);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF80), 0x22);
+    ck_assert_ptr_null(gb.read_map[0xFE]);
+    ck_assert_ptr_null(gb.read_map[0xFF]);
+    ck_assert_ptr_null(gb.write_map[0xFF]);
+}
+END_TEST
+
+START_TEST(test_map_rom_pages) {
+    GameBoy gb = {0};
+    gb_init(&gb);
+
+    // ROM that ends in the middle of a page
+    gb.cart.rom         = calloc(1, 0x0150);
+    gb.cart.rom_size    = 0x0150;
+    gb.cart.rom[0x0000] = 0xAA;
+    gb.cart.rom[0x014F] = 0xBB;
+
+    ck_assert_uint_eq(mmu_read(&gb, 0x0000), 0xAA);
+    ck_assert_ptr_nonnull(gb.read_map[0x00]);
+
+    // Partial page stays on the bounds-checked slow path
+    ck_assert_uint_eq(mmu_read(&gb, 0x014F), 0xBB);
+    ck_assert_uint_eq(mmu_read(&gb, 0x0150), 0xFF);
+    ck_assert_ptr_null(gb.read_map[0x01]);
+
+    // ROM writes never get a direct pointer
+    mmu_write(&gb, 0x0000, 0x00);
+    ck_assert_ptr_null(gb.write_map[0x00]);
+    ck_assert_uint_eq(mmu_read(&gb, 0x0000), 0xAA);
+
+    free(gb.cart.rom);
+}
+END_TEST
+
+START_TEST(test_map_invalidate) {
+    GameBoy gb = {0};
+    gb_init(&gb);
+
+    u8 *rom_a     = calloc(1, 0x8000);
+    u8 *rom_b     = calloc(1, 0x8000);
+    rom_a[0x4000] = 0x01;
+    rom_b[0x4000] = 0x02;
+
+    gb.cart.rom      = rom_a;
+    gb.cart.rom_size = 0x8000;
+    ck_assert_uint_eq(mmu_read(&gb, 0x4000), 0x01);
+
+    // Swap the buffer, as a bank switch would
+    gb.cart.rom = rom_b;
+    mmu_map_invalidate(&gb, 0x40, 0x7F);
+    ck_assert_uint_eq(mmu_read(&gb, 0x4000), 0x02);
+
+    // Unmapping the boot ROM drops page 0x00
+    ck_assert_uint_eq(mmu_read(&gb, 0x0000), 0x00);
+    ck_assert_ptr_nonnull(gb.read_map[0x00]);
+    mmu_write(&gb, 0xFF50, 0x01);
+    ck_assert_ptr_null(gb.read_map[0x00]);
+
+    free(rom_a);
+    free(rom_b);
+}
+END_TEST
+
+// ============================================================================
+// Instruction Fetch Tests
+// ============================================================================
+
+START_TEST(test_fetch_rom_window) {
+    GameBoy gb = {0};
+    gb_init(&gb);
+
+    gb.cart.rom         = calloc(1, 0x8000);
+    gb.cart.rom_size    = 0x8000;
+    gb.cart.rom[0x3FFF] = 0x12;
+    gb.cart.rom[0x4000] = 0x34;
+
+    // Crossing from bank 0 into bank N re-resolves the window
+    gb.cpu.pc = 0x3FFF;
+    ck_assert_uint_eq(mmu_fetch8(&gb.cpu), 0x12);
+    ck_assert_uint_eq(gb.cpu.fetch_lo, 0x0000);
+    ck_assert_uint_eq(mmu_fetch8(&gb.cpu), 0x34);
+    ck_assert_uint_eq(gb.cpu.fetch_lo, 0x4000);
+    ck_assert_uint_eq(gb.cpu.pc, 0x4001);
+
+    // Invalidating the map drops the window
+    mmu_map_invalidate(&gb, 0x40, 0x7F);
+    ck_assert_uint_eq(gb.cpu.fetch_len, 0);
+
+    free(gb.cart.rom);
+}
+END_TEST
+
+START_TEST(test_fetch_ram_coherent) {
+    GameBoy gb = {0};
+    gb_init(&gb);
+
+    // Code written to WRAM is visible to the next fetch
+    gb.cpu.pc = 0xC000;
+    ck_assert_uint_eq(mmu_fetch8(&gb.cpu), 0x00);
+    mmu_write(&gb, 0xC001, 0x3C);
+    ck_assert_uint_eq(mmu_fetch8(&gb.cpu), 0x3C);
+
+    // Same for HRAM
+    mmu_write(&gb, 0xFF80, 0xAF);
+    gb.cpu.pc = 0xFF80;
+    ck_assert_uint_eq(mmu_fetch8(&gb.cpu), 0xAF);
+
+    // No window over IO: reads go through the handlers
+    gb.cpu.pc = 0xFF0F;
+    ck_assert_uint_eq(mmu_fetch8(&gb.cpu), gb.io.if_reg | 0xE0);
+    ck_assert_uint_eq(gb.cpu.fetch_len, 0);
+}
+END_TEST
+
+// ============================================================================
+// 16-bit Access Tests
+// ============================================================================
+
+START_TEST(test_word_same_page) {
+    GameBoy gb = {0};
+    gb_init(&gb);
+
+    mmu_write16(&gb, 0xC010, 0xBEEF);
+    ck_assert_uint_eq(mmu_read(&gb, 0xC010), 0xEF); // Little endian
+    ck_assert_uint_eq(mmu_read(&gb, 0xC011), 0xBE);
+    ck_assert_uint_eq(mmu_read16(&gb, 0xC010), 0xBEEF);
+    ck_assert_uint_eq(mmu_read16(&gb, 0xE010), 0xBEEF); // Echo
+}
+END_TEST
+
+START_TEST(test_word_page_boundary) {
+    GameBoy gb = {0};
+    gb_init(&gb);
+
+    // Bytes land in two different pages
+    mmu_write16(&gb, 0xC0FF, 0x1234);
+    ck_assert_uint_eq(mmu_read(&gb, 0xC0FF), 0x34);
+    ck_assert_uint_eq(mmu_read(&gb, 0xC100), 0x12);
+    ck_assert_uint_eq(mmu_read16(&gb, 0xC0FF), 0x1234);
+
+    // Immediate word split across two fetch windows
+    gb.cart.rom         = calloc(1, 0x8000);
+    gb.cart.rom_size    = 0x8000;
+    gb.cart.rom[0x3FFF] = 0x78;
+    gb.cart.rom[0x4000] = 0x56;
+
+    gb.cpu.pc = 0x3FFF;
+    ck_assert_uint_eq(mmu_fetch16(&gb.cpu), 0x5678);
+    ck_assert_uint_eq(gb.cpu.pc, 0x4001);
+
+    free(gb.cart.rom);
+}
+END_TEST
+
+START_TEST(test_word_hram_stack) {
+    GameBoy gb = {0};
+    gb_init(&gb);
+
+    gb.cpu.sp = 0xFFFE;
+    mmu_push16(&gb.cpu, 0xABCD);
+    ck_assert_uint_eq(gb.cpu.sp, 0xFFFC);
+    ck_assert_uint_eq(gb.hram[0x7C], 0xCD);
+    ck_assert_uint_eq(gb.hram[0x7D], 0xAB);
+
+    ck_assert_uint_eq(mmu_pop16(&gb.cpu), 0xABCD);
+    ck_assert_uint_eq(gb.cpu.sp, 0xFFFE);
+}
+END_TEST
+
+START_TEST(test_word_io_boundary) {
+    GameBoy gb = {0};
+    gb_init(&gb);
+
+    // HRAM / IE: the high byte goes through the IE register
+    mmu_write16(&gb, 0xFFFE, 0x1F42);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFFFE), 0x42);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFFFF), 0x1F);
+    ck_assert_uint_eq(mmu_read16(&gb, 0xFFFE), 0x1F42);
+
+    // IO / HRAM: the low byte goes through the IO handlers
+    mmu_write(&gb, 0xFF80, 0x99);
+    ck_assert_uint_eq(mmu_read16(&gb, 0xFF7F), MAKE_U16(0x99, mmu_read(&gb, 0xFF7F)));
+}
+END_TEST
+
+// ============================================================================
+// OAM DMA Tests
+// ============================================================================
+
+// The transfer takes 640 cycles, the CPU only reaches IO / HRAM meanwhile
+START_TEST(test_dma_busy_window) {
+    static GameBoy gb;
+    gb_init(&gb);
+
+    for (int i = 0; i < 0xA0; i++)
+        mmu_write(&gb, 0xC000 + i, (u8)(i ^ 0x5A));
+    mmu_write(&gb, 0xFF46, 0xC0);
+    ck_assert_uint_eq(gb_next_event(&gb), 640);
+
+    ck_assert_uint_eq(mmu_read(&gb, 0xC000), 0xFF);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFE00), 0xFF);
+    mmu_write(&gb, 0xC000, 0x00); // Ignored
+    mmu_write(&gb, 0xFF80, 0x42);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF80), 0x42);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF46), 0xC0);
+
+    gb.cycles = 639;
+    gb_run_events(&gb);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFE00), 0xFF);
+
+    gb.cycles = 640;
+    gb_run_events(&gb);
+    ck_assert_uint_eq(mmu_read(&gb, 0xC000), 0x5A);
+    for (int i = 0; i < 0xA0; i++)
+        ck_assert_uint_eq(mmu_read(&gb, 0xFE00 + i), (u8)(i ^ 0x5A));
+}
+END_TEST
+
+// The usual routine: start the transfer from HRAM and wait there
+START_TEST(test_dma_hram_routine) {
+    static const u8 caller[] = {
+        0x3E, 0xC1,       // LD A, 0xC1
+        0xCD, 0x80, 0xFF, // CALL 0xFF80
+        0xFA, 0x05, 0xFE, // LD A, (0xFE05)
+        0x76,             // HALT
+    };
+    static const u8 routine[] = {
+        0xE0, 0x46, // LDH (0x46), A
+        0x3E, 0x28, // LD A, 40
+        0x3D,       // loop: DEC A
+        0x20, 0xFD, // JR NZ, loop
+        0xC9,       // RET
+    };
+    static GameBoy gb;
+
+    for (CpuDispatch engine = CPU_DISPATCH_TABLE; engine <= CPU_DISPATCH_JIT; engine++) {
+        gb_init(&gb);
+        gb.cart.rom      = calloc(1, 0x8000);
+        gb.cart.rom_size = 0x8000;
+        gb.running       = true;
+        gb.cpu.dispatch  = engine;
+        memcpy(gb.cart.rom + 0x0100, caller, sizeof(caller));
+        for (u16 i = 0; i < sizeof(routine); i++)
+            mmu_write(&gb, 0xFF80 + i, routine[i]);
+        mmu_write(&gb, 0xC105, 0x77);
+
+        gb_run(&gb, 2000);
+        ck_assert_uint_eq(gb.cpu.regs.a, 0x77);
+        ck_assert(!gb.dma_active);
+
+        free(gb.cart.rom);
+        gb.cart.rom = NULL;
+    }
+}
+END_TEST
+
 // ============================================================================
 // Test Suite Setup
 // ============================================================================
 
 Suite *mmu_suite(void) {
     Suite *s;
-    TCase *tc_wram, *tc_hram, *tc_rom, *tc_special;
+    TCase *tc_wram, *tc_hram, *tc_rom, *tc_special, *tc_map, *tc_fetch, *tc_word, *tc_dma;
 
     s       = suite_create("MMU");
 
@@ -169,6 +444,32 @@ Suite *mmu_suite(void) {
     tcase_add_test(tc_special, test_ie_register);
     suite_add_tcase(s, tc_special);
 
+    // Page table
+    tc_map = tcase_create("Page Table");
+    tcase_add_test(tc_map, test_map_plain_pages);
+    tcase_add_test(tc_map, test_map_rom_pages);
+    tcase_add_test(tc_map, test_map_invalidate);
+    suite_add_tcase(s, tc_map);
+
+    // Instruction fetch
+    tc_fetch = tcase_create("Instruction Fetch");
+    tcase_add_test(tc_fetch, test_fetch_rom_window);
+    tcase_add_test(tc_fetch, test_fetch_ram_coherent);
+    suite_add_tcase(s, tc_fetch);
+
+    // 16-bit access
+    tc_word = tcase_create("16-bit Access");
+    tcase_add_test(tc_word, test_word_same_page);
+    tcase_add_test(tc_word, test_word_page_boundary);
+    tcase_add_test(tc_word, test_word_hram_stack);
+    tcase_add_test(tc_word, test_word_io_boundary);
+    suite_add_tcase(s, tc_word);
+
+    tc_dma = tcase_create("OAM DMA");
+    tcase_add_test(tc_dma, test_dma_busy_window);
+    tcase_add_test(tc_dma, test_dma_hram_routine);
+    suite_add_tcase(s, tc_dma);
+
     return s;
 }
 
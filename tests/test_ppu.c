@@ -0,0 +1,565 @@
+// tests/test_ppu.c
+#include <check.h>
+#include <gbemu.h>
+#include <core/bus.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ---------------------------------------------
+// Helpers
+// ---------------------------------------------
+
+// Move the emulator clock without the CPU, firing due events
+static void advance(GameBoy *gb, u64 time) {
+    gb->cycles = time;
+    gb_run_events(gb);
+}
+
+// Reference LY / STAT mode at `time` into the frame
+static u8 ref_ly(u64 time) {
+    return (u8)(time % PPU_FRAME_CYCLES / PPU_LINE_CYCLES);
+}
+
+// Every row of tile `tile` (cache index, 0x8000 + tile * 16) gets bit planes lo / hi
+static void fill_tile(GameBoy *gb, u16 tile, u8 lo, u8 hi) {
+    for (int row = 0; row < 8; row++) {
+        mmu_write(gb, 0x8000 + tile * 16 + row * 2, lo);
+        mmu_write(gb, 0x8000 + tile * 16 + row * 2 + 1, hi);
+    }
+}
+
+// Only row `row` of tile `tile` is color 3
+static void row_tile(GameBoy *gb, u16 tile, int row) {
+    mmu_write(gb, 0x8000 + tile * 16 + row * 2, 0xFF);
+    mmu_write(gb, 0x8000 + tile * 16 + row * 2 + 1, 0xFF);
+}
+
+static void set_sprite(GameBoy *gb, int index, u8 y, u8 x, u8 tile, u8 attr) {
+    mmu_write(gb, 0xFE00 + index * 4, y);
+    mmu_write(gb, 0xFE00 + index * 4 + 1, x);
+    mmu_write(gb, 0xFE00 + index * 4 + 2, tile);
+    mmu_write(gb, 0xFE00 + index * 4 + 3, attr);
+}
+
+// Bring the PPU (and the framebuffer) up to `time`
+static void render_to(GameBoy *gb, u64 time) {
+    gb->cycles = time;
+    ppu_sync(gb, time);
+}
+
+static u8 ref_mode(u64 time) {
+    u64 dot = time % PPU_LINE_CYCLES;
+
+    if (ref_ly(time) >= 144)
+        return 1;
+    if (dot < 80)
+        return 2;
+    return (dot < 80 + 172) ? 3 : 0;
+}
+
+// ============================================================================
+// Timing Tests
+// ============================================================================
+
+// LY and the STAT mode follow the cycle count, whatever the access pattern
+START_TEST(test_ly_stat_timing) {
+    static GameBoy gb;
+    gb_init(&gb);
+    srand(16);
+
+    for (int i = 0; i < 5000; i++) {
+        advance(&gb, gb.cycles + rand() % 600);
+        if (rand() % 2)
+            ck_assert_uint_eq(mmu_read(&gb, 0xFF44), ref_ly(gb.cycles));
+        else
+            ck_assert_uint_eq(mmu_read(&gb, 0xFF41) & 0x03, ref_mode(gb.cycles));
+    }
+}
+END_TEST
+
+// The LCD starts over at LY 0 when turned back on, and queues nothing while off
+START_TEST(test_lcd_off) {
+    static GameBoy gb;
+    gb_init(&gb);
+
+    advance(&gb, 1000);
+    mmu_write(&gb, 0xFF40, 0x11);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF44), 0);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF41) & 0x03, 0);
+    ck_assert_uint_eq(gb_next_event(&gb), EVENT_NEVER);
+
+    advance(&gb, 5000);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF44), 0);
+
+    mmu_write(&gb, 0xFF40, 0x91);
+    advance(&gb, 5000 + PPU_LINE_CYCLES * 3 + 100);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF44), 3);
+    ck_assert_uint_eq(gb_next_event(&gb), 5000 + PPU_LINE_CYCLES * 144);
+}
+END_TEST
+
+// ============================================================================
+// Interrupt Tests
+// ============================================================================
+
+// One VBlank interrupt per frame, at LY 144
+START_TEST(test_vblank_interrupt) {
+    static GameBoy gb;
+    gb_init(&gb);
+    gb.io.if_reg = 0xE0;
+
+    advance(&gb, PPU_LINE_CYCLES * 144 - 1);
+    ck_assert(!CHECK_BIT(gb.io.if_reg, INT_VBLANK));
+    advance(&gb, PPU_LINE_CYCLES * 144);
+    ck_assert(CHECK_BIT(gb.io.if_reg, INT_VBLANK));
+
+    gb.io.if_reg = 0xE0;
+    advance(&gb, PPU_FRAME_CYCLES + PPU_LINE_CYCLES * 144 - 1);
+    ck_assert(!CHECK_BIT(gb.io.if_reg, INT_VBLANK));
+    advance(&gb, PPU_FRAME_CYCLES + PPU_LINE_CYCLES * 144);
+    ck_assert(CHECK_BIT(gb.io.if_reg, INT_VBLANK));
+}
+END_TEST
+
+// LY == LYC raises INT_LCD once per match, on the rising edge of the STAT line
+START_TEST(test_stat_lyc_interrupt) {
+    static GameBoy gb;
+    gb_init(&gb);
+    gb.io.if_reg = 0xE0;
+
+    mmu_write(&gb, 0xFF45, 10);   // LYC
+    mmu_write(&gb, 0xFF41, 0x40); // LYC source
+    ck_assert(!CHECK_BIT(gb.io.if_reg, INT_LCD));
+
+    advance(&gb, PPU_LINE_CYCLES * 10 - 1);
+    ck_assert(!CHECK_BIT(gb.io.if_reg, INT_LCD));
+    advance(&gb, PPU_LINE_CYCLES * 10);
+    ck_assert(CHECK_BIT(gb.io.if_reg, INT_LCD));
+    ck_assert(CHECK_BIT(mmu_read(&gb, 0xFF41), 2));
+
+    // Still matching for the rest of the line: no second interrupt
+    gb.io.if_reg = 0xE0;
+    advance(&gb, PPU_LINE_CYCLES * 11 - 1);
+    ck_assert(!CHECK_BIT(gb.io.if_reg, INT_LCD));
+    advance(&gb, PPU_LINE_CYCLES * 11);
+    ck_assert(!CHECK_BIT(mmu_read(&gb, 0xFF41), 2));
+
+    // HBlank source: once per visible line
+    mmu_write(&gb, 0xFF41, 0x08);
+    advance(&gb, PPU_LINE_CYCLES * 12 + 252);
+    ck_assert(CHECK_BIT(gb.io.if_reg, INT_LCD));
+}
+END_TEST
+
+// ============================================================================
+// Tile Cache Tests
+// ============================================================================
+
+// Writes to tile data re-decode the row they touch: low plane is bit 0,
+// high plane bit 1, bit 7 the leftmost pixel
+START_TEST(test_tile_cache_decode) {
+    static GameBoy gb;
+    gb_init(&gb);
+
+    mmu_write(&gb, 0x8000 + 5 * 16 + 6, 0xF0); // Tile 5, row 3, low plane
+    mmu_write(&gb, 0x8000 + 5 * 16 + 7, 0x3C); // High plane
+    static const u8 row[8] = {1, 1, 3, 3, 2, 2, 0, 0};
+    ck_assert_mem_eq(&gb.ppu.tiles[5][3 * 8], row, 8);
+    ck_assert_uint_eq(gb.ppu.tiles[5][2 * 8], 0);
+    ck_assert_uint_eq(gb.ppu.tiles[5][4 * 8], 0);
+
+    // Last tile, through a 16-bit store
+    mmu_write16(&gb, 0x97FE, 0xFF80);
+    ck_assert_uint_eq(gb.ppu.tiles[383][56], 3);
+    ck_assert_uint_eq(gb.ppu.tiles[383][57], 2);
+    ck_assert_uint_eq(mmu_read(&gb, 0x97FF), 0xFF);
+}
+END_TEST
+
+// VRAM pages never take the fast write path (the PPU syncs first), reads do
+START_TEST(test_tile_cache_write_path) {
+    static GameBoy gb;
+    gb_init(&gb);
+
+    for (int i = 0; i < 4; i++)
+        mmu_write(&gb, 0x8010, (u8)(0x80 >> i));
+    ck_assert_ptr_null(gb.write_map[0x80]);
+    ck_assert_uint_eq(gb.ppu.tiles[1][3], 1); // Last write: 0x10
+    ck_assert_uint_eq(gb.ppu.tiles[1][0], 0);
+
+    mmu_write(&gb, 0x9800, 0x01);
+    ck_assert_ptr_null(gb.write_map[0x98]);
+    ck_assert_uint_eq(mmu_read(&gb, 0x9800), 0x01);
+    ck_assert_ptr_nonnull(gb.read_map[0x98]);
+}
+END_TEST
+
+// ============================================================================
+// Rendering Tests
+// ============================================================================
+
+// BG map, scrolling, palettes, both tile data areas. Writes count from the
+// line whose mode 3 ends after them
+START_TEST(test_render_background) {
+    static GameBoy gb;
+    gb_init(&gb);
+    gb.ppu.renderer = &ppu_renderer_scanline;
+
+    fill_tile(&gb, 1, 0xFF, 0xFF); // Color 3
+    fill_tile(&gb, 2, 0xFF, 0x00); // Color 1
+    mmu_write(&gb, 0x9800, 1);
+    mmu_write(&gb, 0x9801, 2);
+    mmu_write(&gb, 0xFF47, 0xE4);
+
+    render_to(&gb, PPU_FRAME_CYCLES);
+    ck_assert_uint_eq(gb.ppu.frames, 1);
+    ck_assert_uint_eq(gb.ppu.framebuffer[0][0], 3);
+    ck_assert_uint_eq(gb.ppu.framebuffer[7][7], 3);
+    ck_assert_uint_eq(gb.ppu.framebuffer[0][8], 1);
+    ck_assert_uint_eq(gb.ppu.framebuffer[0][16], 0);
+    ck_assert_uint_eq(gb.ppu.framebuffer[8][0], 0);
+
+    // SCX = 4 & an inverted palette from line 50 on, written during its mode 3
+    render_to(&gb, PPU_FRAME_CYCLES + 50 * PPU_LINE_CYCLES + 100);
+    mmu_write(&gb, 0xFF43, 4);
+    mmu_write(&gb, 0xFF42, 256 - 50); // SCY: line 50 shows map row 0
+    mmu_write(&gb, 0xFF47, 0x1B);
+    render_to(&gb, 2 * PPU_FRAME_CYCLES);
+    ck_assert_uint_eq(gb.ppu.framebuffer[0][0], 3);
+    ck_assert_uint_eq(gb.ppu.framebuffer[50][0], 0);
+    ck_assert_uint_eq(gb.ppu.framebuffer[50][3], 0);
+    ck_assert_uint_eq(gb.ppu.framebuffer[50][4], 2);
+    ck_assert_uint_eq(gb.ppu.framebuffer[50][12], 3);
+
+    // LCDC bit 4 clear: tile 1 is at 0x9010 (cache index 257)
+    fill_tile(&gb, 257, 0x00, 0xFF); // Color 2
+    mmu_write(&gb, 0xFF40, 0x81);
+    mmu_write(&gb, 0xFF47, 0xE4);
+    mmu_write(&gb, 0xFF42, 0);
+    mmu_write(&gb, 0xFF43, 0);
+    render_to(&gb, 3 * PPU_FRAME_CYCLES);
+    ck_assert_uint_eq(gb.ppu.framebuffer[0][0], 2);
+
+    // LCDC bit 0 clear: white
+    mmu_write(&gb, 0xFF40, 0x80);
+    render_to(&gb, 4 * PPU_FRAME_CYCLES);
+    ck_assert_uint_eq(gb.ppu.framebuffer[0][0], 0);
+}
+END_TEST
+
+// The window starts at LY == WY, X = WX - 7, and its line counter only
+// advances on lines that show it
+START_TEST(test_render_window) {
+    static GameBoy gb;
+    gb_init(&gb);
+
+    row_tile(&gb, 3, 0);
+    row_tile(&gb, 4, 2);
+    for (int i = 0; i < 32; i++) {
+        mmu_write(&gb, 0x9C00 + i, 3);      // Window map row 0
+        mmu_write(&gb, 0x9C00 + 32 + i, 4); // Row 1
+    }
+    mmu_write(&gb, 0xFF47, 0xE4);
+    mmu_write(&gb, 0xFF4A, 10);      // WY
+    mmu_write(&gb, 0xFF4B, 80 + 7);  // WX
+    mmu_write(&gb, 0xFF40, 0xF1);    // Window on, map 0x9C00
+
+    render_to(&gb, 20 * PPU_LINE_CYCLES);
+    mmu_write(&gb, 0xFF40, 0xD1);    // Window off for lines 20 - 29
+    render_to(&gb, 30 * PPU_LINE_CYCLES);
+    mmu_write(&gb, 0xFF40, 0xF1);
+    render_to(&gb, PPU_FRAME_CYCLES);
+
+    ck_assert_uint_eq(gb.ppu.framebuffer[9][80], 0);
+    ck_assert_uint_eq(gb.ppu.framebuffer[10][79], 0);
+    ck_assert_uint_eq(gb.ppu.framebuffer[10][80], 3);
+    ck_assert_uint_eq(gb.ppu.framebuffer[10][159], 3);
+    ck_assert_uint_eq(gb.ppu.framebuffer[11][80], 0);
+    ck_assert_uint_eq(gb.ppu.framebuffer[30][80], 3); // Window row 10, not 20
+    ck_assert_uint_eq(gb.ppu.framebuffer[31][80], 0);
+}
+END_TEST
+
+// X flip, priority between overlapping sprites, 10 per line, BG priority
+START_TEST(test_render_sprites) {
+    static GameBoy gb;
+    gb_init(&gb);
+
+    fill_tile(&gb, 1, 0xFF, 0xFF); // Color 3
+    fill_tile(&gb, 2, 0x80, 0x00); // Color 1 in the leftmost column
+    fill_tile(&gb, 3, 0xFF, 0x00); // Color 1
+    mmu_write(&gb, 0x9800 + 7 * 32, 3); // BG color 1 behind line 60, X 0 - 7
+    mmu_write(&gb, 0xFF47, 0xE4);
+    mmu_write(&gb, 0xFF48, 0xE4);
+    mmu_write(&gb, 0xFF49, 0x1B);
+    mmu_write(&gb, 0xFF40, 0x93);
+
+    set_sprite(&gb, 0, 16, 8, 2, 0x20);          // X flip: right column
+    set_sprite(&gb, 1, 20 + 16, 20 + 8, 1, 0x00); // X 20
+    set_sprite(&gb, 2, 20 + 16, 16 + 8, 3, 0x00); // X 16 wins the overlap
+    set_sprite(&gb, 3, 30 + 16, 40 + 8, 1, 0x00); // Same X: OAM order
+    set_sprite(&gb, 4, 30 + 16, 40 + 8, 3, 0x10);
+    for (int i = 0; i < 11; i++)
+        set_sprite(&gb, 5 + i, 50 + 16, (u8)(8 * i + 8), 1, 0x00);
+    set_sprite(&gb, 16, 60 + 16, 0 + 8, 1, 0x80);  // Behind BG color 1
+    set_sprite(&gb, 17, 60 + 16, 8 + 8, 1, 0x80);  // Over BG color 0
+    set_sprite(&gb, 18, 70 + 16, 0 + 8, 3, 0x10);  // OBP1
+
+    render_to(&gb, PPU_FRAME_CYCLES);
+    ck_assert_uint_eq(gb.ppu.framebuffer[0][0], 0);
+    ck_assert_uint_eq(gb.ppu.framebuffer[0][7], 1);
+
+    ck_assert_uint_eq(gb.ppu.framebuffer[20][16], 1);
+    ck_assert_uint_eq(gb.ppu.framebuffer[20][23], 1);
+    ck_assert_uint_eq(gb.ppu.framebuffer[20][24], 3);
+    ck_assert_uint_eq(gb.ppu.framebuffer[30][40], 3);
+
+    ck_assert_uint_eq(gb.ppu.framebuffer[50][0], 3);
+    ck_assert_uint_eq(gb.ppu.framebuffer[50][79], 3);
+    ck_assert_uint_eq(gb.ppu.framebuffer[50][80], 0); // 11th sprite
+
+    ck_assert_uint_eq(gb.ppu.framebuffer[60][0], 1);
+    ck_assert_uint_eq(gb.ppu.framebuffer[60][8], 3);
+    ck_assert_uint_eq(gb.ppu.framebuffer[70][0], 2);
+
+    // OBJ off
+    mmu_write(&gb, 0xFF40, 0x91);
+    render_to(&gb, 2 * PPU_FRAME_CYCLES);
+    ck_assert_uint_eq(gb.ppu.framebuffer[20][24], 0);
+}
+END_TEST
+
+// 8x16: the tile number's low bit is ignored, Y flip swaps the halves
+START_TEST(test_render_tall_sprites) {
+    static GameBoy gb;
+    gb_init(&gb);
+
+    fill_tile(&gb, 4, 0xFF, 0x00); // Color 1
+    fill_tile(&gb, 5, 0xFF, 0xFF); // Color 3
+    mmu_write(&gb, 0xFF48, 0xE4);
+    mmu_write(&gb, 0xFF40, 0x97);
+    set_sprite(&gb, 0, 40 + 16, 8, 5, 0x00);
+    set_sprite(&gb, 1, 40 + 16, 16, 4, 0x40);
+
+    render_to(&gb, PPU_FRAME_CYCLES);
+    ck_assert_uint_eq(gb.ppu.framebuffer[40][0], 1);
+    ck_assert_uint_eq(gb.ppu.framebuffer[48][0], 3);
+    ck_assert_uint_eq(gb.ppu.framebuffer[55][0], 3);
+    ck_assert_uint_eq(gb.ppu.framebuffer[56][0], 0);
+    ck_assert_uint_eq(gb.ppu.framebuffer[40][8], 3);
+    ck_assert_uint_eq(gb.ppu.framebuffer[48][8], 1);
+}
+END_TEST
+
+// ============================================================================
+// Pixel FIFO Tests
+// ============================================================================
+
+// BG with fine scroll, a window, overlapping / clipped / flipped sprites,
+// BG priority and an 11th sprite on one line
+static void build_scene(GameBoy *gb) {
+    gb_init(gb);
+
+    for (u16 tile = 0; tile < 8; tile++)
+        fill_tile(gb, tile, (u8)(0x35 * tile), (u8)(0x5C ^ (tile * 0x21)));
+    for (int i = 0; i < 0x800; i++)
+        mmu_write(gb, 0x9800 + i, (u8)((i * 7 + i / 32) % 8));
+
+    mmu_write(gb, 0xFF42, 3);
+    mmu_write(gb, 0xFF43, 13);
+    mmu_write(gb, 0xFF47, 0xE4);
+    mmu_write(gb, 0xFF48, 0xD2);
+    mmu_write(gb, 0xFF49, 0x1B);
+    mmu_write(gb, 0xFF4A, 40);
+    mmu_write(gb, 0xFF4B, 100 + 7);
+    mmu_write(gb, 0xFF40, 0xF3); // BG, OBJ, window on map 0x9C00
+
+    set_sprite(gb, 0, 16, 3, 1, 0x00);        // Clipped on the left
+    set_sprite(gb, 1, 16, 5, 2, 0x30);        // Under sprite 0 on the left edge
+    set_sprite(gb, 2, 20 + 16, 30, 3, 0x20);  // Overlap, smaller X wins
+    set_sprite(gb, 3, 24 + 16, 34, 4, 0x40);
+    set_sprite(gb, 4, 30 + 16, 60, 5, 0x80);  // Behind BG colors 1-3
+    set_sprite(gb, 5, 50 + 16, 104, 6, 0x10); // Over the window
+    set_sprite(gb, 6, 60 + 16, 165, 7, 0x00); // Clipped on the right
+    for (int i = 0; i < 11; i++)
+        set_sprite(gb, 7 + i, 80 + 16, (u8)(9 + i * 13), (u8)i, (u8)(i << 4));
+}
+
+// Without mode 3 writes both renderers draw the same frame
+START_TEST(test_fifo_matches_scanline) {
+    static GameBoy scanline;
+    static GameBoy fifo;
+
+    build_scene(&scanline);
+    build_scene(&fifo);
+    scanline.ppu.renderer = &ppu_renderer_scanline;
+    fifo.ppu.renderer     = &ppu_renderer_fifo;
+
+    render_to(&scanline, PPU_FRAME_CYCLES);
+    render_to(&fifo, PPU_FRAME_CYCLES);
+    for (int y = 0; y < PPU_HEIGHT; y++) {
+        for (int x = 0; x < PPU_WIDTH; x++)
+            ck_assert_msg(fifo.ppu.framebuffer[y][x] == scanline.ppu.framebuffer[y][x],
+                          "pixel (%d, %d): fifo %u, scanline %u", x, y,
+                          fifo.ppu.framebuffer[y][x], scanline.ppu.framebuffer[y][x]);
+    }
+    ck_assert_uint_eq(fifo.ppu.frames, 1);
+}
+END_TEST
+
+// A BGP write halfway through mode 3 only recolors the rest of the line.
+// Only mode 3 writes are logged, auto switches to the FIFO for that line
+START_TEST(test_fifo_mid_line_write) {
+    static GameBoy gb;
+    const PpuRenderer *renderers[] = {&ppu_renderer_fifo, &ppu_renderer_auto,
+                                      &ppu_renderer_scanline};
+
+    for (int r = 0; r < 3; r++) {
+        gb_init(&gb);
+        gb.ppu.renderer = renderers[r];
+        fill_tile(&gb, 0, 0xFF, 0xFF); // Color 3 everywhere
+        mmu_write(&gb, 0xFF47, 0xE4);
+
+        render_to(&gb, 10 * PPU_LINE_CYCLES + 20); // Mode 2: not logged
+        mmu_write(&gb, 0xFF47, 0xE4);
+        ck_assert_uint_eq(gb.ppu.log_count, 0);
+
+        render_to(&gb, 10 * PPU_LINE_CYCLES + PPU_OAM_CYCLES + 80);
+        mmu_write(&gb, 0xFF47, 0x00);
+        ck_assert_uint_eq(gb.ppu.log_count, 1);
+        ck_assert_uint_eq(gb.ppu.log_line, 10);
+        ck_assert_uint_eq(gb.ppu.log[0].dot, PPU_OAM_CYCLES + 80);
+        ck_assert_uint_eq(gb.ppu.log_regs.bgp, 0xE4);
+
+        render_to(&gb, PPU_FRAME_CYCLES);
+        ck_assert_uint_eq(gb.ppu.log_count, 0);
+        ck_assert_uint_eq(gb.ppu.framebuffer[9][159], 3);
+        ck_assert_uint_eq(gb.ppu.framebuffer[11][0], 0);
+        ck_assert_uint_eq(gb.ppu.framebuffer[10][159], 0);
+        if (renderers[r] == &ppu_renderer_scanline) {
+            ck_assert_uint_eq(gb.ppu.framebuffer[10][0], 0); // Whole line
+        } else {
+            ck_assert_uint_eq(gb.ppu.framebuffer[10][0], 3);
+            ck_assert_uint_eq(gb.ppu.framebuffer[10][60], 3);
+            ck_assert_uint_eq(gb.ppu.framebuffer[10][80], 0);
+        }
+    }
+}
+END_TEST
+
+// A mid-line SCX write moves the tiles fetched after it
+START_TEST(test_fifo_mid_line_scroll) {
+    static GameBoy gb;
+    gb_init(&gb);
+
+    fill_tile(&gb, 1, 0xFF, 0xFF);
+    for (int i = 0; i < 32; i += 2)
+        mmu_write(&gb, 0x9800 + i, 1); // Alternating 8 pixel stripes
+    mmu_write(&gb, 0xFF47, 0xE4);
+
+    render_to(&gb, PPU_OAM_CYCLES + 80);
+    mmu_write(&gb, 0xFF43, 8); // One tile: the stripes swap
+    render_to(&gb, PPU_FRAME_CYCLES);
+
+    ck_assert_uint_eq(gb.ppu.framebuffer[0][0], 3);   // Tile 0, before the write
+    ck_assert_uint_eq(gb.ppu.framebuffer[0][8], 0);
+    ck_assert_uint_eq(gb.ppu.framebuffer[0][152], 3); // Tile 20, after it
+    ck_assert_uint_eq(gb.ppu.framebuffer[1][0], 0);   // Tile 1 from the start
+    ck_assert_uint_eq(gb.ppu.framebuffer[1][152], 3);
+}
+END_TEST
+
+// Mode 3 grows with SCX & 7 and with each sprite fetched
+START_TEST(test_fifo_draw_cycles) {
+    static GameBoy gb;
+    gb_init(&gb);
+    mmu_write(&gb, 0xFF40, 0x93);
+
+    ppu_fifo_render_line(&gb, 0);
+    ck_assert_uint_eq(gb.ppu.draw_cycles, PPU_DRAW_CYCLES);
+
+    mmu_write(&gb, 0xFF43, 5);
+    ppu_fifo_render_line(&gb, 0);
+    ck_assert_uint_eq(gb.ppu.draw_cycles, PPU_DRAW_CYCLES + 5);
+
+    mmu_write(&gb, 0xFF43, 0);
+    set_sprite(&gb, 0, 16, 50, 0, 0x00);
+    ppu_fifo_render_line(&gb, 0);
+    u16 one = gb.ppu.draw_cycles;
+    ck_assert_uint_ge(one, PPU_DRAW_CYCLES + 6);
+    ck_assert_uint_le(one, PPU_DRAW_CYCLES + 11);
+
+    mmu_write(&gb, 0xFF40, 0x91); // OBJ off: no fetch
+    ppu_fifo_render_line(&gb, 0);
+    ck_assert_uint_eq(gb.ppu.draw_cycles, PPU_DRAW_CYCLES);
+}
+END_TEST
+
+START_TEST(test_renderer_find) {
+    ck_assert_ptr_eq(ppu_renderer_find("scanline"), &ppu_renderer_scanline);
+    ck_assert_ptr_eq(ppu_renderer_find("fifo"), &ppu_renderer_fifo);
+    ck_assert_ptr_eq(ppu_renderer_find("auto"), &ppu_renderer_auto);
+    ck_assert_ptr_null(ppu_renderer_find("dots"));
+}
+END_TEST
+
+// ============================================================================
+// Test Suite Setup
+// ============================================================================
+Suite *ppu_suite(void) {
+    Suite *s;
+    TCase *tc_timing;
+    TCase *tc_interrupts;
+    TCase *tc_tiles;
+    TCase *tc_render;
+    TCase *tc_fifo;
+
+    s         = suite_create("PPU");
+
+    tc_timing = tcase_create("Timing");
+    tcase_add_test(tc_timing, test_ly_stat_timing);
+    tcase_add_test(tc_timing, test_lcd_off);
+    suite_add_tcase(s, tc_timing);
+
+    tc_interrupts = tcase_create("Interrupts");
+    tcase_add_test(tc_interrupts, test_vblank_interrupt);
+    tcase_add_test(tc_interrupts, test_stat_lyc_interrupt);
+    suite_add_tcase(s, tc_interrupts);
+
+    tc_tiles = tcase_create("Tile Cache");
+    tcase_add_test(tc_tiles, test_tile_cache_decode);
+    tcase_add_test(tc_tiles, test_tile_cache_write_path);
+    suite_add_tcase(s, tc_tiles);
+
+    tc_render = tcase_create("Rendering");
+    tcase_add_test(tc_render, test_render_background);
+    tcase_add_test(tc_render, test_render_window);
+    tcase_add_test(tc_render, test_render_sprites);
+    tcase_add_test(tc_render, test_render_tall_sprites);
+    suite_add_tcase(s, tc_render);
+
+    tc_fifo = tcase_create("Pixel FIFO");
+    tcase_add_test(tc_fifo, test_fifo_matches_scanline);
+    tcase_add_test(tc_fifo, test_fifo_mid_line_write);
+    tcase_add_test(tc_fifo, test_fifo_mid_line_scroll);
+    tcase_add_test(tc_fifo, test_fifo_draw_cycles);
+    tcase_add_test(tc_fifo, test_renderer_find);
+    suite_add_tcase(s, tc_fifo);
+
+    return s;
+}
+
+int main(void) {
+    int      number_failed;
+    Suite   *s;
+    SRunner *sr;
+
+    s  = ppu_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_NORMAL);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (number_failed == 0) ? 0 : 1;
+}
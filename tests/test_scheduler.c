@@ -0,0 +1,380 @@
+// tests/test_scheduler.c
+#include <check.h>
+#include <gbemu.h>
+#include <core/bus.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ---------------------------------------------
+// Helpers
+// ---------------------------------------------
+
+// Events fired so far: type, deadline and clock when the handler ran
+typedef struct {
+    EventType type;
+    u64       when;
+    u64       now;
+} FiredEvent;
+
+static FiredEvent fired[64];
+static int        fired_count;
+
+static void record_event(GameBoy *gb, EventType type, u64 when) {
+    if (fired_count < 64)
+        fired[fired_count++] = (FiredEvent){type, when, gb->cycles};
+}
+
+static void on_serial(GameBoy *gb, u64 when) {
+    record_event(gb, EVENT_SERIAL, when);
+}
+static void on_timer(GameBoy *gb, u64 when) {
+    record_event(gb, EVENT_TIMER, when);
+}
+static void on_ppu(GameBoy *gb, u64 when) {
+    record_event(gb, EVENT_PPU, when);
+}
+static void on_dma(GameBoy *gb, u64 when) {
+    record_event(gb, EVENT_DMA, when);
+}
+static void on_save(GameBoy *gb, u64 when) {
+    record_event(gb, EVENT_SAVE, when);
+}
+
+// GameBoy running a ROM full of NOPs (4 cycles each), with logging handlers
+static void setup_nops(GameBoy *gb) {
+    gb_init(gb);
+    gb->cart.rom      = calloc(1, 0x8000);
+    gb->cart.rom_size = 0x8000;
+    gb->running       = true;
+
+    gb_set_event_handler(gb, EVENT_SERIAL, on_serial);
+    gb_set_event_handler(gb, EVENT_TIMER, on_timer);
+    gb_set_event_handler(gb, EVENT_PPU, on_ppu);
+    gb_set_event_handler(gb, EVENT_DMA, on_dma);
+    gb_set_event_handler(gb, EVENT_SAVE, on_save);
+    fired_count = 0;
+}
+
+static void teardown_nops(GameBoy *gb) {
+    free(gb->cart.rom);
+    gb->cart.rom = NULL;
+}
+
+// ============================================================================
+// Scheduler Tests
+// ============================================================================
+
+// Events fire in deadline order, exactly on time, after reschedules and cancels
+START_TEST(test_events_in_order) {
+    static GameBoy gb;
+    setup_nops(&gb);
+
+    gb_schedule_event(&gb, EVENT_TIMER, 100);
+    gb_schedule_event(&gb, EVENT_PPU, 52);
+    gb_schedule_event(&gb, EVENT_DMA, 76);
+    gb_schedule_event(&gb, EVENT_SERIAL, 60);
+    ck_assert_uint_eq(gb_next_event(&gb), 52);
+
+    gb_schedule_event(&gb, EVENT_PPU, 200); // Moved later
+    gb_cancel_event(&gb, EVENT_DMA);
+    ck_assert_uint_eq(gb_next_event(&gb), 60);
+
+    gb_run(&gb, 300);
+
+    ck_assert_int_eq(fired_count, 3);
+    ck_assert_int_eq(fired[0].type, EVENT_SERIAL);
+    ck_assert_int_eq(fired[1].type, EVENT_TIMER);
+    ck_assert_int_eq(fired[2].type, EVENT_PPU);
+    for (int i = 0; i < fired_count; i++)
+        ck_assert_uint_eq(fired[i].now, fired[i].when); // The CPU stopped at the deadline
+
+    ck_assert_uint_eq(gb_next_event(&gb), EVENT_NEVER);
+    ck_assert_uint_ge(gb.cycles, 300);
+    teardown_nops(&gb);
+}
+END_TEST
+
+// Events due on the same cycle fire in EventType order
+START_TEST(test_events_same_cycle) {
+    static GameBoy gb;
+    setup_nops(&gb);
+
+    gb_schedule_event(&gb, EVENT_DMA, 40);
+    gb_schedule_event(&gb, EVENT_PPU, 40);
+    gb_schedule_event(&gb, EVENT_SERIAL, 40);
+    gb_schedule_event(&gb, EVENT_TIMER, 40);
+    gb_run(&gb, 40);
+
+    ck_assert_int_eq(fired_count, 4);
+    for (int i = 0; i < 4; i++)
+        ck_assert_int_eq(fired[i].type, (EventType)i);
+    teardown_nops(&gb);
+}
+END_TEST
+
+// Random schedule/cancel sequences against a linear scan
+START_TEST(test_events_match_reference) {
+    static GameBoy gb;
+    u64            deadline[EVENT_COUNT];
+
+    setup_nops(&gb);
+    for (int i = 0; i < EVENT_COUNT; i++)
+        deadline[i] = EVENT_NEVER;
+
+    srand(0xE7E7);
+    for (int step = 0; step < 10000; step++) {
+        EventType type = rand() % EVENT_COUNT;
+        if (rand() % 4 == 0) {
+            gb_cancel_event(&gb, type);
+            deadline[type] = EVENT_NEVER;
+        } else {
+            u64 when = gb.cycles + rand() % 1000;
+            gb_schedule_event(&gb, type, when);
+            deadline[type] = when;
+        }
+
+        // Move the clock without the CPU and fire what is due
+        gb.cycles   += rand() % 200;
+        fired_count  = 0;
+        gb_run_events(&gb);
+        for (int i = 0; i < fired_count; i++) {
+            ck_assert_uint_eq(fired[i].when, deadline[fired[i].type]);
+            deadline[fired[i].type] = EVENT_NEVER;
+        }
+
+        u64 earliest = EVENT_NEVER;
+        for (int i = 0; i < EVENT_COUNT; i++) {
+            ck_assert(deadline[i] == EVENT_NEVER || deadline[i] > gb.cycles);
+            if (deadline[i] < earliest)
+                earliest = deadline[i];
+        }
+        ck_assert_uint_eq(gb_next_event(&gb), earliest);
+    }
+    teardown_nops(&gb);
+}
+END_TEST
+
+// ============================================================================
+// Serial Tests
+// ============================================================================
+
+// An internal-clock transfer completes 4096 cycles later
+START_TEST(test_serial_transfer) {
+    static GameBoy gb;
+    gb_init(&gb);
+    gb.cart.rom      = calloc(1, 0x8000);
+    gb.cart.rom_size = 0x8000;
+    gb.running       = true;
+    gb.io.if_reg     = 0xE0;
+
+    mmu_write(&gb, 0xFF01, 'A');
+    mmu_write(&gb, 0xFF02, 0x81);
+    ck_assert_uint_eq(gb_next_event(&gb), 4096);
+
+    gb_run(&gb, 4092);
+    ck_assert(CHECK_BIT(gb.io.sc, 7));
+
+    gb_run(&gb, 4);
+    ck_assert(!CHECK_BIT(gb.io.sc, 7));
+    ck_assert(CHECK_BIT(gb.io.if_reg, 3));
+
+    free(gb.cart.rom);
+}
+END_TEST
+
+// A transfer started by running code is timed from the store instruction,
+// also from inside cached / translated blocks
+START_TEST(test_serial_from_cpu) {
+    static const u8 code[] = {
+        0x3E, 0x81, // LD A, 0x81          (8 cycles)
+        0x06, 0x14, // LD B, 20            (8 cycles)
+        0xE0, 0x02, // loop: LDH (0x02), A (12 cycles)
+        0x05,       // DEC B               (4 cycles)
+        0x20, 0xFB, // JR NZ, loop         (12 / 8 cycles)
+        0x76,       // HALT
+    };
+    static GameBoy gb;
+
+    for (CpuDispatch engine = CPU_DISPATCH_TABLE; engine <= CPU_DISPATCH_JIT; engine++) {
+        setup_nops(&gb);
+        memcpy(gb.cart.rom + 0x0100, code, sizeof(code));
+        gb.cpu.dispatch = engine;
+
+        // The last store starts 16 + 19 * 28 cycles in
+        gb_run(&gb, 1000);
+        ck_assert_uint_eq(gb_next_event(&gb), 16 + 19 * 28 + 4096);
+        teardown_nops(&gb);
+    }
+}
+END_TEST
+
+// ============================================================================
+// HALT / STOP Tests
+// ============================================================================
+
+// HALT until the serial transfer completes, then acknowledge it and HALT again
+static const u8 halt_code[] = {
+    0x3E, 0x81, // LD A, 0x81
+    0xE0, 0x02, // LDH (0x02), A (starts the transfer)
+    0x76,       // HALT
+    0x04,       // INC B
+    0x3E, 0xE0, // LD A, 0xE0
+    0xE0, 0x0F, // LDH (0x0F), A (clears IF)
+    0x76,       // HALT
+};
+
+static void setup_halt(GameBoy *gb, u8 ie) {
+    setup_nops(gb);
+    memcpy(gb->cart.rom + 0x0100, halt_code, sizeof(halt_code));
+    gb_set_event_handler(gb, EVENT_SERIAL, io_serial_complete);
+    gb->ie_register = ie;
+    gb->io.if_reg   = 0xE0;
+}
+
+// Skipping to the wake-up event takes exactly as many cycles as stepping
+START_TEST(test_halt_matches_spinning) {
+    static GameBoy fast;
+    static GameBoy slow;
+
+    for (CpuDispatch engine = CPU_DISPATCH_TABLE; engine <= CPU_DISPATCH_JIT; engine++) {
+        int calls = 0;
+
+        setup_halt(&fast, 0x08);
+        setup_halt(&slow, 0x08);
+        fast.cpu.dispatch = engine;
+
+        // Reference: one 4-cycle step at a time through the halt
+        while (slow.cpu.pc != 0x010B) {
+            slow.cycles += cpu_step(&slow.cpu);
+            gb_run_events(&slow);
+        }
+
+        while (fast.cpu.pc != 0x010B) {
+            cpu_run(&fast.cpu, 100000);
+            gb_run_events(&fast);
+            calls++;
+        }
+
+        ck_assert(fast.cpu.halted);
+        ck_assert_uint_eq(fast.cpu.regs.b, 0x01);
+        ck_assert_uint_eq(fast.cycles, slow.cycles);
+        ck_assert_uint_eq(fast.cycles, 8 + 4096 + 28);
+        ck_assert_int_le(calls, 5); // Not one per 4-cycle step
+        teardown_nops(&fast);
+        teardown_nops(&slow);
+    }
+}
+END_TEST
+
+// gb_run() sleeps through to the deadline in one cpu_run() call
+START_TEST(test_halt_skips_to_event) {
+    static GameBoy gb;
+    setup_halt(&gb, 0x08);
+
+    gb_run(&gb, 4);  // LD A, 0x81
+    gb_run(&gb, 16); // LDH (0x02), A; HALT
+    ck_assert(gb.cpu.halted);
+    ck_assert_uint_eq(gb.cycles, 24);
+
+    // Idle up to the serial event at 8 + 4096, wake up on the next call
+    ck_assert_uint_eq(cpu_run(&gb.cpu, 100000), 4096 - 16);
+    ck_assert(gb.cpu.halted);
+    gb_run_events(&gb);
+    gb_run(&gb, 4);
+    ck_assert(!gb.cpu.halted);
+    ck_assert_uint_eq(gb.cpu.regs.b, 0x01);
+
+    // Nothing left to wake up for: the rest of the frame is a single call
+    gb_run(&gb, 70224);
+    ck_assert(gb.cpu.halted);
+    ck_assert_uint_eq(gb.cpu.pc, 0x010B);
+
+    teardown_nops(&gb);
+}
+END_TEST
+
+// A request that is not enabled in IE keeps the CPU halted
+START_TEST(test_halt_masked_interrupt) {
+    static GameBoy gb;
+    setup_halt(&gb, 0x01);
+
+    gb_run(&gb, 70224);
+    ck_assert(CHECK_BIT(gb.io.if_reg, 3));
+    ck_assert(gb.cpu.halted);
+    ck_assert_uint_eq(gb.cpu.pc, 0x0105);
+    ck_assert_uint_eq(gb.cycles, 70224);
+
+    teardown_nops(&gb);
+}
+END_TEST
+
+// STOP sleeps through the serial interrupt until a joypad request
+START_TEST(test_stop_until_joypad) {
+    static const u8 code[] = {0x10, 0x00, 0x3C, 0x76}; // STOP; INC A; HALT
+    static GameBoy  gb;
+
+    setup_nops(&gb);
+    memcpy(gb.cart.rom + 0x0100, code, sizeof(code));
+    gb.ie_register = 0x1F;
+    gb.io.if_reg   = 0xE8;
+
+    gb_run(&gb, 10000);
+    ck_assert(gb.cpu.stopped);
+    ck_assert_uint_eq(gb.cpu.pc, 0x0102);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF04), 10000 >> 8); // Counting from the STOP
+
+    gb_request_interrupt(&gb, INT_JOYPAD);
+    gb_run(&gb, 8);
+    ck_assert(!gb.cpu.stopped);
+    ck_assert_uint_eq(gb.cpu.regs.a, 0x02);
+
+    teardown_nops(&gb);
+}
+END_TEST
+
+// ============================================================================
+// Test Suite Setup
+// ============================================================================
+Suite *scheduler_suite(void) {
+    Suite *s;
+    TCase *tc_events;
+    TCase *tc_serial;
+    TCase *tc_sleep;
+
+    s         = suite_create("Scheduler");
+
+    tc_events = tcase_create("Events");
+    tcase_add_test(tc_events, test_events_in_order);
+    tcase_add_test(tc_events, test_events_same_cycle);
+    tcase_add_test(tc_events, test_events_match_reference);
+    suite_add_tcase(s, tc_events);
+
+    tc_serial = tcase_create("Serial");
+    tcase_add_test(tc_serial, test_serial_transfer);
+    tcase_add_test(tc_serial, test_serial_from_cpu);
+    suite_add_tcase(s, tc_serial);
+
+    tc_sleep = tcase_create("Sleep");
+    tcase_add_test(tc_sleep, test_halt_matches_spinning);
+    tcase_add_test(tc_sleep, test_halt_skips_to_event);
+    tcase_add_test(tc_sleep, test_halt_masked_interrupt);
+    tcase_add_test(tc_sleep, test_stop_until_joypad);
+    suite_add_tcase(s, tc_sleep);
+
+    return s;
+}
+
+int main(void) {
+    int      number_failed;
+    Suite   *s;
+    SRunner *sr;
+
+    s  = scheduler_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_NORMAL);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (number_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,242 @@
+// tests/test_timer.c
+#include <check.h>
+#include <gbemu.h>
+#include <core/bus.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ---------------------------------------------
+// Helpers
+// ---------------------------------------------
+
+// Reference timer: the system counter stepped one cycle at a time
+typedef struct {
+    u64  time;
+    u16  counter;
+    u8   tima, tma, tac;
+    u64  reload; // Time of the pending TMA reload, 0 = none
+    bool irq;
+} RefTimer;
+
+static bool ref_signal(const RefTimer *ref, u16 counter) {
+    static const u8 bits[4] = {9, 3, 5, 7};
+    return (ref->tac & 0x04) && CHECK_BIT(counter, bits[ref->tac & 0x03]);
+}
+
+static void ref_increment(RefTimer *ref) {
+    if (ref->tima == 0xFF) {
+        ref->tima   = 0x00;
+        ref->reload = ref->time + 4;
+    } else {
+        ref->tima++;
+    }
+}
+
+static void ref_advance(RefTimer *ref, u64 time) {
+    while (ref->time < time) {
+        u16 before = ref->counter++;
+        ref->time++;
+
+        if (ref->reload == ref->time) {
+            ref->tima   = ref->tma;
+            ref->reload = 0;
+            ref->irq    = true;
+        }
+        if (ref_signal(ref, before) && !ref_signal(ref, ref->counter))
+            ref_increment(ref);
+    }
+}
+
+static void ref_write(RefTimer *ref, u16 addr, u8 value) {
+    bool before = ref_signal(ref, ref->counter);
+
+    switch (addr) {
+        case 0xFF04:
+            ref->counter = 0;
+            break;
+        case 0xFF05:
+            ref->tima   = value;
+            ref->reload = 0;
+            return;
+        case 0xFF06:
+            ref->tma = value;
+            return;
+        default:
+            ref->tac = value & 0x07;
+            break;
+    }
+    if (before && !ref_signal(ref, ref->counter))
+        ref_increment(ref);
+}
+
+// Move the emulator clock without the CPU, firing due events
+static void advance(GameBoy *gb, u64 time) {
+    gb->cycles = time;
+    gb_run_events(gb);
+}
+
+// ============================================================================
+// Divider Tests
+// ============================================================================
+
+// DIV counts up from its boot value at 16384 Hz, writes reset it
+START_TEST(test_div) {
+    static GameBoy gb;
+    gb_init(&gb);
+
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF04), 0xAB);
+    advance(&gb, 0x34); // System counter 0xAC00
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF04), 0xAC);
+    advance(&gb, 0x34 + 256 * 10);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF04), 0xB6);
+
+    mmu_write(&gb, 0xFF04, 0x55);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF04), 0x00);
+    advance(&gb, gb.cycles + 255);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF04), 0x00);
+    advance(&gb, gb.cycles + 1);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF04), 0x01);
+}
+END_TEST
+
+// ============================================================================
+// TIMA Tests
+// ============================================================================
+
+// A stopped timer queues nothing, a running one only its overflow
+START_TEST(test_tima_overflow_event) {
+    static GameBoy gb;
+    gb_init(&gb);
+    mmu_write(&gb, 0xFF40, 0x00); // LCD off: no PPU events
+    mmu_write(&gb, 0xFF04, 0x00);
+    ck_assert_uint_eq(gb_next_event(&gb), EVENT_NEVER);
+
+    mmu_write(&gb, 0xFF06, 0xF0); // TMA
+    mmu_write(&gb, 0xFF05, 0xFE); // TIMA
+    mmu_write(&gb, 0xFF07, 0x05); // Enabled, 16 cycles
+    ck_assert_uint_eq(gb_next_event(&gb), 32 + 4);
+
+    advance(&gb, 32);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF05), 0x00); // Overflowed, reload pending
+    ck_assert(!CHECK_BIT(gb.io.if_reg, INT_TIMER));
+
+    advance(&gb, 36);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF05), 0xF0);
+    ck_assert(CHECK_BIT(gb.io.if_reg, INT_TIMER));
+    ck_assert_uint_eq(gb_next_event(&gb), 32 + 16 * 16 + 4);
+
+    mmu_write(&gb, 0xFF07, 0x00);
+    ck_assert_uint_eq(gb_next_event(&gb), EVENT_NEVER);
+}
+END_TEST
+
+// Random register accesses against the cycle-stepped reference
+START_TEST(test_tima_match_reference) {
+    static const u16 regs[] = {0xFF04, 0xFF05, 0xFF06, 0xFF07};
+    static GameBoy   gb;
+    RefTimer         ref = {.counter = 0xABCC};
+
+    gb_init(&gb);
+    gb.io.if_reg = 0x00;
+
+    srand(0x71A);
+    for (int step = 0; step < 20000; step++) {
+        u64 time = gb.cycles + rand() % 300;
+        advance(&gb, time);
+        ref_advance(&ref, time);
+
+        // IF is raised on time, with or without register reads
+        ck_assert_int_eq(CHECK_BIT(gb.io.if_reg, INT_TIMER), ref.irq);
+        gb.io.if_reg = 0x00;
+        ref.irq      = false;
+
+        if (rand() % 2) {
+            u16 addr  = regs[rand() % 4];
+            u8  value = (rand() % 2) ? 0xFE + rand() % 2 : (u8)rand();
+            mmu_write(&gb, addr, value);
+            ref_write(&ref, addr, value);
+        }
+
+        ck_assert_uint_eq(mmu_read(&gb, 0xFF04), ref.counter >> 8);
+        ck_assert_uint_eq(mmu_read(&gb, 0xFF05), ref.tima);
+        ck_assert_uint_eq(mmu_read(&gb, 0xFF07), ref.tac | 0xF8);
+    }
+}
+END_TEST
+
+// A TIMA write during the reload delay cancels the reload and interrupt
+START_TEST(test_tima_write_cancels_reload) {
+    static GameBoy gb;
+    gb_init(&gb);
+    gb.io.if_reg = 0x00;
+
+    mmu_write(&gb, 0xFF04, 0x00);
+    mmu_write(&gb, 0xFF06, 0x80);
+    mmu_write(&gb, 0xFF05, 0xFF);
+    mmu_write(&gb, 0xFF07, 0x05);
+
+    advance(&gb, 18); // Overflow at 16
+    mmu_write(&gb, 0xFF05, 0x42);
+    advance(&gb, 100);
+    ck_assert(!CHECK_BIT(gb.io.if_reg, INT_TIMER));
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF05), 0x42 + 100 / 16 - 1);
+}
+END_TEST
+
+// TAC / DIV writes that drop the selected bit count as an edge
+START_TEST(test_tima_glitches) {
+    static GameBoy gb;
+    gb_init(&gb);
+
+    mmu_write(&gb, 0xFF04, 0x00);
+    mmu_write(&gb, 0xFF05, 0x00);
+    mmu_write(&gb, 0xFF07, 0x04); // Enabled, bit 9
+
+    advance(&gb, 0x200); // Bit 9 set
+    mmu_write(&gb, 0xFF07, 0x00);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF05), 0x01);
+
+    mmu_write(&gb, 0xFF07, 0x04);
+    mmu_write(&gb, 0xFF04, 0x00);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF05), 0x02);
+}
+END_TEST
+
+// ============================================================================
+// Test Suite Setup
+// ============================================================================
+Suite *timer_suite(void) {
+    Suite *s;
+    TCase *tc_div;
+    TCase *tc_tima;
+
+    s      = suite_create("Timer");
+
+    tc_div = tcase_create("DIV");
+    tcase_add_test(tc_div, test_div);
+    suite_add_tcase(s, tc_div);
+
+    tc_tima = tcase_create("TIMA");
+    tcase_add_test(tc_tima, test_tima_overflow_event);
+    tcase_add_test(tc_tima, test_tima_match_reference);
+    tcase_add_test(tc_tima, test_tima_write_cancels_reload);
+    tcase_add_test(tc_tima, test_tima_glitches);
+    suite_add_tcase(s, tc_tima);
+
+    return s;
+}
+
+int main(void) {
+    int      number_failed;
+    Suite   *s;
+    SRunner *sr;
+
+    s  = timer_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_NORMAL);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (number_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,646 @@
+// tools/gbaot.c
+// Ahead-of-time translator: ROM -> C source, one function per basic block
+// Usage: gbaot <rom.gb> <output.c> (see include/core/cpu/cpu_aot.h)
+#include <core/cartridge.h>
+#include <core/cpu/cpu.h>
+#include <core/cpu/cpu_aot.h>
+#include <core/cpu/cpu_block.h>
+#include <core/cpu/cpu_opcodes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BANK_SIZE       0x4000
+#define MAX_ROUNDS      16  // Jump table discovery passes
+#define MAX_TABLE_SIZE  128 // Entries read from one inline jump table
+#define DISPATCH_BLOCKS 4   // Blocks followed when looking for a table dispatcher
+
+// Handler name per opcode, NULL = illegal / not implemented
+#define NAME_OP(code, handler) [code] = #handler,
+#define NAME_NO_OP(code)       [code] = NULL,
+
+static const char *const handler_names[256] = {OPCODE_MAP(NAME_OP, NAME_NO_OP)};
+
+// Register operand names, in opcode encoding order (6 = (HL))
+static const char *const reg_names[8] = {
+    "cpu->regs.b", "cpu->regs.c", "cpu->regs.d", "cpu->regs.e",
+    "cpu->regs.h", "cpu->regs.l", NULL,          "cpu->regs.a",
+};
+
+// Condition codes NZ, Z, NC, C as C expressions
+static const char *const cond_names[4] = {
+    "!cpu_flag_z(cpu)",
+    "cpu_flag_z(cpu)",
+    "!cpu_flag_c(cpu)",
+    "cpu_flag_c(cpu)",
+};
+
+// ---------------------------------------------
+// Analysis state
+// ---------------------------------------------
+typedef struct {
+    u32 offset; // ROM offset of the first opcode
+    u16 pc;     // Address it runs at
+    u16 length; // Bytes
+    u8  count;  // Instructions
+} Block;
+
+typedef struct {
+    u32  target; // ROM offset of the called routine
+    u32  ret;    // ROM offset of the return address
+    bool done;   // Return address queued / table read
+} CallSite;
+
+static u8       *rom;
+static u32       rom_size;
+
+static bool     *queued; // Per ROM offset: already on the worklist
+static u32      *worklist;
+static u32       worklist_len = 0;
+
+static Block    *blocks;
+static u32       block_count = 0;
+
+static CallSite *calls;
+static u32       call_count = 0;
+static u32       call_cap   = 0;
+
+// Address `offset` runs at
+static u16 rom_pc(u32 offset) {
+    return (offset < BANK_SIZE) ? offset : BANK_SIZE + offset % BANK_SIZE;
+}
+
+// ROM offset reached by jumping to `pc` from code at ROM offset `from`
+// Code in bank 0 is assumed to see bank 1 (exact for 32 KB ROMs)
+static bool rom_offset(u32 from, u16 pc, u32 *offset) {
+    if (pc >= 0x8000)
+        return false; // RAM: left to the interpreter
+    if (pc < BANK_SIZE)
+        *offset = pc;
+    else
+        *offset = ((from < BANK_SIZE) ? 1 : from / BANK_SIZE) * BANK_SIZE + (pc - BANK_SIZE);
+    return *offset < rom_size;
+}
+
+static void queue(u32 offset) {
+    if (offset < rom_size && !queued[offset]) {
+        queued[offset]           = true;
+        worklist[worklist_len++] = offset;
+    }
+}
+
+static void add_call(u32 target, u32 ret) {
+    if (call_count == call_cap) {
+        call_cap = call_cap ? call_cap * 2 : 256;
+        calls    = realloc(calls, call_cap * sizeof(CallSite));
+    }
+    calls[call_count++] = (CallSite){.target = target, .ret = ret, .done = false};
+}
+
+// ---------------------------------------------
+// Decode the block at `offset` with the rules of the runtime block cache
+// (see block_decode() in cpu_block.c), so each function covers one block
+// ---------------------------------------------
+static bool decode_block(u32 offset, Block *block) {
+    u16 pc    = rom_pc(offset);
+    u16 avail = 0x100 - (pc & 0xFF);
+    u16 pos   = 0;
+    u8  count = 0;
+
+    if (offset + avail > rom_size)
+        avail = rom_size - offset;
+
+    while (count < CPU_BLOCK_MAX_INSTRS) {
+        u8 opcode = rom[offset + pos];
+        u8 length = cpu_instr_length(opcode);
+
+        if (handler_names[opcode] == NULL || pos + length > avail)
+            break;
+
+        count++;
+        pos += length;
+        if (cpu_instr_ends_block(opcode))
+            break;
+    }
+
+    *block = (Block){.offset = offset, .pc = pc, .length = pos, .count = count};
+    return count > 0;
+}
+
+// ---------------------------------------------
+// Queue the successors of a decoded block
+// ---------------------------------------------
+static void follow_block(const Block *block) {
+    u32 pos    = block->offset;
+    u8  opcode = 0;
+
+    for (u8 i = 0; i < block->count; i++) {
+        opcode   = rom[pos];
+        u8  len  = cpu_instr_length(opcode);
+        u16 next = rom_pc(pos) + len;
+        u32 target;
+
+        switch (opcode) {
+            case 0x18: // JR
+            case 0x20:
+            case 0x28:
+            case 0x30:
+            case 0x38:
+                if (rom_offset(pos, next + (i8)rom[pos + 1], &target))
+                    queue(target);
+                break;
+            case 0xC2: // JP
+            case 0xC3:
+            case 0xCA:
+            case 0xD2:
+            case 0xDA:
+                if (rom_offset(pos, MAKE_U16(rom[pos + 2], rom[pos + 1]), &target))
+                    queue(target);
+                break;
+            case 0xC4: // CALL
+            case 0xCC:
+            case 0xCD:
+            case 0xD4:
+            case 0xDC:
+                if (rom_offset(pos, MAKE_U16(rom[pos + 2], rom[pos + 1]), &target)) {
+                    queue(target);
+                    add_call(target, pos + len);
+                }
+                break;
+            case 0xC7: // RST
+            case 0xCF:
+            case 0xD7:
+            case 0xDF:
+            case 0xE7:
+            case 0xEF:
+            case 0xF7:
+            case 0xFF:
+                add_call(opcode & 0x38, pos + len);
+                break;
+        }
+        pos += len;
+    }
+
+    // Fall through unless the block ended with an unconditional transfer
+    // (CALL/RST return addresses are queued once their target is known)
+    // or at the end of a bank
+    bool call = (opcode & 0xC7) == 0xC4 || opcode == 0xCD || (opcode & 0xC7) == 0xC7;
+    bool jump = opcode == 0x18 || opcode == 0xC3 || opcode == 0xC9 || opcode == 0xD9 ||
+                opcode == 0xE9;
+    if (!call && !jump && pos % BANK_SIZE != 0)
+        queue(pos);
+}
+
+static void drain_worklist(void) {
+    while (worklist_len > 0) {
+        u32   offset = worklist[--worklist_len];
+        Block block;
+
+        if (decode_block(offset, &block)) {
+            blocks[block_count++] = block;
+            follow_block(&block);
+        }
+    }
+}
+
+// ---------------------------------------------
+// Jump table dispatchers
+// A routine that pops its own return address (POP HL) and ends in JP (HL)
+// reads a table of pointers stored right after the CALL/RST, e.g.
+//     rst $28
+//     dw  .state0, .state1, ...
+// ---------------------------------------------
+static bool is_dispatcher(u32 offset) {
+    bool popped = false;
+
+    for (int n = 0; n < DISPATCH_BLOCKS; n++) {
+        Block block;
+        if (!decode_block(offset, &block))
+            return false;
+
+        u32 pos    = offset;
+        u8  opcode = 0;
+        for (u8 i = 0; i < block.count; i++) {
+            opcode = rom[pos];
+            if (opcode == 0xE1) // POP HL
+                popped = true;
+            pos += cpu_instr_length(opcode);
+        }
+
+        if (opcode == 0xE9) // JP (HL)
+            return popped;
+        if (cpu_instr_ends_block(opcode))
+            return false;
+        offset = pos;
+    }
+    return false;
+}
+
+// Queue the entries of the table at `offset` until one doesn't point at ROM
+// or the table runs into code it points at
+static void read_jump_table(u32 offset) {
+    u32 end = rom_size;
+
+    for (int i = 0; i < MAX_TABLE_SIZE && offset + 1 < end; i++, offset += 2) {
+        u16 pc = MAKE_U16(rom[offset + 1], rom[offset]);
+        u32 target;
+
+        if (pc < 0x0100 || !rom_offset(offset, pc, &target))
+            break;
+        if (target > offset && target < end)
+            end = target;
+        queue(target);
+    }
+}
+
+// ---------------------------------------------
+// Recursive descent from the entry point and the vectors
+// ---------------------------------------------
+static void analyze(void) {
+    static const u16 roots[] = {
+        0x0100,                                         // Entry point
+        0x0000, 0x0008, 0x0010, 0x0018, 0x0020, 0x0028, // RST
+        0x0030, 0x0038,                                 //
+        0x0040, 0x0048, 0x0050, 0x0058, 0x0060,         // VBlank, STAT, Timer, Serial, Joypad
+    };
+
+    for (size_t i = 0; i < sizeof(roots) / sizeof(roots[0]); i++)
+        queue(roots[i]);
+
+    // New call sites may only be resolved once their target was decoded
+    for (int round = 0; round < MAX_ROUNDS; round++) {
+        drain_worklist();
+
+        bool progress = false;
+        for (u32 i = 0; i < call_count; i++) {
+            if (calls[i].done)
+                continue;
+            calls[i].done = true;
+            progress      = true;
+
+            if (is_dispatcher(calls[i].target))
+                read_jump_table(calls[i].ret);
+            else if (calls[i].ret % BANK_SIZE != 0)
+                queue(calls[i].ret);
+        }
+
+        if (!progress)
+            break;
+    }
+    drain_worklist();
+}
+
+// ---------------------------------------------
+// C emission
+// ---------------------------------------------
+
+// Operand of an 8-bit op encoded in bits 0-2 / 3-5 (`r` == 6: memory at HL)
+static const char *operand(u8 r) {
+    return (r == 6) ? "mmu_read(cpu->gb, aot_hl(cpu))" : reg_names[r];
+}
+
+static void emit_alu(FILE *out, u8 op, const char *value) {
+    switch (op) {
+        case 0:
+            fprintf(out, "    cpu->regs.a = alu_add(cpu, cpu->regs.a, %s, 0);\n", value);
+            break;
+        case 1:
+            fprintf(out, "    cpu->regs.a = alu_add(cpu, cpu->regs.a, %s, cpu_flag_c(cpu));\n",
+                    value);
+            break;
+        case 2:
+            fprintf(out, "    cpu->regs.a = alu_sub(cpu, cpu->regs.a, %s, 0);\n", value);
+            break;
+        case 3:
+            fprintf(out, "    cpu->regs.a = alu_sub(cpu, cpu->regs.a, %s, cpu_flag_c(cpu));\n",
+                    value);
+            break;
+        case 4:
+            fprintf(out, "    cpu->regs.a = alu_and(cpu, cpu->regs.a, %s);\n", value);
+            break;
+        case 5:
+            fprintf(out, "    cpu->regs.a = alu_xor(cpu, cpu->regs.a, %s);\n", value);
+            break;
+        case 6:
+            fprintf(out, "    cpu->regs.a = alu_or(cpu, cpu->regs.a, %s);\n", value);
+            break;
+        default:
+            fprintf(out, "    alu_sub(cpu, cpu->regs.a, %s, 0);\n", value);
+            break;
+    }
+}
+
+// Does the translation of `opcode` call into the bus or a handler?
+// Those publish the current time first (see gb_now())
+static bool touches_bus(u8 opcode) {
+    u8 dst = (opcode >> 3) & 0x07;
+    u8 src = opcode & 0x07;
+
+    if (opcode >= 0x40 && opcode < 0x80 && opcode != 0x76)
+        return dst == 6 || src == 6;
+    if (opcode >= 0x80 && opcode < 0xC0)
+        return src == 6;
+    if ((opcode & 0xC7) == 0xC6)
+        return false;
+    if (opcode < 0x40 && (src == 4 || src == 5 || src == 6))
+        return dst == 6;
+
+    switch (opcode) {
+        case 0x00: // NOP
+        case 0x01: // LD rr, nn
+        case 0x11:
+        case 0x21:
+        case 0x31:
+        case 0x03: // INC rr / DEC rr
+        case 0x13:
+        case 0x23:
+        case 0x33:
+        case 0x0B:
+        case 0x1B:
+        case 0x2B:
+        case 0x3B:
+        case 0x18: // JR
+        case 0x20:
+        case 0x28:
+        case 0x30:
+        case 0x38:
+        case 0xC2: // JP
+        case 0xC3:
+        case 0xCA:
+        case 0xD2:
+        case 0xDA:
+            return false;
+        default:
+            return true; // Handler
+    }
+}
+
+// Emit one instruction, return true if it ends the function
+static bool emit_instr(FILE *out, u32 pos) {
+    static const char *const pairs[3] = {"bc", "de", "hl"};
+
+    u8  opcode = rom[pos];
+    u16 pc     = rom_pc(pos);
+    u16 next   = pc + cpu_instr_length(opcode);
+    u8  n      = (pos + 1 < rom_size) ? rom[pos + 1] : 0;
+    u16 nn     = (pos + 2 < rom_size) ? MAKE_U16(rom[pos + 2], n) : 0;
+    u8  dst    = (opcode >> 3) & 0x07;
+    u8  src    = opcode & 0x07;
+
+    fprintf(out, "    // 0x%04X: %s\n", pc, handler_names[opcode]);
+    if (touches_bus(opcode))
+        fprintf(out, "    cpu->run_cycles = base + cycles;\n");
+
+    // LD r, r'
+    if (opcode >= 0x40 && opcode < 0x80 && opcode != 0x76) {
+        if (dst == 6) {
+            fprintf(out, "    mmu_write(cpu->gb, aot_hl(cpu), %s);\n", reg_names[src]);
+            fprintf(out, "    cycles += 8;\n    AOT_EXIT_CHECK(0x%04X);\n", next);
+        } else {
+            fprintf(out, "    %s = %s;\n", reg_names[dst], operand(src));
+            fprintf(out, "    cycles += %d;\n", (src == 6) ? 8 : 4);
+        }
+        return false;
+    }
+
+    // ALU A, r
+    if (opcode >= 0x80 && opcode < 0xC0) {
+        emit_alu(out, dst, operand(src));
+        fprintf(out, "    cycles += %d;\n", (src == 6) ? 8 : 4);
+        return false;
+    }
+
+    // ALU A, n
+    if ((opcode & 0xC7) == 0xC6) {
+        char value[8];
+        snprintf(value, sizeof(value), "0x%02X", n);
+        emit_alu(out, dst, value);
+        fprintf(out, "    cycles += 8;\n");
+        return false;
+    }
+
+    // LD r, n / INC r / DEC r
+    if (opcode < 0x40 && (src == 4 || src == 5 || src == 6)) {
+        const char *kernel = (src == 4) ? "alu_inc" : "alu_dec";
+        if (dst == 6 && src == 6) {
+            fprintf(out, "    mmu_write(cpu->gb, aot_hl(cpu), 0x%02X);\n", n);
+            fprintf(out, "    cycles += 12;\n    AOT_EXIT_CHECK(0x%04X);\n", next);
+        } else if (dst == 6) {
+            fprintf(out, "    {\n        u16 addr = aot_hl(cpu);\n");
+            fprintf(out, "        mmu_write(cpu->gb, addr, %s(cpu, mmu_read(cpu->gb, addr)));\n",
+                    kernel);
+            fprintf(out, "    }\n    cycles += 12;\n    AOT_EXIT_CHECK(0x%04X);\n", next);
+        } else if (src == 6) {
+            fprintf(out, "    %s = 0x%02X;\n    cycles += 8;\n", reg_names[dst], n);
+        } else {
+            fprintf(out, "    %s = %s(cpu, %s);\n    cycles += 4;\n", reg_names[dst], kernel,
+                    reg_names[dst]);
+        }
+        return false;
+    }
+
+    switch (opcode) {
+        case 0x00: // NOP
+            fprintf(out, "    cycles += 4;\n");
+            return false;
+
+        case 0x01: // LD rr, nn
+        case 0x11:
+        case 0x21:
+            fprintf(out, "    aot_set_%s(cpu, 0x%04X);\n    cycles += 12;\n", pairs[opcode >> 4],
+                    nn);
+            return false;
+        case 0x31:
+            fprintf(out, "    cpu->sp = 0x%04X;\n    cycles += 12;\n", nn);
+            return false;
+
+        case 0x03: // INC rr / DEC rr
+        case 0x13:
+        case 0x23:
+        case 0x0B:
+        case 0x1B:
+        case 0x2B:
+            fprintf(out, "    aot_set_%s(cpu, aot_%s(cpu) %c 1);\n    cycles += 8;\n",
+                    pairs[opcode >> 4], pairs[opcode >> 4], (opcode & 0x08) ? '-' : '+');
+            return false;
+        case 0x33:
+        case 0x3B:
+            fprintf(out, "    cpu->sp%s;\n    cycles += 8;\n", (opcode & 0x08) ? "--" : "++");
+            return false;
+
+        case 0x18: // JR
+            fprintf(out, "    cpu->pc = 0x%04X;\n    return cycles + 12;\n", (u16)(next + (i8)n));
+            return true;
+        case 0x20:
+        case 0x28:
+        case 0x30:
+        case 0x38:
+            fprintf(out, "    if (%s) {\n        cpu->pc = 0x%04X;\n        return cycles + 12;\n",
+                    cond_names[dst & 0x03], (u16)(next + (i8)n));
+            fprintf(out, "    }\n    cpu->pc = 0x%04X;\n    return cycles + 8;\n", next);
+            return true;
+
+        case 0xC3: // JP
+            fprintf(out, "    cpu->pc = 0x%04X;\n    return cycles + 16;\n", nn);
+            return true;
+        case 0xC2:
+        case 0xCA:
+        case 0xD2:
+        case 0xDA:
+            fprintf(out, "    if (%s) {\n        cpu->pc = 0x%04X;\n        return cycles + 16;\n",
+                    cond_names[dst & 0x03], nn);
+            fprintf(out, "    }\n    cpu->pc = 0x%04X;\n    return cycles + 12;\n", next);
+            return true;
+    }
+
+    // Everything else: the interpreter handler (fetches its own immediates)
+    fprintf(out, "    cpu->pc = 0x%04X;\n    cycles += %s(cpu);\n", (u16)(pc + 1),
+            handler_names[opcode]);
+    if (cpu_instr_ends_block(opcode)) {
+        fprintf(out, "    return cycles;\n");
+        return true;
+    }
+    fprintf(out, "    AOT_EXIT_CHECK(cpu->pc);\n");
+    return false;
+}
+
+static void emit_block(FILE *out, const Block *block) {
+    u32  pos  = block->offset;
+    bool base = false;
+
+    for (u8 i = 0; i < block->count; i++, pos += cpu_instr_length(rom[pos]))
+        base |= touches_bus(rom[pos]);
+    pos = block->offset;
+
+    fprintf(out, "\n// Bank %u, 0x%04X\n", block->offset / BANK_SIZE, block->pc);
+    fprintf(out, "static u32 aot_%06X(CPU *cpu) {\n", block->offset);
+    if (base)
+        fprintf(out, "    u32 base   = cpu->run_cycles;\n");
+    fprintf(out, "    u32 cycles = 0;\n\n");
+
+    for (u8 i = 0; i < block->count; i++) {
+        if (emit_instr(out, pos)) {
+            fprintf(out, "}\n");
+            return;
+        }
+        pos += cpu_instr_length(rom[pos]);
+    }
+
+    fprintf(out, "    cpu->pc = 0x%04X;\n    return cycles;\n}\n",
+            (u16)(block->pc + block->length));
+}
+
+static int compare_blocks(const void *a, const void *b) {
+    u32 x = ((const Block *)a)->offset;
+    u32 y = ((const Block *)b)->offset;
+    return (x > y) - (x < y);
+}
+
+static void emit_source(FILE *out, const char *rom_path) {
+    fprintf(out, "// Generated by gbaot from %s - do not edit\n", rom_path);
+    fprintf(out, "#include <core/bus.h>\n");
+    fprintf(out, "#include <core/cpu/cpu_alu.h>\n");
+    fprintf(out, "#include <core/cpu/cpu_aot.h>\n");
+    fprintf(out, "#include <core/cpu/cpu_exec.h>\n");
+    fprintf(out, "#include <gbemu.h>\n\n");
+
+    // Leave the block early, like the handler dispatch loops do
+    fprintf(out, "#define AOT_EXIT_CHECK(next)                                 \\\n"
+                 "    do {                                                     \\\n"
+                 "        if (cpu->run_exit || cpu->gb->blocks.stale) {        \\\n"
+                 "            cpu->pc = (next);                                \\\n"
+                 "            return cycles;                                   \\\n"
+                 "        }                                                    \\\n"
+                 "    } while (0)\n\n");
+
+    static const char *const pairs[3][3] = {{"bc", "b", "c"}, {"de", "d", "e"}, {"hl", "h", "l"}};
+    for (int i = 0; i < 3; i++) {
+        fprintf(out, "static inline u16 aot_%s(const CPU *cpu) {\n", pairs[i][0]);
+        fprintf(out, "    return MAKE_U16(cpu->regs.%s, cpu->regs.%s);\n}\n", pairs[i][1],
+                pairs[i][2]);
+        fprintf(out, "static inline void aot_set_%s(CPU *cpu, u16 value) {\n", pairs[i][0]);
+        fprintf(out, "    cpu->regs.%s = value >> 8;\n    cpu->regs.%s = value & 0xFF;\n}\n",
+                pairs[i][1], pairs[i][2]);
+    }
+
+    qsort(blocks, block_count, sizeof(Block), compare_blocks);
+    for (u32 i = 0; i < block_count; i++)
+        emit_block(out, &blocks[i]);
+
+    fprintf(out, "\nstatic const CpuAotBlock aot_blocks[] = {\n");
+    for (u32 i = 0; i < block_count; i++)
+        fprintf(out, "    {0x%06X, aot_%06X},\n", blocks[i].offset, blocks[i].offset);
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static const CpuAotImage aot_image = {\n");
+    fprintf(out, "    .rom_size = 0x%X,\n", rom_size);
+    fprintf(out, "    .rom_hash = 0x%08X,\n", cpu_aot_rom_hash(rom, rom_size));
+    fprintf(out, "    .blocks   = aot_blocks,\n");
+    fprintf(out, "    .count    = %u,\n};\n\n", block_count);
+
+    fprintf(out, "__attribute__((constructor)) static void aot_register(void) {\n");
+    fprintf(out, "    cpu_aot_register(&aot_image);\n}\n");
+}
+
+// ---------------------------------------------
+// Main
+// ---------------------------------------------
+static bool load_rom(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+        return false;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    // Same limits as cart_load()
+    if (size < 0x0150 || size > 0x800000) {
+        fclose(file);
+        return false;
+    }
+
+    // Translate & hash the ROM as the emulator sees it: padded with 0xFF to
+    // a power-of-two number of banks, or cpu_aot_find() never matches
+    rom_size = (u32)cart_padded_rom_size((size_t)size);
+    rom      = malloc(rom_size);
+    memset(rom, 0xFF, rom_size);
+    bool ok  = fread(rom, 1, (size_t)size, file) == (size_t)size;
+    fclose(file);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <rom.gb> <output.c>\n", argv[0]);
+        return 1;
+    }
+
+    if (!load_rom(argv[1])) {
+        fprintf(stderr, "Error: Could not read ROM %s\n", argv[1]);
+        return 1;
+    }
+
+    queued   = calloc(rom_size, sizeof(bool));
+    worklist = malloc(rom_size * sizeof(u32));
+    blocks   = malloc(rom_size * sizeof(Block));
+
+    analyze();
+
+    FILE *out = fopen(argv[2], "w");
+    if (out == NULL) {
+        fprintf(stderr, "Error: Could not write %s\n", argv[2]);
+        return 1;
+    }
+    emit_source(out, argv[1]);
+    fclose(out);
+
+    printf("gbaot: %u blocks translated from %s\n", block_count, argv[1]);
+
+    free(rom);
+    free(queued);
+    free(worklist);
+    free(blocks);
+    free(calls);
+    return 0;
+}